@@ -44,6 +44,12 @@ void Actor::ProcessInput() {
   }
 }
 
+void Actor::ConsumeInput() {
+  for (const auto& comp : components_) {
+    comp->ConsumeInput();
+  }
+}
+
 void Actor::UpdateActor() {
   if (state_ == kActive) {
     Update();
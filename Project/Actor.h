@@ -49,6 +49,10 @@ class Actor {
    * \brief Update前に毎フレーム呼び出される
    */
   virtual void Input() {}
+  /**
+   * \brief 押した瞬間の入力を最初の固定ステップが読んだ後に呼び出される
+   */
+  void ConsumeInput();
 
   void UpdateActor();
   /**
@@ -23,6 +23,11 @@ class Asset : public RefCounted {
 
   static AssetType GetStaticType() { return AssetType::kNone; }
   virtual AssetType GetAssetType() const { return AssetType::kNone; }
+  /**
+   * \brief アセットが使うメモリのおおよその大きさ
+   * 0 を返す種類はファイルサイズで見積もられる
+   */
+  virtual size_t GetMemorySize() const { return 0; }
 
   bool IsValid() const {
     return ((flags_ & static_cast<uint16_t>(AssetFlag::kMissing)) |
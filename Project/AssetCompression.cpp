@@ -0,0 +1,168 @@
+﻿#include "AssetCompression.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+using namespace base_engine;
+
+namespace {
+constexpr size_t kMinMatch = 4;
+//! 末尾の 5 バイトは必ずリテラルにする (LZ4 の仕様)
+constexpr size_t kLastLiterals = 5;
+//! 最後のマッチは終端から 12 バイト以上前に始める (LZ4 の仕様)
+constexpr size_t kMatchFindLimit = 12;
+constexpr size_t kMaxOffset = 65535;
+constexpr int kHashBits = 14;
+
+uint32_t Read32(const std::byte* p) {
+  uint32_t value;
+  std::memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(const uint32_t sequence) {
+  return (sequence * 2654435761u) >> (32 - kHashBits);
+}
+
+void WriteLength(std::vector<std::byte>& out, size_t length) {
+  for (; length >= 255; length -= 255) out.push_back(std::byte{255});
+  out.push_back(static_cast<std::byte>(length));
+}
+
+void WriteSequence(std::vector<std::byte>& out, const std::byte* literal,
+                   const size_t literal_length, const size_t offset,
+                   const size_t match_length) {
+  const size_t match_code = match_length - kMinMatch;
+  const auto token = static_cast<uint8_t>(
+      ((literal_length >= 15 ? 15 : literal_length) << 4) |
+      (match_code >= 15 ? 15 : match_code));
+  out.push_back(std::byte{token});
+  if (literal_length >= 15) WriteLength(out, literal_length - 15);
+  out.insert(out.end(), literal, literal + literal_length);
+  out.push_back(static_cast<std::byte>(offset & 0xff));
+  out.push_back(static_cast<std::byte>(offset >> 8));
+  if (match_code >= 15) WriteLength(out, match_code - 15);
+}
+
+void WriteLastLiterals(std::vector<std::byte>& out, const std::byte* literal,
+                       const size_t literal_length) {
+  out.push_back(std::byte{static_cast<uint8_t>(
+      (literal_length >= 15 ? 15 : literal_length) << 4)});
+  if (literal_length >= 15) WriteLength(out, literal_length - 15);
+  out.insert(out.end(), literal, literal + literal_length);
+}
+}  // namespace
+
+std::vector<std::byte> AssetCompression::CompressLZ4(
+    const std::span<const std::byte> source) {
+  std::vector<std::byte> out;
+  if (source.empty()) return out;
+  out.reserve(GetCompressBound(source.size()));
+
+  const std::byte* const base = source.data();
+  const size_t size = source.size();
+  if (size < kMatchFindLimit + 1) {
+    WriteLastLiterals(out, base, size);
+    return out;
+  }
+
+  // 位置 + 1 を入れ、0 を未登録として扱う
+  const auto table = std::make_unique<std::array<uint32_t, 1 << kHashBits>>();
+  table->fill(0);
+
+  const size_t match_limit = size - kMatchFindLimit;
+  const size_t match_end = size - kLastLiterals;
+  size_t anchor = 0;
+  size_t pos = 0;
+  while (pos < match_limit) {
+    const uint32_t sequence = Read32(base + pos);
+    uint32_t& slot = (*table)[Hash(sequence)];
+    const size_t candidate = slot;
+    slot = static_cast<uint32_t>(pos + 1);
+
+    if (candidate == 0 || pos - (candidate - 1) > kMaxOffset ||
+        Read32(base + candidate - 1) != sequence) {
+      ++pos;
+      continue;
+    }
+
+    size_t match = candidate - 1;
+    // 一致を後ろへ伸ばす
+    size_t length = kMinMatch;
+    while (pos + length < match_end && base[match + length] == base[pos + length])
+      ++length;
+    // リテラル側へも伸ばす
+    while (pos > anchor && match > 0 && base[pos - 1] == base[match - 1]) {
+      --pos;
+      --match;
+      ++length;
+    }
+
+    WriteSequence(out, base + anchor, pos - anchor, pos - match, length);
+    pos += length;
+    anchor = pos;
+    if (pos - 2 < match_limit)
+      (*table)[Hash(Read32(base + pos - 2))] = static_cast<uint32_t>(pos - 1);
+  }
+
+  WriteLastLiterals(out, base + anchor, size - anchor);
+  return out;
+}
+
+bool AssetCompression::DecompressLZ4(const std::span<const std::byte> source,
+                                     const std::span<std::byte> destination) {
+  const std::byte* in = source.data();
+  const std::byte* const in_end = in + source.size();
+  std::byte* out = destination.data();
+  std::byte* const out_begin = out;
+  std::byte* const out_end = out + destination.size();
+
+  const auto read_length = [&in, in_end](size_t& length) {
+    uint8_t value;
+    do {
+      if (in >= in_end) return false;
+      value = static_cast<uint8_t>(*in++);
+      length += value;
+    } while (value == 255);
+    return true;
+  };
+
+  while (in < in_end) {
+    const auto token = static_cast<uint8_t>(*in++);
+
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !read_length(literal_length)) return false;
+    if (literal_length > static_cast<size_t>(in_end - in) ||
+        literal_length > static_cast<size_t>(out_end - out))
+      return false;
+    std::memcpy(out, in, literal_length);
+    in += literal_length;
+    out += literal_length;
+
+    // 最後のシーケンスはリテラルだけで終わる
+    if (in == in_end) break;
+
+    if (in_end - in < 2) return false;
+    const size_t offset = static_cast<size_t>(in[0]) |
+                          (static_cast<size_t>(in[1]) << 8);
+    in += 2;
+    if (offset == 0 || offset > static_cast<size_t>(out - out_begin))
+      return false;
+
+    size_t match_length = token & 0x0f;
+    if (match_length == 15 && !read_length(match_length)) return false;
+    match_length += kMinMatch;
+    if (match_length > static_cast<size_t>(out_end - out)) return false;
+
+    // 重なりがあり得るので前から1バイトずつ写す
+    const std::byte* match = out - offset;
+    if (offset >= match_length) {
+      std::memcpy(out, match, match_length);
+      out += match_length;
+    } else {
+      for (size_t i = 0; i < match_length; ++i) *out++ = *match++;
+    }
+  }
+  return out == out_end;
+}
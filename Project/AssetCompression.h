@@ -0,0 +1,38 @@
+﻿// @AssetCompression.h
+// @brief アセットパック用の LZ4 ブロック形式の圧縮
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 外部ライブラリを使わずに LZ4 のブロック形式を実装する。
+// 圧縮率より展開速度を優先し、ハッシュ1段の貪欲マッチだけを行う。
+
+#pragma once
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace base_engine {
+class AssetCompression {
+ public:
+  AssetCompression() = delete;
+
+  /// 入力サイズに対する圧縮後の最大サイズ
+  static size_t GetCompressBound(size_t size) {
+    return size + size / 255 + 16;
+  }
+
+  /**
+   * \brief LZ4 ブロック形式で圧縮する
+   * \return 圧縮後のデータ。空の入力なら空
+   */
+  static std::vector<std::byte> CompressLZ4(std::span<const std::byte> source);
+  /**
+   * \brief LZ4 ブロックを展開する
+   * \param destination 展開後のサイズちょうどのバッファ
+   * \return 壊れたデータやサイズ不一致なら false
+   */
+  static bool DecompressLZ4(std::span<const std::byte> source,
+                            std::span<std::byte> destination);
+};
+}  // namespace base_engine
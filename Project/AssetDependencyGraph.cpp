@@ -0,0 +1,96 @@
+﻿#include "AssetDependencyGraph.h"
+
+#include <algorithm>
+#include <unordered_set>
+using namespace base_engine;
+
+void AssetDependencyGraph::SetDependencies(
+    const AssetHandle handle, std::vector<AssetHandle> dependencies) {
+  std::erase_if(dependencies, [handle](const AssetHandle dependency) {
+    return dependency == 0 || dependency == handle;
+  });
+  std::ranges::sort(dependencies);
+  dependencies.erase(std::ranges::unique(dependencies).begin(),
+                     dependencies.end());
+  dependencies_[handle] = std::move(dependencies);
+}
+
+void AssetDependencyGraph::Remove(const AssetHandle handle) {
+  dependencies_.erase(handle);
+}
+
+std::span<const AssetHandle> AssetDependencyGraph::GetDependencies(
+    const AssetHandle handle) const {
+  if (const auto it = dependencies_.find(handle); it != dependencies_.end())
+    return it->second;
+  return {};
+}
+
+std::vector<AssetHandle> AssetDependencyGraph::CollectTransitive(
+    const std::span<const AssetHandle> roots) const {
+  std::vector<AssetHandle> result;
+  std::unordered_set<AssetHandle> visited;
+
+  // 深さ優先で辿り、依存を全て出力してから自分を出力する
+  struct Frame {
+    AssetHandle handle;
+    std::span<const AssetHandle> dependencies;
+    size_t next = 0;
+  };
+  std::vector<Frame> stack;
+  for (const AssetHandle root : roots) {
+    if (root == 0 || !visited.insert(root).second) continue;
+    stack.push_back({root, GetDependencies(root)});
+    while (!stack.empty()) {
+      auto& frame = stack.back();
+      if (frame.next == frame.dependencies.size()) {
+        result.push_back(frame.handle);
+        stack.pop_back();
+        continue;
+      }
+      const AssetHandle dependency = frame.dependencies[frame.next++];
+      if (!visited.insert(dependency).second) continue;
+      stack.push_back({dependency, GetDependencies(dependency)});
+    }
+  }
+  return result;
+}
+
+std::vector<AssetHandle> AssetDependencyGraph::FindCriticalPath(
+    const std::span<const AssetHandle> roots,
+    const std::function<int64_t(AssetHandle)>& cost) const {
+  struct PathNode {
+    int64_t total = 0;
+    AssetHandle next = 0;
+  };
+  std::unordered_map<AssetHandle, PathNode> nodes;
+
+  // 依存される側から順に、そこから先の最長経路を求める。
+  // 循環している参照はまだ求まっていないので飛ばす
+  for (const AssetHandle handle : CollectTransitive(roots)) {
+    PathNode node;
+    for (const AssetHandle dependency : GetDependencies(handle)) {
+      const auto it = nodes.find(dependency);
+      if (it == nodes.end() || it->second.total <= node.total) continue;
+      node = {it->second.total, dependency};
+    }
+    node.total += cost(handle);
+    nodes.emplace(handle, node);
+  }
+
+  AssetHandle current = 0;
+  int64_t longest = -1;
+  for (const AssetHandle root : roots) {
+    const auto it = nodes.find(root);
+    if (it == nodes.end() || it->second.total <= longest) continue;
+    longest = it->second.total;
+    current = root;
+  }
+
+  std::vector<AssetHandle> path;
+  while (current != 0) {
+    path.push_back(current);
+    current = nodes[current].next;
+  }
+  return path;
+}
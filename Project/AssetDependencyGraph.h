@@ -0,0 +1,73 @@
+﻿// @AssetDependencyGraph.h
+// @brief アセット間の参照関係
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// シーンやプレハブを保存・インポートしたときに、コンポーネントが参照している
+// テクスチャやオーディオなどのハンドルを記録しておく。読み込み時はこのグラフを
+// 辿って依存アセットをまとめて要求し、コンポーネントを辿りながら1つずつ
+// 読み込むのを避ける。
+
+#pragma once
+#include <chrono>
+#include <functional>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "Asset.h"
+
+namespace base_engine {
+/**
+ * \brief AssetManager::PrefetchAssets の結果
+ */
+struct AssetPrefetchReport {
+  //! 今回読み込んだアセットの数
+  size_t loaded_count = 0;
+  //! 既に読み込まれていたアセットの数
+  size_t resident_count = 0;
+  //! 要求してから全て読み込み終えるまでの時間
+  std::chrono::microseconds wall_time{};
+  //! 各アセットの読み込み時間の合計。1つずつ読み込んだ場合にかかる時間
+  std::chrono::microseconds total_load_time{};
+  //! 依存を辿る経路のうち読み込み時間の合計が最も長いもの。参照する側が先
+  std::vector<AssetHandle> critical_path;
+  std::chrono::microseconds critical_path_time{};
+};
+
+class AssetDependencyGraph {
+ public:
+  /**
+   * \brief handle が参照しているアセットを置き換える。0 と重複は取り除く
+   */
+  void SetDependencies(AssetHandle handle,
+                       std::vector<AssetHandle> dependencies);
+  void Remove(AssetHandle handle);
+  void Clear() { dependencies_.clear(); }
+
+  [[nodiscard]] bool Contains(const AssetHandle handle) const {
+    return dependencies_.contains(handle);
+  }
+  [[nodiscard]] std::span<const AssetHandle> GetDependencies(
+      AssetHandle handle) const;
+
+  /**
+   * \brief roots と、そこから辿れる全てのアセットを集める
+   * \return 依存される側が先に並ぶ。循環している参照は一度だけ辿る
+   */
+  [[nodiscard]] std::vector<AssetHandle> CollectTransitive(
+      std::span<const AssetHandle> roots) const;
+
+  /**
+   * \brief roots から依存を辿る経路のうち、cost の合計が最も大きいものを求める
+   * \return 参照する側から並んだ経路
+   */
+  [[nodiscard]] std::vector<AssetHandle> FindCriticalPath(
+      std::span<const AssetHandle> roots,
+      const std::function<int64_t(AssetHandle)>& cost) const;
+
+ private:
+  std::unordered_map<AssetHandle, std::vector<AssetHandle>> dependencies_;
+};
+}  // namespace base_engine
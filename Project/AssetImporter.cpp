@@ -1,17 +1,26 @@
 ﻿#include "AssetImporter.h"
 
+#include <shared_mutex>
+
 #include "AssetManager.h"
 #include "Audio.h"
 #include "Prefab.h"
 #include "SceneAssetSerializer.h"
+#include "SpriteAnimationAsset.h"
 #include "Texture.h"
 
 using namespace base_engine;
+
+// パックの追加はメインスレッド、読み込みはワーカーからも行われる
+static std::shared_mutex s_asset_pack_mutex;
+
 void AssetImporter::Init() {
   serializers_[AssetType::kTexture] = std::make_unique<TextureSerializer>();
   serializers_[AssetType::kAudio] = std::make_unique<AudioSerializer>();
   serializers_[AssetType::kScene] = std::make_unique<SceneAssetSerializer>();
   serializers_[AssetType::kPrefab] = std::make_unique<PrefabSerializer>();
+  serializers_[AssetType::kSpriteAnimation] =
+      std::make_unique<SpriteAnimationSerializer>();
 }
 
 void AssetImporter::Serialize(const AssetMetadata& metadata,
@@ -20,6 +29,13 @@ void AssetImporter::Serialize(const AssetMetadata& metadata,
     return;
   }
   serializers_[asset->GetAssetType()]->Serialize(metadata, asset);
+
+  // 保存した内容で依存グラフを更新する
+  if (std::vector<AssetHandle> dependencies;
+      TryGetDependencies(asset, dependencies)) {
+    BASE_ENGINE(AssetManager)
+        ->SetAssetDependencies(metadata.handle, std::move(dependencies));
+  }
 }
 
 void AssetImporter::Serialize(const Ref<Asset>& asset) {
@@ -33,8 +49,107 @@ bool AssetImporter::TryLoadData(const AssetMetadata& metadata,
   if (!serializers_.contains(metadata.type)) {
     return false;
   }
-  return serializers_[metadata.type]->TryLoadData(metadata, asset);
+  const auto serializer = serializers_[metadata.type].get();
+  if (bool loaded; TryLoadFromPack(serializer, metadata, asset, loaded)) {
+    return loaded;
+  }
+  return serializer->TryLoadData(metadata, asset);
+}
+
+AssetStreamStatus AssetImporter::TryLoadDataAsync(const AssetMetadata& metadata,
+                                                  Ref<Asset>& asset) {
+  // ワーカーから呼ばれるため、serializers_ は検索だけにする
+  const auto iter = serializers_.find(metadata.type);
+  if (iter == serializers_.end()) {
+    return AssetStreamStatus::kFailed;
+  }
+  const auto serializer =
+      dynamic_cast<const AsyncAssetSerializer*>(iter->second.get());
+  if (!serializer) {
+    return AssetStreamStatus::kMainThread;
+  }
+  if (bool loaded;
+      TryLoadFromPack(iter->second.get(), metadata, asset, loaded)) {
+    return loaded ? AssetStreamStatus::kLoaded : AssetStreamStatus::kFailed;
+  }
+  return serializer->TryLoadDataAsync(metadata, asset)
+             ? AssetStreamStatus::kLoaded
+             : AssetStreamStatus::kFailed;
+}
+
+bool AssetImporter::FinalizeData(const AssetMetadata& metadata,
+                                 Ref<Asset>& asset) {
+  const auto iter = serializers_.find(metadata.type);
+  if (iter == serializers_.end()) {
+    return false;
+  }
+  const auto serializer =
+      dynamic_cast<const AsyncAssetSerializer*>(iter->second.get());
+  return serializer && serializer->FinalizeData(metadata, asset);
+}
+
+const AssetPack* AssetImporter::MountPack(const std::filesystem::path& path) {
+  auto pack = std::make_unique<AssetPack>();
+  if (!pack->Open(path)) {
+    return nullptr;
+  }
+  std::unique_lock lock(s_asset_pack_mutex);
+  return packs_.emplace_back(std::move(pack)).get();
+}
+
+void AssetImporter::UnmountAllPacks() {
+  std::unique_lock lock(s_asset_pack_mutex);
+  packs_.clear();
+}
+
+bool AssetImporter::TryGetDependencies(const AssetMetadata& metadata,
+                                       std::vector<AssetHandle>& dependencies) {
+  const auto iter = serializers_.find(metadata.type);
+  if (iter == serializers_.end()) {
+    return false;
+  }
+  const auto serializer =
+      dynamic_cast<const DependencyAssetSerializer*>(iter->second.get());
+  return serializer && serializer->TryGetDependencies(metadata, dependencies);
+}
+
+bool AssetImporter::TryGetDependencies(const Ref<Asset>& asset,
+                                       std::vector<AssetHandle>& dependencies) {
+  const auto iter = serializers_.find(asset->GetAssetType());
+  if (iter == serializers_.end()) {
+    return false;
+  }
+  const auto serializer =
+      dynamic_cast<const DependencyAssetSerializer*>(iter->second.get());
+  if (!serializer) {
+    return false;
+  }
+  serializer->GetDependencies(asset, dependencies);
+  return true;
+}
+
+bool AssetImporter::TryLoadFromPack(const AssetSerializer* serializer,
+                                    const AssetMetadata& metadata,
+                                    Ref<Asset>& asset, bool& loaded) {
+  const auto memory_serializer =
+      dynamic_cast<const MemoryAssetSerializer*>(serializer);
+  if (!memory_serializer) {
+    return false;
+  }
+  std::shared_lock lock(s_asset_pack_mutex);
+  for (const auto& pack : packs_ | std::views::reverse) {
+    if (!pack->Contains(metadata.handle)) {
+      continue;
+    }
+    // 展開に失敗したエントリはファイルに戻らず失敗にする
+    const auto blob = pack->Load(metadata.handle);
+    loaded = blob && memory_serializer->TryLoadDataFromMemory(
+                         metadata, blob.GetData(), asset);
+    return true;
+  }
+  return false;
 }
 
 std::unordered_map<AssetType, std::unique_ptr<AssetSerializer>>
-    AssetImporter::serializers_;
\ No newline at end of file
+    AssetImporter::serializers_;
+std::vector<std::unique_ptr<AssetPack>> AssetImporter::packs_;
\ No newline at end of file
@@ -6,12 +6,15 @@
 // @details
 
 #pragma once
+#include <memory>
 #include <ranges>
 #include <unordered_map>
 #include <vector>
 
 #include "AssetMetadata.h"
+#include "AssetPack.h"
 #include "AssetSerializer.h"
+#include "AssetStreamer.h"
 #include "AssetTypes.h"
 
 namespace base_engine {
@@ -24,6 +27,41 @@ class AssetImporter {
   static void Serialize(const Ref<Asset>& asset);
   static bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset);
 
+  /**
+   * \brief ワーカースレッドから呼びます。AsyncAssetSerializer を持つ種類だけ読み込みます。
+   */
+  static AssetStreamStatus TryLoadDataAsync(const AssetMetadata& metadata,
+                                            Ref<Asset>& asset);
+  /**
+   * \brief TryLoadDataAsync で読み込んだアセットをメインスレッドで仕上げます。
+   */
+  static bool FinalizeData(const AssetMetadata& metadata, Ref<Asset>& asset);
+
+  /**
+   * \brief アセットパックを読み込み元に加えます。後から加えたパックが優先されます。
+   * MemoryAssetSerializer を持つ種類はパックにあればファイルより先にそちらを使います。
+   * \return 開けなかった場合は nullptr
+   */
+  static const AssetPack* MountPack(const std::filesystem::path& path);
+  static void UnmountAllPacks();
+
+  /**
+   * \brief アセットを読み込まずに、ファイルから参照しているハンドルを集めます。
+   * \return DependencyAssetSerializer を持たない種類は false
+   */
+  static bool TryGetDependencies(const AssetMetadata& metadata,
+                                 std::vector<AssetHandle>& dependencies);
+  /**
+   * \brief 読み込み済みのアセットが参照しているハンドルを集めます。
+   * \return DependencyAssetSerializer を持たない種類は false
+   */
+  static bool TryGetDependencies(const Ref<Asset>& asset,
+                                 std::vector<AssetHandle>& dependencies);
+  /// この種類のアセットを読み込むシリアライザがあるか
+  static bool IsLoadable(const AssetType type) {
+    return serializers_.contains(type);
+  }
+
   static AssetType GetAssetType(const std::filesystem::path& path) {
     for (const auto& [type, serializer] : serializers_) {
       if (std::string result = serializer->GetAssetType(path);
@@ -35,7 +73,13 @@ class AssetImporter {
   }
 
  private:
+  /// パックにあれば読み込み、結果を loaded に入れる。パックに無ければ false
+  static bool TryLoadFromPack(const AssetSerializer* serializer,
+                              const AssetMetadata& metadata, Ref<Asset>& asset,
+                              bool& loaded);
+
   static std::unordered_map<AssetType, std::unique_ptr<AssetSerializer>>
       serializers_;
+  static std::vector<std::unique_ptr<AssetPack>> packs_;
 };
 }  // namespace base_engine
@@ -0,0 +1,77 @@
+﻿// @AssetLoadRequest.h
+// @brief 非同期に読み込んでいるアセットの状態
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "Asset.h"
+
+namespace base_engine {
+enum class AssetLoadState : uint8_t {
+  kLoading,
+  kReady,
+  kFailed,
+};
+
+/**
+ * \brief 読み込みの結果。ワーカーとメインスレッドで共有する
+ */
+struct AssetLoadResult {
+  std::atomic<AssetLoadState> state = AssetLoadState::kLoading;
+  // kReady になってから読む。メインスレッドだけが書き込む
+  Ref<Asset> asset;
+  // 読み込み中に代わりに返すアセット
+  Ref<Asset> placeholder;
+  // kFailed のとき、この時刻を過ぎたら要求し直せる。メインスレッドだけが使う
+  std::chrono::steady_clock::time_point retry_time;
+};
+
+/**
+ * \brief AssetManager::GetAssetAsync が返すハンドル
+ */
+class AssetLoadRequest {
+ public:
+  AssetLoadRequest() = default;
+  explicit AssetLoadRequest(std::shared_ptr<AssetLoadResult> result)
+      : result_(std::move(result)) {}
+
+  [[nodiscard]] AssetLoadState GetState() const {
+    return result_ ? result_->state.load(std::memory_order_acquire)
+                   : AssetLoadState::kFailed;
+  }
+  [[nodiscard]] bool IsReady() const {
+    return GetState() == AssetLoadState::kReady;
+  }
+  [[nodiscard]] bool IsLoading() const {
+    return GetState() == AssetLoadState::kLoading;
+  }
+
+  /**
+   * \brief 読み込み済みならアセットを、読み込み中なら代わりのアセットを返します。
+   * 失敗したときと代わりのアセットがないときは nullptr を返します。
+   */
+  [[nodiscard]] Ref<Asset> Get() const {
+    switch (GetState()) {
+      case AssetLoadState::kReady:
+        return result_->asset;
+      case AssetLoadState::kLoading:
+        return result_->placeholder;
+      default:
+        return nullptr;
+    }
+  }
+  template <class T>
+  [[nodiscard]] Ref<T> Get() const {
+    return Get().As<T>();
+  }
+
+ private:
+  std::shared_ptr<AssetLoadResult> result_;
+};
+}  // namespace base_engine
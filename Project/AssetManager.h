@@ -24,14 +24,48 @@ class AssetManager {
     Ref<Asset> asset = BASE_ENGINE(AssetManager)->GetAsset(assetHandle);
     return asset.As<T>();
   }
+  /**
+   * \brief アセットを別スレッドで読み込みます。
+   * 描画や音声など、フレームの途中で初めて使うアセットはこちらで取得します。
+   */
+  static AssetLoadRequest GetAssetAsync(const AssetHandle asset_handle) {
+    return BASE_ENGINE(AssetManager)->GetAssetAsync(asset_handle);
+  }
   template <typename T>
   static Ref<T> GetAsset(const std::filesystem::path path) {
     Ref<Asset> asset = BASE_ENGINE(AssetManager)->GetAsset(path);
     return asset.As<T>();
   }
+  /**
+   * \brief 種類ごとのメモリの予算を設定する。0 なら上限なし
+   */
+  static void SetMemoryBudget(const AssetType type, const size_t bytes) {
+    BASE_ENGINE(AssetManager)->SetMemoryBudget(type, bytes);
+  }
+  /**
+   * \brief アセットと、それが参照しているアセットをまとめて並列に読み込む。
+   * シーンやプレハブを使い始める前に呼び、最初のフレームまでに揃えておく
+   */
+  static AssetPrefetchReport PrefetchAssets(
+      const std::span<const AssetHandle> roots, const bool wait = true) {
+    return BASE_ENGINE(AssetManager)->PrefetchAssets(roots, wait);
+  }
   static AssetMetadata& GetMutableMetadata(const AssetHandle handle) {
     return BASE_ENGINE(AssetManager)->GetMutableMetadata(handle);
   }
+  /**
+   * \brief アセットのパスを変更する。パス検索の索引も更新される
+   */
+  static void SetAssetFilePath(const AssetHandle handle,
+                               const std::filesystem::path& file_path) {
+    BASE_ENGINE(AssetManager)->SetAssetFilePath(handle, file_path);
+  }
+  /**
+   * \brief アセットパック (.bepak) を読み込み元に加える
+   */
+  static bool MountAssetPack(const std::filesystem::path& path) {
+    return BASE_ENGINE(AssetManager)->MountAssetPack(path);
+  }
   template <typename TAsset, typename... TArgs>
   static AssetHandle CreateMemoryOnlyAssetWithHandle(AssetHandle handle,
                                                      TArgs&&... args) {
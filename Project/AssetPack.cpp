@@ -0,0 +1,102 @@
+﻿#include "AssetPack.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "AssetCompression.h"
+using namespace base_engine;
+
+namespace {
+// LZ4 の展開後は格納サイズの 255 倍を超えない
+constexpr uint64_t kMaxLZ4Ratio = 255;
+}  // namespace
+
+bool AssetPack::Open(const std::filesystem::path& path) {
+  Close();
+  if (!file_.Open(path)) return false;
+
+  const auto data = file_.GetData();
+  AssetPackHeader header;
+  if (data.size() < sizeof(header)) {
+    Close();
+    return false;
+  }
+  std::memcpy(&header, data.data(), sizeof(header));
+
+  const bool valid_header =
+      std::memcmp(header.magic, AssetPackHeader::kMagic,
+                  sizeof(header.magic)) == 0 &&
+      header.version == AssetPackHeader::kVersion &&
+      header.toc_offset % alignof(AssetPackEntry) == 0 &&
+      header.toc_offset <= data.size() &&
+      uint64_t{header.entry_count} * sizeof(AssetPackEntry) <=
+          data.size() - header.toc_offset &&
+      header.string_offset <= data.size() &&
+      header.string_size <= data.size() - header.string_offset;
+  if (!valid_header) {
+    Close();
+    return false;
+  }
+
+  // 目次はマッピングをそのまま参照する
+  entries_ = {reinterpret_cast<const AssetPackEntry*>(data.data() +
+                                                      header.toc_offset),
+              header.entry_count};
+  strings_ = data.subspan(header.string_offset, header.string_size);
+
+  for (size_t i = 0; i < entries_.size(); ++i) {
+    const auto& entry = entries_[i];
+    const bool valid_entry =
+        (i == 0 || entries_[i - 1].handle < entry.handle) &&
+        entry.offset <= header.toc_offset &&
+        entry.stored_size <= header.toc_offset - entry.offset &&
+        uint64_t{entry.path_offset} + entry.path_size <= strings_.size() &&
+        IsPackableAssetType(entry.type) &&
+        (entry.compression == AssetPackCompression::kNone
+             ? entry.stored_size == entry.size
+             : entry.compression == AssetPackCompression::kLZ4 &&
+                   entry.size != 0 &&
+                   entry.size <= entry.stored_size * kMaxLZ4Ratio);
+    if (!valid_entry) {
+      Close();
+      return false;
+    }
+  }
+
+  path_ = path;
+  return true;
+}
+
+void AssetPack::Close() {
+  file_.Close();
+  path_.clear();
+  entries_ = {};
+  strings_ = {};
+}
+
+const AssetPackEntry* AssetPack::Find(const AssetHandle handle) const {
+  const auto it = std::ranges::lower_bound(entries_, uint64_t{handle}, {},
+                                           &AssetPackEntry::handle);
+  if (it == entries_.end() || it->handle != handle) return nullptr;
+  return &*it;
+}
+
+AssetPackBlob AssetPack::Load(const AssetHandle handle) const {
+  const AssetPackEntry* entry = Find(handle);
+  if (!entry) return {};
+
+  const auto stored = file_.GetData().subspan(entry->offset, entry->stored_size);
+  if (entry->compression == AssetPackCompression::kNone)
+    return AssetPackBlob{stored};
+
+  std::vector<std::byte> buffer(entry->size);
+  if (!AssetCompression::DecompressLZ4(stored, buffer)) return {};
+  return AssetPackBlob{std::move(buffer)};
+}
+
+std::filesystem::path AssetPack::GetEntryPath(const AssetPackEntry& entry) const {
+  const auto text =
+      reinterpret_cast<const char8_t*>(strings_.data() + entry.path_offset);
+  return std::filesystem::path{std::u8string_view{text, entry.path_size}}
+      .make_preferred();
+}
@@ -0,0 +1,128 @@
+﻿// @AssetPack.h
+// @brief アセットをまとめたパック (.bepak) の読み込み
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// ヘッダー・整列したデータ・AssetHandle 順の目次・パス文字列の順に並ぶ。
+// ファイルはメモリマップし、無圧縮のエントリはコピーせずに参照を返す。
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "AssetMetadata.h"
+#include "MappedFile.h"
+
+namespace base_engine {
+enum class AssetPackCompression : uint16_t {
+  kNone = 0,
+  kLZ4,
+};
+
+struct AssetPackHeader {
+  static constexpr char kMagic[4] = {'B', 'P', 'A', 'K'};
+  static constexpr uint32_t kVersion = 1;
+  //! データの先頭を揃える境界
+  static constexpr uint32_t kAlignment = 16;
+
+  char magic[4];
+  uint32_t version;
+  uint32_t entry_count;
+  uint32_t string_size;
+  uint64_t toc_offset;
+  uint64_t string_offset;
+};
+
+struct AssetPackEntry {
+  uint64_t handle;
+  uint64_t offset;
+  //! パック内のサイズ
+  uint64_t stored_size;
+  //! 展開後のサイズ
+  uint64_t size;
+  uint32_t path_offset;
+  uint32_t path_size;
+  AssetType type;
+  AssetPackCompression compression;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(AssetPackHeader) == 32);
+static_assert(sizeof(AssetPackEntry) == 48);
+
+/**
+ * \brief パックから読み込める種類かを返す
+ *
+ * MemoryAssetSerializer を持つ種類だけを入れる。
+ * シリアライザーにメモリからの読み込みを足したときはここにも加えること
+ */
+constexpr bool IsPackableAssetType(const AssetType type) {
+  return type == AssetType::kPrefab || type == AssetType::kSpriteAnimation;
+}
+
+/**
+ * \brief パックから取り出したデータ
+ *
+ * 無圧縮ならパックのマッピングを直接指し、圧縮されていれば展開したバッファを持つ。
+ * どちらの場合も元の AssetPack より長く使わないこと
+ */
+class AssetPackBlob {
+ public:
+  AssetPackBlob() = default;
+  explicit AssetPackBlob(const std::span<const std::byte> data) : data_(data) {}
+  explicit AssetPackBlob(std::vector<std::byte> buffer)
+      : buffer_(std::move(buffer)), data_(buffer_) {}
+  // data_ が buffer_ を指すことがあるのでコピーはしない
+  AssetPackBlob(const AssetPackBlob&) = delete;
+  AssetPackBlob& operator=(const AssetPackBlob&) = delete;
+  AssetPackBlob(AssetPackBlob&&) noexcept = default;
+  AssetPackBlob& operator=(AssetPackBlob&&) noexcept = default;
+
+  [[nodiscard]] std::span<const std::byte> GetData() const { return data_; }
+  [[nodiscard]] bool IsCopied() const { return !buffer_.empty(); }
+  explicit operator bool() const { return data_.data() != nullptr; }
+
+ private:
+  std::vector<std::byte> buffer_;
+  std::span<const std::byte> data_;
+};
+
+class AssetPack {
+ public:
+  /**
+   * \brief パックを開いて目次を検証する
+   * \return 形式が合わない場合は false
+   */
+  bool Open(const std::filesystem::path& path);
+  void Close();
+  [[nodiscard]] bool IsOpen() const { return file_.IsOpen(); }
+
+  [[nodiscard]] const AssetPackEntry* Find(AssetHandle handle) const;
+  [[nodiscard]] bool Contains(const AssetHandle handle) const {
+    return Find(handle) != nullptr;
+  }
+  /**
+   * \brief エントリのデータを取り出す。圧縮されていればここで展開する
+   * \return 見つからないか展開に失敗した場合は空
+   */
+  [[nodiscard]] AssetPackBlob Load(AssetHandle handle) const;
+
+  [[nodiscard]] std::span<const AssetPackEntry> GetEntries() const {
+    return entries_;
+  }
+  [[nodiscard]] std::filesystem::path GetEntryPath(
+      const AssetPackEntry& entry) const;
+  [[nodiscard]] const std::filesystem::path& GetPath() const { return path_; }
+
+ private:
+  MappedFile file_;
+  std::filesystem::path path_;
+  //! マッピング上の目次。ハンドルの昇順に並んでいる
+  std::span<const AssetPackEntry> entries_;
+  std::span<const std::byte> strings_;
+};
+}  // namespace base_engine
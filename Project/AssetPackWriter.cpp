@@ -0,0 +1,128 @@
+﻿#include "AssetPackWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "AssetCompression.h"
+#include "Log.h"
+using namespace base_engine;
+
+namespace {
+bool ReadFile(const std::filesystem::path& path, std::vector<std::byte>& data) {
+  std::ifstream stream(path, std::ios::binary | std::ios::ate);
+  if (!stream) return false;
+  const auto size = static_cast<size_t>(stream.tellg());
+  data.resize(size);
+  stream.seekg(0);
+  return size == 0 ||
+         stream.read(reinterpret_cast<char*>(data.data()),
+                     static_cast<std::streamsize>(size));
+}
+
+void Pad(std::ofstream& stream, uint64_t& offset, const uint64_t alignment) {
+  static constexpr char kZero[AssetPackHeader::kAlignment] = {};
+  const uint64_t padding = (alignment - offset % alignment) % alignment;
+  stream.write(kZero, static_cast<std::streamsize>(padding));
+  offset += padding;
+}
+}  // namespace
+
+void AssetPackWriter::AddFile(const AssetHandle handle, const AssetType type,
+                              const std::filesystem::path& file_path) {
+  files_.push_back({handle, type, file_path});
+}
+
+bool AssetPackWriter::Write(const std::filesystem::path& path) const {
+  std::vector<SourceFile> files = files_;
+  const auto to_key = [](const SourceFile& file) {
+    return static_cast<uint64_t>(file.handle);
+  };
+  std::ranges::stable_sort(files, {}, to_key);
+  // 同じハンドルは最後に登録したものを使う
+  const auto duplicates =
+      std::ranges::unique(files.rbegin(), files.rend(), {}, to_key);
+  files.erase(files.begin(), duplicates.begin().base());
+
+  std::filesystem::path temp_path = path;
+  temp_path += ".tmp";
+  std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+  if (!stream) return false;
+
+  // ヘッダーは最後に書き直す
+  AssetPackHeader header{};
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  uint64_t offset = sizeof(header);
+
+  std::vector<AssetPackEntry> entries;
+  entries.reserve(files.size());
+  std::u8string strings;
+  std::vector<std::byte> data;
+  for (const auto& file : files) {
+    // 読み込めない種類が入っていると AssetPack::Open で弾かれる
+    if (!IsPackableAssetType(file.type)) {
+      BE_CORE_WARN("[AssetPack] Skip unsupported asset type {0}",
+                   file.file_path.string());
+      continue;
+    }
+    if (!ReadFile(file.file_path, data)) {
+      BE_CORE_WARN("[AssetPack] Skip unreadable file {0}",
+                   file.file_path.string());
+      continue;
+    }
+
+    Pad(stream, offset, AssetPackHeader::kAlignment);
+
+    AssetPackEntry entry{};
+    entry.handle = file.handle;
+    entry.offset = offset;
+    entry.size = data.size();
+    entry.type = file.type;
+    entry.compression = AssetPackCompression::kNone;
+
+    std::span<const std::byte> stored = data;
+    std::vector<std::byte> compressed;
+    if (compression_ && !data.empty()) {
+      compressed = AssetCompression::CompressLZ4(data);
+      if (compressed.size() < data.size() - data.size() / 8) {
+        stored = compressed;
+        entry.compression = AssetPackCompression::kLZ4;
+      }
+    }
+    entry.stored_size = stored.size();
+    stream.write(reinterpret_cast<const char*>(stored.data()),
+                 static_cast<std::streamsize>(stored.size()));
+    offset += stored.size();
+
+    const std::u8string file_path = file.file_path.generic_u8string();
+    entry.path_offset = static_cast<uint32_t>(strings.size());
+    entry.path_size = static_cast<uint32_t>(file_path.size());
+    strings += file_path;
+    entries.push_back(entry);
+  }
+
+  Pad(stream, offset, AssetPackHeader::kAlignment);
+  std::memcpy(header.magic, AssetPackHeader::kMagic, sizeof(header.magic));
+  header.version = AssetPackHeader::kVersion;
+  header.entry_count = static_cast<uint32_t>(entries.size());
+  header.toc_offset = offset;
+  stream.write(reinterpret_cast<const char*>(entries.data()),
+               static_cast<std::streamsize>(entries.size() *
+                                            sizeof(AssetPackEntry)));
+  offset += entries.size() * sizeof(AssetPackEntry);
+
+  header.string_offset = offset;
+  header.string_size = static_cast<uint32_t>(strings.size());
+  stream.write(reinterpret_cast<const char*>(strings.data()),
+               static_cast<std::streamsize>(strings.size()));
+
+  stream.seekp(0);
+  stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  stream.close();
+  if (!stream) return false;
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  return !error;
+}
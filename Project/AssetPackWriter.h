@@ -0,0 +1,47 @@
+﻿// @AssetPackWriter.h
+// @brief アセットパック (.bepak) の書き出し
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include <filesystem>
+#include <vector>
+
+#include "AssetPack.h"
+
+namespace base_engine {
+class AssetPackWriter {
+ public:
+  /**
+   * \brief パックに入れるファイルを登録する。読み込みは Write まで遅らせる
+   *
+   * IsPackableAssetType でない種類は Write で飛ばす
+   */
+  void AddFile(AssetHandle handle, AssetType type,
+               const std::filesystem::path& file_path);
+
+  /**
+   * \brief 登録したファイルを読み込み、パックを書き出す
+   *
+   * 圧縮して 1/8 以上小さくなるエントリだけ LZ4 で格納する。
+   * 読み込めなかったファイルは飛ばす
+   * \return 書き出しに失敗した場合は false
+   */
+  bool Write(const std::filesystem::path& path) const;
+
+  void SetCompression(const bool enable) { compression_ = enable; }
+  [[nodiscard]] size_t GetFileCount() const { return files_.size(); }
+
+ private:
+  struct SourceFile {
+    AssetHandle handle;
+    AssetType type;
+    std::filesystem::path file_path;
+  };
+
+  std::vector<SourceFile> files_;
+  bool compression_ = true;
+};
+}  // namespace base_engine
@@ -0,0 +1,73 @@
+﻿#include "AssetPacker.h"
+
+#include <Windows.h>
+#include <shellapi.h>
+
+#include <string>
+#include <vector>
+
+#include "AssetPackWriter.h"
+#include "AssetRegistryCache.h"
+#include "Log.h"
+using namespace base_engine;
+
+bool AssetPacker::BuildFromRegistry(const std::filesystem::path& registry_path,
+                                    const std::filesystem::path& output_path,
+                                    const bool compression) {
+  AssetRegistryCache cache;
+  if (!cache.Load(registry_path)) {
+    BE_CORE_ERROR(
+        "[AssetPacker] {0} を読み込めません。エディタを一度起動してください。",
+        registry_path.string());
+    return false;
+  }
+
+  AssetPackWriter writer;
+  writer.SetCompression(compression);
+  size_t skipped = 0;
+  for (const auto& asset : cache.GetAssets()) {
+    // テクスチャや音声はファイルから読むので、入れても使われない
+    if (!IsPackableAssetType(asset.type)) {
+      ++skipped;
+      continue;
+    }
+    writer.AddFile(asset.handle, asset.type, asset.file_path);
+  }
+  if (skipped != 0) {
+    BE_CORE_INFO("[AssetPacker] パックから読めない種類のアセット {0} 件を除外しました",
+                 skipped);
+  }
+
+  if (!writer.Write(output_path)) {
+    BE_CORE_ERROR("[AssetPacker] {0} の書き出しに失敗しました。",
+                  output_path.string());
+    return false;
+  }
+  BE_CORE_INFO("[AssetPacker] {0} assets -> {1}", writer.GetFileCount(),
+               output_path.string());
+  return true;
+}
+
+std::optional<int> AssetPacker::RunFromCommandLine() {
+  int argc = 0;
+  LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+  if (!argv) return std::nullopt;
+  const std::vector<std::wstring> args(argv, argv + argc);
+  LocalFree(argv);
+
+  std::optional<std::filesystem::path> output_path;
+  std::filesystem::path registry_path = AssetRegistryCache::kFileName;
+  bool compression = true;
+  for (size_t i = 1; i < args.size(); ++i) {
+    if (args[i] == L"--pack" && i + 1 < args.size()) {
+      output_path = args[++i];
+    } else if (args[i] == L"--registry" && i + 1 < args.size()) {
+      registry_path = args[++i];
+    } else if (args[i] == L"--no-compress") {
+      compression = false;
+    }
+  }
+  if (!output_path) return std::nullopt;
+
+  return BuildFromRegistry(registry_path, *output_path, compression) ? 0 : 1;
+}
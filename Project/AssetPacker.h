@@ -0,0 +1,35 @@
+﻿// @AssetPacker.h
+// @brief アセットレジストリからパックを作るコマンド
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// Sample.exe --pack <出力先.bepak> [--registry <assets.becache>] [--no-compress]
+// ウィンドウを作らずにパックを書き出して終了する。
+
+#pragma once
+#include <filesystem>
+#include <optional>
+
+namespace base_engine {
+class AssetPacker {
+ public:
+  AssetPacker() = delete;
+
+  /**
+   * \brief レジストリのキャッシュに載っているアセットをパックにまとめる
+   *
+   * パックから読み込めない種類 (テクスチャ、音声など) は除外する
+   * \return キャッシュが読めないか書き出しに失敗した場合は false
+   */
+  static bool BuildFromRegistry(const std::filesystem::path& registry_path,
+                                const std::filesystem::path& output_path,
+                                bool compression);
+
+  /**
+   * \brief コマンドラインに --pack があればパックを作る
+   * \return パックを作った場合は終了コード。通常の起動なら nullopt
+   */
+  static std::optional<int> RunFromCommandLine();
+};
+}  // namespace base_engine
@@ -29,10 +29,69 @@ bool AssetRegistry::Contains(const AssetHandle handle) const {
 
 size_t AssetRegistry::Remove(const AssetHandle handle) {
   std::scoped_lock lock(s_asset_registry_mutex);
-  return asset_registry_.erase(handle);
+  const auto it = asset_registry_.find(handle);
+  if (it == asset_registry_.end()) return 0;
+  UnindexPath(it->second);
+  asset_registry_.erase(it);
+  return 1;
 }
 
 void AssetRegistry::Clear() {
   std::scoped_lock lock(s_asset_registry_mutex);
   asset_registry_.clear();
+  path_index_.clear();
+}
+
+AssetMetadata& AssetRegistry::Add(const AssetMetadata& metadata) {
+  std::scoped_lock lock(s_asset_registry_mutex);
+  auto [it, inserted] = asset_registry_.try_emplace(metadata.handle, metadata);
+  if (!inserted) {
+    UnindexPath(it->second);
+    it->second = metadata;
+  }
+  IndexPath(it->second);
+  return it->second;
+}
+
+void AssetRegistry::SetFilePath(const AssetHandle handle,
+                                const std::filesystem::path& file_path) {
+  std::scoped_lock lock(s_asset_registry_mutex);
+  const auto it = asset_registry_.find(handle);
+  if (it == asset_registry_.end()) return;
+  UnindexPath(it->second);
+  it->second.file_path = file_path;
+  IndexPath(it->second);
+}
+
+AssetHandle AssetRegistry::Find(const std::filesystem::path& file_path) const {
+  const std::string key = NormalizePath(file_path);
+  if (key.empty()) return 0;
+
+  std::scoped_lock lock(s_asset_registry_mutex);
+  const auto index = path_index_.find(key);
+  if (index == path_index_.end()) return 0;
+
+  // GetMutableMetadata 経由でパスだけ書き換えられた古い索引は信用しない
+  const auto it = asset_registry_.find(index->second);
+  if (it == asset_registry_.end() || NormalizePath(it->second.file_path) != key)
+    return 0;
+  return index->second;
+}
+
+std::string AssetRegistry::NormalizePath(
+    const std::filesystem::path& file_path) {
+  if (file_path.empty()) return {};
+  return file_path.lexically_normal().generic_string();
+}
+
+void AssetRegistry::IndexPath(const AssetMetadata& metadata) {
+  std::string key = NormalizePath(metadata.file_path);
+  if (key.empty()) return;
+  path_index_.insert_or_assign(std::move(key), metadata.handle);
+}
+
+void AssetRegistry::UnindexPath(const AssetMetadata& metadata) {
+  const auto it = path_index_.find(NormalizePath(metadata.file_path));
+  if (it != path_index_.end() && it->second == metadata.handle)
+    path_index_.erase(it);
 }
@@ -6,16 +6,53 @@
 // @details
 
 #pragma once
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 #include "AssetMetadata.h"
 
 namespace base_engine {
-// TODO std::unordered_mapの利用をやめ独自のコンテナなどにするか最適化について考える
+/**
+ * \brief ハンドルからメタデータを引くレジストリ
+ *
+ * 正規化したパスからハンドルへの索引も合わせて保持し、パス検索を O(1) にする。
+ * パスを書き換える場合は索引を同期させるため SetFilePath を通すこと
+ */
 class AssetRegistry {
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(const std::string_view str) const {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+  using PathIndex =
+      std::unordered_map<std::string, AssetHandle, StringHash, std::equal_to<>>;
+
  public:
   AssetMetadata& operator[](const AssetHandle handle);
   AssetMetadata& Get(const AssetHandle handle);
   const AssetMetadata& Get(const AssetHandle handle) const;
 
+  /**
+   * \brief メタデータを登録する。同じハンドルがあれば上書きする
+   * \return 登録されたメタデータ
+   */
+  AssetMetadata& Add(const AssetMetadata& metadata);
+  /**
+   * \brief 登録済みアセットのパスを変更し、索引を更新する
+   */
+  void SetFilePath(const AssetHandle handle,
+                   const std::filesystem::path& file_path);
+  /**
+   * \brief パスからハンドルを引く
+   * \return 見つからなければ 0
+   */
+  AssetHandle Find(const std::filesystem::path& file_path) const;
+
+  /// 索引のキーに使う表記へパスを揃える
+  static std::string NormalizePath(const std::filesystem::path& file_path);
+
   size_t Count() const { return asset_registry_.size(); }
   bool Contains(const AssetHandle handle) const;
   size_t Remove(const AssetHandle handle);
@@ -27,6 +64,11 @@ class AssetRegistry {
   auto end() const { return asset_registry_.cend(); }
 
  private:
+  void IndexPath(const AssetMetadata& metadata);
+  void UnindexPath(const AssetMetadata& metadata);
+
   std::unordered_map<AssetHandle, AssetMetadata> asset_registry_;
+  //! 正規化済みパスからハンドルへの索引
+  PathIndex path_index_;
 };
 }  // namespace base_engine
@@ -0,0 +1,235 @@
+﻿#include "AssetRegistryCache.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "MappedFile.h"
+using namespace base_engine;
+
+namespace {
+constexpr char kMagic[4] = {'B', 'E', 'R', 'C'};
+
+struct CacheHeader {
+  char magic[4];
+  uint32_t version;
+  //! AssetType の並びが変わったキャッシュを弾くために保存する
+  uint32_t type_count;
+  uint32_t asset_count;
+  uint32_t directory_count;
+  //! 全アセットの参照先ハンドルの合計数
+  uint32_t dependency_count;
+  uint32_t string_size;
+  uint32_t reserved;
+  //! 作成時の assets.be。バージョン管理側で書き換わったら使わない
+  int64_t registry_write_time;
+  uint64_t registry_file_size;
+};
+
+struct CacheAssetRecord {
+  uint64_t handle;
+  int64_t write_time;
+  uint64_t file_size;
+  uint32_t path_offset;
+  uint32_t path_size;
+  uint16_t type;
+  uint16_t flags;
+  //! 参照先ハンドルの数。アセットの順に詰めて並べる
+  uint32_t dependency_count;
+};
+
+enum CacheAssetFlags : uint16_t {
+  kHasDependencies = 1 << 0,
+};
+
+struct CacheDirectoryRecord {
+  int64_t write_time;
+  uint32_t path_offset;
+  uint32_t path_size;
+};
+
+static_assert(sizeof(CacheHeader) == 48);
+static_assert(sizeof(CacheAssetRecord) == 40);
+static_assert(sizeof(CacheDirectoryRecord) == 16);
+
+template <class T>
+T ReadRecord(const std::byte* data) {
+  T record;
+  std::memcpy(&record, data, sizeof(T));
+  return record;
+}
+
+std::filesystem::path ReadPath(const std::span<const std::byte> strings,
+                               const uint32_t offset, const uint32_t size) {
+  const auto text = reinterpret_cast<const char8_t*>(strings.data() + offset);
+  return std::filesystem::path{std::u8string_view{text, size}}.make_preferred();
+}
+
+void AppendBytes(std::vector<std::byte>& buffer, const void* data,
+                 const size_t size) {
+  const auto bytes = static_cast<const std::byte*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + size);
+}
+}  // namespace
+
+bool AssetRegistryCache::Load(const std::filesystem::path& path) {
+  const MappedFile file(path);
+  if (!file.IsOpen()) {
+    Clear();
+    return false;
+  }
+  return Parse(file.GetData());
+}
+
+bool AssetRegistryCache::Parse(const std::span<const std::byte> data) {
+  Clear();
+  if (data.size() < sizeof(CacheHeader)) return false;
+
+  const auto header = ReadRecord<CacheHeader>(data.data());
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion ||
+      header.type_count != static_cast<uint32_t>(AssetType::kCount))
+    return false;
+  registry_stamp_ = {header.registry_write_time, header.registry_file_size};
+
+  const uint64_t assets_size =
+      uint64_t{header.asset_count} * sizeof(CacheAssetRecord);
+  const uint64_t directories_size =
+      uint64_t{header.directory_count} * sizeof(CacheDirectoryRecord);
+  const uint64_t dependencies_size =
+      uint64_t{header.dependency_count} * sizeof(uint64_t);
+  if (data.size() != sizeof(CacheHeader) + assets_size + directories_size +
+                         dependencies_size + header.string_size)
+    return false;
+
+  const std::byte* records = data.data() + sizeof(CacheHeader);
+  const std::byte* dependencies = records + assets_size + directories_size;
+  uint64_t dependency_index = 0;
+  const auto strings = data.last(header.string_size);
+  const auto in_strings = [&strings](const uint32_t offset,
+                                     const uint32_t size) {
+    return uint64_t{offset} + size <= strings.size();
+  };
+
+  assets_.reserve(header.asset_count);
+  for (uint32_t i = 0; i < header.asset_count; ++i) {
+    const auto record = ReadRecord<CacheAssetRecord>(
+        records + i * sizeof(CacheAssetRecord));
+    if (!in_strings(record.path_offset, record.path_size) ||
+        record.type >= static_cast<uint32_t>(AssetType::kCount) ||
+        dependency_index + record.dependency_count > header.dependency_count) {
+      Clear();
+      return false;
+    }
+    auto& asset = assets_.emplace_back(AssetRegistryCacheEntry{
+        record.handle, static_cast<AssetType>(record.type),
+        ReadPath(strings, record.path_offset, record.path_size),
+        {record.write_time, record.file_size},
+        std::nullopt});
+    if (record.flags & kHasDependencies) {
+      auto& handles = asset.dependencies.emplace();
+      handles.reserve(record.dependency_count);
+      for (uint32_t j = 0; j < record.dependency_count; ++j) {
+        handles.emplace_back(ReadRecord<uint64_t>(
+            dependencies + (dependency_index + j) * sizeof(uint64_t)));
+      }
+    }
+    dependency_index += record.dependency_count;
+  }
+
+  records += assets_size;
+  directories_.reserve(header.directory_count);
+  for (uint32_t i = 0; i < header.directory_count; ++i) {
+    const auto record = ReadRecord<CacheDirectoryRecord>(
+        records + i * sizeof(CacheDirectoryRecord));
+    if (!in_strings(record.path_offset, record.path_size)) {
+      Clear();
+      return false;
+    }
+    directories_.push_back(
+        {ReadPath(strings, record.path_offset, record.path_size),
+         record.write_time});
+  }
+  return true;
+}
+
+bool AssetRegistryCache::Save(const std::filesystem::path& path) const {
+  std::u8string strings;
+  const auto add_string = [&strings](const std::filesystem::path& value) {
+    const std::u8string text = value.generic_u8string();
+    const auto offset = static_cast<uint32_t>(strings.size());
+    strings += text;
+    return std::pair{offset, static_cast<uint32_t>(text.size())};
+  };
+
+  std::vector<CacheAssetRecord> asset_records;
+  std::vector<uint64_t> dependencies;
+  asset_records.reserve(assets_.size());
+  for (const auto& asset : assets_) {
+    const auto [offset, size] = add_string(asset.file_path);
+    CacheAssetRecord record{asset.handle, asset.stamp.write_time,
+                            asset.stamp.file_size, offset, size,
+                            static_cast<uint16_t>(asset.type), 0, 0};
+    if (asset.dependencies) {
+      record.flags |= kHasDependencies;
+      record.dependency_count =
+          static_cast<uint32_t>(asset.dependencies->size());
+      dependencies.insert(dependencies.end(), asset.dependencies->begin(),
+                          asset.dependencies->end());
+    }
+    asset_records.push_back(record);
+  }
+
+  std::vector<CacheDirectoryRecord> directory_records;
+  directory_records.reserve(directories_.size());
+  for (const auto& directory : directories_) {
+    const auto [offset, size] = add_string(directory.path);
+    directory_records.push_back({directory.write_time, offset, size});
+  }
+
+  CacheHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.type_count = static_cast<uint32_t>(AssetType::kCount);
+  header.asset_count = static_cast<uint32_t>(asset_records.size());
+  header.directory_count = static_cast<uint32_t>(directory_records.size());
+  header.dependency_count = static_cast<uint32_t>(dependencies.size());
+  header.string_size = static_cast<uint32_t>(strings.size());
+  header.registry_write_time = registry_stamp_.write_time;
+  header.registry_file_size = registry_stamp_.file_size;
+
+  std::vector<std::byte> buffer;
+  buffer.reserve(sizeof(header) +
+                 asset_records.size() * sizeof(CacheAssetRecord) +
+                 directory_records.size() * sizeof(CacheDirectoryRecord) +
+                 dependencies.size() * sizeof(uint64_t) + strings.size());
+  AppendBytes(buffer, &header, sizeof(header));
+  AppendBytes(buffer, asset_records.data(),
+              asset_records.size() * sizeof(CacheAssetRecord));
+  AppendBytes(buffer, directory_records.data(),
+              directory_records.size() * sizeof(CacheDirectoryRecord));
+  AppendBytes(buffer, dependencies.data(),
+              dependencies.size() * sizeof(uint64_t));
+  AppendBytes(buffer, strings.data(), strings.size());
+
+  // 書き込み途中で落ちても前回のキャッシュが壊れないようにする
+  std::filesystem::path temp_path = path;
+  temp_path += ".tmp";
+  {
+    std::ofstream stream(temp_path, std::ios::binary | std::ios::trunc);
+    if (!stream) return false;
+    stream.write(reinterpret_cast<const char*>(buffer.data()),
+                 static_cast<std::streamsize>(buffer.size()));
+    if (!stream) return false;
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, path, error);
+  return !error;
+}
+
+void AssetRegistryCache::Clear() {
+  assets_.clear();
+  directories_.clear();
+  registry_stamp_ = {};
+}
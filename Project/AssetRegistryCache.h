@@ -0,0 +1,97 @@
+﻿// @AssetRegistryCache.h
+// @brief アセットレジストリのバイナリキャッシュ
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 起動時に YAML を解析し作業ツリー全体を走査する代わりに、前回の
+// レジストリとディレクトリの更新時刻、アセット間の参照を固定長レコードで
+// 保存しておく。
+// 読み込みはメモリマップしたファイルをそのまま参照する。
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "AssetMetadata.h"
+
+namespace base_engine {
+/// ファイルの変更検出に使う更新時刻とサイズ
+struct AssetFileStamp {
+  int64_t write_time = 0;
+  uint64_t file_size = 0;
+
+  bool operator==(const AssetFileStamp&) const = default;
+};
+
+struct AssetRegistryCacheEntry {
+  AssetHandle handle = 0;
+  AssetType type = AssetType::kNone;
+  std::filesystem::path file_path;
+  AssetFileStamp stamp;
+  //! 参照しているアセット。まだ調べていなければ空
+  std::optional<std::vector<AssetHandle>> dependencies;
+};
+
+struct AssetDirectoryCacheEntry {
+  std::filesystem::path path;
+  int64_t write_time = 0;
+};
+
+class AssetRegistryCache {
+ public:
+  static constexpr uint32_t kVersion = 3;
+  //! 作業ディレクトリに置くキャッシュのファイル名
+  static constexpr auto kFileName = "assets.becache";
+
+  /**
+   * \brief キャッシュファイルをメモリマップして読み込む
+   * \return ファイルが無いか壊れている場合は false
+   */
+  bool Load(const std::filesystem::path& path);
+  /**
+   * \brief メモリ上のキャッシュを解析する
+   * \return 形式が合わない場合は false で、内容は空になる
+   */
+  bool Parse(std::span<const std::byte> data);
+  /**
+   * \brief 一時ファイルに書いてから置き換える
+   */
+  bool Save(const std::filesystem::path& path) const;
+  void Clear();
+
+  void AddAsset(const AssetRegistryCacheEntry& entry) {
+    assets_.emplace_back(entry);
+  }
+  void AddDirectory(const AssetDirectoryCacheEntry& entry) {
+    directories_.emplace_back(entry);
+  }
+  [[nodiscard]] const std::vector<AssetRegistryCacheEntry>& GetAssets() const {
+    return assets_;
+  }
+  [[nodiscard]] const std::vector<AssetDirectoryCacheEntry>& GetDirectories()
+      const {
+    return directories_;
+  }
+  //! キャッシュを書いた時点の YAML レジストリの更新時刻とサイズ
+  void SetRegistryStamp(const AssetFileStamp& stamp) {
+    registry_stamp_ = stamp;
+  }
+  [[nodiscard]] const AssetFileStamp& GetRegistryStamp() const {
+    return registry_stamp_;
+  }
+
+  static int64_t ToStamp(std::filesystem::file_time_type time) {
+    return time.time_since_epoch().count();
+  }
+
+ private:
+  std::vector<AssetRegistryCacheEntry> assets_;
+  std::vector<AssetDirectoryCacheEntry> directories_;
+  AssetFileStamp registry_stamp_;
+};
+}  // namespace base_engine
@@ -0,0 +1,91 @@
+﻿#include "AssetResidency.h"
+
+#include <ranges>
+using namespace base_engine;
+
+void AssetResidency::Add(const AssetHandle handle, const AssetType type,
+                         const size_t memory_size) {
+  Remove(handle);
+  entries_.push_front({handle, type, memory_size, frame_});
+  lookup_.emplace(handle, entries_.begin());
+
+  auto& stats = types_[static_cast<size_t>(type)];
+  ++stats.count;
+  stats.memory_size += memory_size;
+  memory_size_ += memory_size;
+}
+
+void AssetResidency::Remove(const AssetHandle handle) {
+  const auto it = lookup_.find(handle);
+  if (it == lookup_.end()) return;
+
+  const auto& entry = *it->second;
+  auto& stats = types_[static_cast<size_t>(entry.type)];
+  --stats.count;
+  stats.memory_size -= entry.memory_size;
+  memory_size_ -= entry.memory_size;
+
+  entries_.erase(it->second);
+  lookup_.erase(it);
+}
+
+void AssetResidency::Touch(const AssetHandle handle) {
+  const auto it = lookup_.find(handle);
+  if (it == lookup_.end()) return;
+  it->second->last_used_frame = frame_;
+  entries_.splice(entries_.begin(), entries_, it->second);
+}
+
+void AssetResidency::SetBudget(const AssetType type, const size_t budget) {
+  types_[static_cast<size_t>(type)].budget = budget;
+}
+
+bool AssetResidency::IsOverBudget() const {
+  if (total_budget_ != 0 && memory_size_ > total_budget_) return true;
+  for (const auto& stats : types_) {
+    if (stats.IsOverBudget()) return true;
+  }
+  return false;
+}
+
+std::vector<AssetHandle> AssetResidency::SelectEvictions(
+    const std::function<bool(AssetHandle)>& can_evict) const {
+  std::vector<AssetHandle> evictions;
+  if (!IsOverBudget()) return evictions;
+
+  // 解放した後の使用量を見積もりながら古い方から選ぶ
+  size_t total = memory_size_;
+  std::array<size_t, static_cast<size_t>(AssetType::kCount)> sizes{};
+  for (size_t i = 0; i < types_.size(); ++i) sizes[i] = types_[i].memory_size;
+
+  const auto over_total = [&] {
+    return total_budget_ != 0 && total > total_budget_;
+  };
+  for (const auto& entry : entries_ | std::views::reverse) {
+    const auto index = static_cast<size_t>(entry.type);
+    const bool over_type =
+        types_[index].budget != 0 && sizes[index] > types_[index].budget;
+    if (!over_total() && !over_type) {
+      // 種類ごとの予算だけ超えている場合は、その種類が残っているかもしれない
+      bool any_over = false;
+      for (size_t i = 0; i < sizes.size(); ++i) {
+        any_over |= types_[i].budget != 0 && sizes[i] > types_[i].budget;
+      }
+      if (!any_over) break;
+      continue;
+    }
+    if (!can_evict(entry.handle)) continue;
+
+    evictions.push_back(entry.handle);
+    total -= entry.memory_size;
+    sizes[index] -= entry.memory_size;
+  }
+  return evictions;
+}
+
+void AssetResidency::Evict(const AssetHandle handle) {
+  const auto it = lookup_.find(handle);
+  if (it == lookup_.end()) return;
+  ++types_[static_cast<size_t>(it->second->type)].evicted_count;
+  Remove(handle);
+}
@@ -0,0 +1,88 @@
+﻿// @AssetResidency.h
+// @brief 読み込み済みアセットのメモリ使用量と LRU の管理
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 種類ごとの使用量と予算を集計し、予算を超えたときに古い順から
+// 解放できるアセットを選ぶ。実際の解放はアセットマネージャーが行う。
+
+#pragma once
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "Asset.h"
+
+namespace base_engine {
+struct AssetResidencyEntry {
+  AssetHandle handle = 0;
+  AssetType type = AssetType::kNone;
+  size_t memory_size = 0;
+  //! 最後に使われたフレーム
+  uint64_t last_used_frame = 0;
+};
+
+struct AssetTypeResidency {
+  size_t count = 0;
+  size_t memory_size = 0;
+  //! 0 なら種類ごとの上限は設けない
+  size_t budget = 0;
+  size_t evicted_count = 0;
+
+  [[nodiscard]] bool IsOverBudget() const {
+    return budget != 0 && memory_size > budget;
+  }
+};
+
+class AssetResidency {
+ public:
+  using TypeArray =
+      std::array<AssetTypeResidency, static_cast<size_t>(AssetType::kCount)>;
+
+  /// 読み込まれたアセットを最新として登録する。登録済みなら大きさを更新する
+  void Add(AssetHandle handle, AssetType type, size_t memory_size);
+  void Remove(AssetHandle handle);
+  /// 使われたアセットを最新にする
+  void Touch(AssetHandle handle);
+  void AdvanceFrame() { ++frame_; }
+
+  void SetBudget(AssetType type, size_t budget);
+  void SetTotalBudget(const size_t budget) { total_budget_ = budget; }
+  [[nodiscard]] bool IsOverBudget() const;
+
+  /**
+   * \brief 予算に収まるまで、古い順に can_evict が真のアセットを選ぶ
+   * \return 解放する順に並んだハンドル。予算内なら空
+   */
+  [[nodiscard]] std::vector<AssetHandle> SelectEvictions(
+      const std::function<bool(AssetHandle)>& can_evict) const;
+  /// 解放したアセットを登録から外し、種類ごとの解放数を数える
+  void Evict(AssetHandle handle);
+
+  [[nodiscard]] const TypeArray& GetTypes() const { return types_; }
+  [[nodiscard]] const AssetTypeResidency& GetType(const AssetType type) const {
+    return types_[static_cast<size_t>(type)];
+  }
+  [[nodiscard]] size_t GetMemorySize() const { return memory_size_; }
+  [[nodiscard]] size_t GetTotalBudget() const { return total_budget_; }
+  [[nodiscard]] uint64_t GetFrame() const { return frame_; }
+  /// 新しく使われた順に並んだ登録済みのアセット
+  [[nodiscard]] const std::list<AssetResidencyEntry>& GetEntries() const {
+    return entries_;
+  }
+
+ private:
+  std::list<AssetResidencyEntry> entries_;
+  std::unordered_map<AssetHandle, std::list<AssetResidencyEntry>::iterator>
+      lookup_;
+  TypeArray types_{};
+  size_t memory_size_ = 0;
+  //! 0 なら全体の上限は設けない
+  size_t total_budget_ = 0;
+  uint64_t frame_ = 0;
+};
+}  // namespace base_engine
@@ -0,0 +1,140 @@
+﻿#include "AssetResidencyPanel.h"
+
+#include <vector>
+
+#include "AssetResidency.h"
+#include "BaseEngineCore.h"
+#include "IBaseEngineAssetManager.h"
+#include "imgui.h"
+
+namespace base_engine::editor {
+namespace {
+constexpr double kMebibyte = 1024.0 * 1024.0;
+
+double ToMebibytes(const size_t bytes) {
+  return static_cast<double>(bytes) / kMebibyte;
+}
+
+/// MiB 単位で予算を編集する。0 は上限なし
+bool InputBudget(const char* label, size_t& budget) {
+  int mebibytes = static_cast<int>(budget / (1024 * 1024));
+  if (!ImGui::InputInt(label, &mebibytes, 16, 128)) return false;
+  budget = static_cast<size_t>(mebibytes < 0 ? 0 : mebibytes) * 1024 * 1024;
+  return true;
+}
+}  // namespace
+
+void AssetResidencyPanel::OnImGuiRender() {
+  const auto asset_manager = BASE_ENGINE(AssetManager);
+  const AssetResidency& residency = asset_manager->GetResidency();
+
+  ImGui::Begin("Asset Residency");
+
+  ImGui::Text("Resident %zu assets  %.2f MiB", residency.GetEntries().size(),
+              ToMebibytes(residency.GetMemorySize()));
+  if (size_t budget = residency.GetTotalBudget();
+      InputBudget("Total Budget (MiB)", budget)) {
+    asset_manager->SetTotalMemoryBudget(budget);
+  }
+  if (ImGui::Button("Evict Unreferenced")) {
+    asset_manager->EvictUnreferencedAssets();
+  }
+
+  DrawTypeTable();
+  DrawEntryTable();
+
+  ImGui::End();
+}
+
+void AssetResidencyPanel::DrawTypeTable() {
+  const auto asset_manager = BASE_ENGINE(AssetManager);
+  const AssetResidency& residency = asset_manager->GetResidency();
+
+  if (!ImGui::CollapsingHeader("Types", ImGuiTreeNodeFlags_DefaultOpen) ||
+      !ImGui::BeginTable("##AssetResidencyTypes", 5,
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    return;
+  }
+  ImGui::TableSetupColumn("Type");
+  ImGui::TableSetupColumn("Count");
+  ImGui::TableSetupColumn("MiB");
+  ImGui::TableSetupColumn("Budget (MiB)");
+  ImGui::TableSetupColumn("Evicted");
+  ImGui::TableHeadersRow();
+
+  const auto& types = residency.GetTypes();
+  for (size_t i = 1; i < types.size(); ++i) {
+    const auto type = static_cast<AssetType>(i);
+    const auto& stats = types[i];
+    ImGui::PushID(static_cast<int>(i));
+    ImGui::TableNextRow();
+    ImGui::TableNextColumn();
+    ImGui::TextUnformatted(AssetUtilities::AssetTypeToString(type).data());
+    ImGui::TableNextColumn();
+    ImGui::Text("%zu", stats.count);
+    ImGui::TableNextColumn();
+    if (stats.IsOverBudget()) {
+      ImGui::TextColored({1.0f, 0.4f, 0.4f, 1.0f}, "%.2f",
+                         ToMebibytes(stats.memory_size));
+    } else {
+      ImGui::Text("%.2f", ToMebibytes(stats.memory_size));
+    }
+    ImGui::TableNextColumn();
+    ImGui::SetNextItemWidth(-1.0f);
+    if (size_t budget = stats.budget; InputBudget("##Budget", budget)) {
+      asset_manager->SetMemoryBudget(type, budget);
+    }
+    ImGui::TableNextColumn();
+    ImGui::Text("%zu", stats.evicted_count);
+    ImGui::PopID();
+  }
+  ImGui::EndTable();
+}
+
+void AssetResidencyPanel::DrawEntryTable() {
+  const auto asset_manager = BASE_ENGINE(AssetManager);
+  const AssetResidency& residency = asset_manager->GetResidency();
+
+  if (!ImGui::CollapsingHeader("Resident Assets") ||
+      !ImGui::BeginTable("##AssetResidencyEntries", 5,
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg |
+                             ImGuiTableFlags_ScrollY,
+                         {0.0f, 300.0f})) {
+    return;
+  }
+  ImGui::TableSetupScrollFreeze(0, 1);
+  ImGui::TableSetupColumn("Path");
+  ImGui::TableSetupColumn("Type");
+  ImGui::TableSetupColumn("KiB");
+  ImGui::TableSetupColumn("In Use");
+  ImGui::TableSetupColumn("Idle Frames");
+  ImGui::TableHeadersRow();
+
+  // 新しく使われた順。行数が多くても見えている行だけ描く
+  const std::vector<AssetResidencyEntry> entries(
+      residency.GetEntries().begin(), residency.GetEntries().end());
+  ImGuiListClipper clipper;
+  clipper.Begin(static_cast<int>(entries.size()));
+  while (clipper.Step()) {
+    for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+      const auto& entry = entries[row];
+      const auto& metadata = asset_manager->GetMutableMetadata(entry.handle);
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(metadata.file_path.generic_string().c_str());
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(
+          AssetUtilities::AssetTypeToString(entry.type).data());
+      ImGui::TableNextColumn();
+      ImGui::Text("%.1f", static_cast<double>(entry.memory_size) / 1024.0);
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(
+          asset_manager->IsAssetReferenced(entry.handle) ? "yes" : "no");
+      ImGui::TableNextColumn();
+      ImGui::Text("%llu", static_cast<unsigned long long>(
+                              residency.GetFrame() - entry.last_used_frame));
+    }
+  }
+  ImGui::EndTable();
+}
+}  // namespace base_engine::editor
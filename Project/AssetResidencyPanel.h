@@ -0,0 +1,22 @@
+﻿// @AssetResidencyPanel.h
+// @brief 読み込み済みアセットとメモリ予算を表示
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 種類ごとの使用量と予算、常駐しているアセットを使われた順に表示し、
+// 予算の変更と参照されていないアセットの解放を操作する。
+
+#pragma once
+#include "EditorPanel.h"
+
+namespace base_engine::editor {
+class AssetResidencyPanel : public EditorPanel {
+ public:
+  void OnImGuiRender() override;
+
+ private:
+  void DrawTypeTable();
+  void DrawEntryTable();
+};
+}  // namespace base_engine::editor
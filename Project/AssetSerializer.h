@@ -6,7 +6,10 @@
 // @details
 
 #pragma once
+#include <cstddef>
 #include <cstdint>
+#include <span>
+#include <vector>
 
 #include "AssetMetadata.h"
 
@@ -26,4 +29,62 @@ __interface AssetSerializer {
   virtual void GetRecognizedExtensions(std::list<std::string>* extensions) const = 0;
   virtual std::string GetAssetType(const std::filesystem::path& path) const = 0;
 };
+
+/**
+ * \brief 別スレッドで読み込めるアセットのシリアライザ
+ * AssetSerializer と一緒に継承する。継承していないアセットはメインスレッドで読み込まれる
+ */
+__interface AsyncAssetSerializer {
+ public:
+  /**
+   * \brief ワーカースレッドでファイルの読み込みとデコードを行います。
+   * エンジンの他の状態には触れないでください。
+   */
+  virtual bool TryLoadDataAsync(const AssetMetadata& metadata,
+                                Ref<Asset>& asset) const = 0;
+  /**
+   * \brief メインスレッドで読み込みを仕上げます。GPU リソースの作成などを行います。
+   */
+  virtual bool FinalizeData(const AssetMetadata& metadata,
+                            Ref<Asset>& asset) const = 0;
+};
+
+/**
+ * \brief メモリ上のデータから読み込めるアセットのシリアライザ
+ * AssetSerializer と一緒に継承する。アセットパックに含まれるアセットは
+ * ファイルの代わりにこちらで読み込まれる
+ */
+__interface MemoryAssetSerializer {
+ public:
+  /**
+   * \brief data はパックのマッピングを直接指すことがあるので、
+   * 呼び出しの後まで参照を残さないでください。
+   * AsyncAssetSerializer も継承している場合はワーカースレッドから呼ばれます。
+   */
+  virtual bool TryLoadDataFromMemory(const AssetMetadata& metadata,
+                                     std::span<const std::byte> data,
+                                     Ref<Asset>& asset) const = 0;
+};
+
+/**
+ * \brief 他のアセットを参照するアセットのシリアライザ
+ * AssetSerializer と一緒に継承する。集めたハンドルは依存グラフに記録され、
+ * 読み込むときにまとめて先読みされる
+ */
+__interface DependencyAssetSerializer {
+ public:
+  /**
+   * \brief アセットを作らずにファイルから参照しているハンドルを集めます。
+   * インポート時に呼ばれます。
+   */
+  virtual bool TryGetDependencies(const AssetMetadata& metadata,
+                                  std::vector<AssetHandle>& dependencies)
+      const = 0;
+  /**
+   * \brief 読み込み済みのアセットが参照しているハンドルを集めます。
+   * 保存時と読み込み時に呼ばれます。
+   */
+  virtual void GetDependencies(const Ref<Asset>& asset,
+                               std::vector<AssetHandle>& dependencies) const = 0;
+};
 }  // namespace base_engine
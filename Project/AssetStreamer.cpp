@@ -0,0 +1,92 @@
+﻿#include "AssetStreamer.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace base_engine {
+namespace {
+// レンダリングとオーディオのスレッドを残すため、ワーカーは控えめにする
+constexpr uint32_t kMaxDefaultThreadCount = 4;
+}  // namespace
+
+AssetStreamer::AssetStreamer(Loader loader, uint32_t thread_count)
+    : loader_(std::move(loader)) {
+  if (thread_count == 0) {
+    thread_count = std::clamp(std::thread::hardware_concurrency() / 2, 1u,
+                              kMaxDefaultThreadCount);
+  }
+  threads_.reserve(thread_count);
+  for (uint32_t i = 0; i < thread_count; ++i) {
+    threads_.emplace_back(
+        [this](const std::stop_token& stop_token) { WorkerLoop(stop_token); });
+  }
+}
+
+AssetStreamer::~AssetStreamer() {
+  for (auto& thread : threads_) {
+    thread.request_stop();
+  }
+  threads_.clear();
+}
+
+void AssetStreamer::Enqueue(AssetStreamJob job) {
+  {
+    std::scoped_lock lock(mutex_);
+    jobs_.emplace_back(std::move(job));
+  }
+  job_condition_.notify_one();
+}
+
+void AssetStreamer::TakeCompleted(std::vector<AssetStreamJob>& jobs) {
+  std::scoped_lock lock(mutex_);
+  std::ranges::move(completed_, std::back_inserter(jobs));
+  completed_.clear();
+}
+
+void AssetStreamer::WaitIdle() {
+  std::unique_lock lock(mutex_);
+  idle_condition_.wait(lock,
+                       [this] { return jobs_.empty() && running_count_ == 0; });
+}
+
+bool AssetStreamer::WaitCompleted() {
+  std::unique_lock lock(mutex_);
+  idle_condition_.wait(lock, [this] {
+    return !completed_.empty() || (jobs_.empty() && running_count_ == 0);
+  });
+  return !completed_.empty();
+}
+
+size_t AssetStreamer::GetPendingCount() const {
+  std::scoped_lock lock(mutex_);
+  return jobs_.size() + running_count_;
+}
+
+void AssetStreamer::WorkerLoop(const std::stop_token& stop_token) {
+  while (true) {
+    AssetStreamJob job;
+    {
+      std::unique_lock lock(mutex_);
+      if (!job_condition_.wait(lock, stop_token,
+                               [this] { return !jobs_.empty(); })) {
+        return;
+      }
+      job = std::move(jobs_.front());
+      jobs_.pop_front();
+      ++running_count_;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    job.status = loader_(job.metadata, job.asset);
+    job.load_time = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    {
+      std::scoped_lock lock(mutex_);
+      completed_.emplace_back(std::move(job));
+      --running_count_;
+    }
+    idle_condition_.notify_all();
+  }
+}
+}  // namespace base_engine
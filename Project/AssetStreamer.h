@@ -0,0 +1,91 @@
+﻿// @AssetStreamer.h
+// @brief アセットをワーカースレッドで読み込む
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// ワーカーはファイルの読み込みとデコードだけを行い、結果を完了キューに積む。
+// アセットマネージャーへの登録や GPU リソースの作成はメインスレッドで
+// TakeCompleted した後に行う。
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AssetLoadRequest.h"
+#include "AssetMetadata.h"
+
+namespace base_engine {
+enum class AssetStreamStatus : uint8_t {
+  // ワーカーで読み込みを終えた。メインスレッドで仕上げる
+  kLoaded,
+  // 読み込みに失敗した
+  kFailed,
+  // ワーカーで読み込めない種類。メインスレッドで読み込む
+  kMainThread,
+};
+
+struct AssetStreamJob {
+  AssetMetadata metadata;
+  std::shared_ptr<AssetLoadResult> result;
+  // ワーカーが読み込んだアセット
+  Ref<Asset> asset;
+  AssetStreamStatus status = AssetStreamStatus::kMainThread;
+  // ワーカーでの読み込みにかかった時間
+  std::chrono::microseconds load_time{};
+};
+
+class AssetStreamer {
+ public:
+  /**
+   * \brief ワーカーで実行する読み込み処理
+   */
+  using Loader =
+      std::function<AssetStreamStatus(const AssetMetadata&, Ref<Asset>&)>;
+
+  /**
+   * \param loader ワーカーで実行する読み込み処理
+   * \param thread_count ワーカーの数。0 ならコア数から決める
+   */
+  explicit AssetStreamer(Loader loader, uint32_t thread_count = 0);
+  ~AssetStreamer();
+  AssetStreamer(const AssetStreamer&) = delete;
+  AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+  void Enqueue(AssetStreamJob job);
+
+  /**
+   * \brief ワーカーが終えたジョブを jobs の末尾に移します。
+   */
+  void TakeCompleted(std::vector<AssetStreamJob>& jobs);
+
+  /**
+   * \brief キューにあるジョブと実行中のジョブが全て終わるまで待ちます。
+   */
+  void WaitIdle();
+  /**
+   * \brief 終えたジョブが1つ以上できるまで待ちます。
+   * \return 終えたジョブが無く、キューと実行中のジョブも無ければ false
+   */
+  bool WaitCompleted();
+
+  [[nodiscard]] size_t GetPendingCount() const;
+
+ private:
+  void WorkerLoop(const std::stop_token& stop_token);
+
+  Loader loader_;
+  mutable std::mutex mutex_;
+  std::condition_variable_any job_condition_;
+  std::condition_variable idle_condition_;
+  std::deque<AssetStreamJob> jobs_;
+  std::vector<AssetStreamJob> completed_;
+  size_t running_count_ = 0;
+  std::vector<std::jthread> threads_;
+};
+}  // namespace base_engine
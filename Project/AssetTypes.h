@@ -24,6 +24,7 @@ enum class AssetType : uint16_t {
   kScript,
   kAudio,
   kPrefab,
+  kSpriteAnimation,
 
   kCount
 };
@@ -44,6 +45,7 @@ class AssetUtilities {
         AssetNVP{AssetType::kScript, "Script"},
         AssetNVP{AssetType::kAudio, "Audio"},
         AssetNVP{AssetType::kPrefab, "Prefab"},
+        AssetNVP{AssetType::kSpriteAnimation, "SpriteAnimation"},
     };
   }
 
@@ -75,6 +77,8 @@ class AssetUtilities {
         break;
       case AssetType::kPrefab:
         break;
+      case AssetType::kSpriteAnimation:
+        break;
       case AssetType::kNone:
       default:
         BE_CORE_ASSERT(false, "Assetが存在しません。")
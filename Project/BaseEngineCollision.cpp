@@ -28,9 +28,15 @@ BaseEngineCollision::BaseEngineCollision() {
   world_ = new physics::PhysicsWorld({0, 0});
 }
 
-void BaseEngineCollision::Collide() {
-  world_->Step(0.017f);
+void BaseEngineCollision::Collide(const float time_step) {
   size_t body_size = body_list_.size();
+  for (int i = 0; i < body_size; ++i) {
+    body_list_[i]->SweepPosition();
+  }
+  world_->Step(time_step);
+  for (int i = 0; i < body_size; ++i) {
+    body_list_[i]->ApplyTimeOfImpact();
+  }
   std::vector<SendManifold> contacts;
   contacts.reserve(100);
   int n = 0;
@@ -100,6 +106,7 @@ void BaseEngineCollision::Register(CollisionComponent* component) {
   BodyDef bd;
   if (const auto pb = component->GetPhysicsBody(); pb) {
     bd.type = static_cast<PhysicsBodyType>(pb->GetType());
+    bd.bullet = pb->IsBullet();
   }
   auto p = component->GetActor()->GetPosition();
   bd.position = PVec2{p.x, p.y};
@@ -108,6 +115,7 @@ void BaseEngineCollision::Register(CollisionComponent* component) {
   PhysicsFixtureDef fixture_def;
   fixture_def.filter.maskTargetBits = component->GetTargetFilter().to_ulong();
   fixture_def.filter.maskObjectBits = component->GetObjectFilter().to_ulong();
+  fixture_def.isSensor = component->GetTrigger();
   const auto collision_shape = component->GetShape();
   if (collision_shape != nullptr) {
     switch (collision_shape->GetType()) {
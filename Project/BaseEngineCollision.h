@@ -12,7 +12,7 @@ namespace base_engine {
  public:
   ~BaseEngineCollision() override;
   BaseEngineCollision();
-  void Collide() override;
+  void Collide(float time_step) override;
   void Register(CollisionComponent* component) override;
   void Remove(CollisionComponent* component) override;
 
@@ -6,36 +6,88 @@
 // @details
 
 #pragma once
+#include <bit>
+#include <cstring>
+#include <vector>
+
 #include "FrozenHelper.h"
 #include "frozen.h"
 
 namespace frozen {
+// 値はメモリ上の表現のまま書き込むので、リトルエンディアンの環境でのみ互換がある
+static_assert(std::endian::native == std::endian::little,
+              "frozen binary archives are little-endian only");
+static_assert(sizeof(float) == 4 && sizeof(double) == 8,
+              "frozen binary archives require IEEE-754 float and double");
+
+/**
+ * \brief 書き込みを内部のバッファに貯めて、まとめてストリームに渡す。
+ * 書き込んだ内容はアーカイブの破棄か Flush でストリームに反映される。
+ */
 class BinaryOutputArchive : public frozen::OutputArchive<BinaryOutputArchive> {
  public:
+  static constexpr std::streamsize kBufferSize = 64 * 1024;
+
   explicit BinaryOutputArchive(std::ostream& stream)
       : OutputArchive<BinaryOutputArchive>(this), its_writer_(stream) {}
+  ~BinaryOutputArchive() { Flush(); }
 
   inline void SaveBinary(const void* data, std::streamsize size) {
-    std::streamsize writtenSize = 0;
+    if (static_cast<std::streamsize>(buffer_.size()) + size > kBufferSize) {
+      Flush();
+      // バッファより大きいものはコピーせずにそのまま渡す
+      if (size >= kBufferSize) {
+        Write(std::bit_cast<const char*>(data), size);
+        return;
+      }
+    }
+    if (buffer_.capacity() == 0) buffer_.reserve(kBufferSize);
+    const auto bytes = std::bit_cast<const char*>(data);
+    buffer_.insert(buffer_.end(), bytes, bytes + size);
+  }
 
-    writtenSize =
-        its_writer_.rdbuf()->sputn(std::bit_cast<const char*>(data), size);
+  void Flush() {
+    if (buffer_.empty()) return;
+    Write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+    buffer_.clear();
   }
 
  private:
+  void Write(const char* data, const std::streamsize size) {
+    if (its_writer_.rdbuf()->sputn(data, size) != size)
+      its_writer_.setstate(std::ios::badbit);
+  }
+
   std::ostream& its_writer_;
+  std::vector<char> buffer_;
 };
+
+/**
+ * \brief 足りない分は 0 で埋めて読み込み、失敗として記録する。
+ */
 class BinaryInputArchive : public frozen::InputArchive<BinaryInputArchive> {
  public:
   explicit BinaryInputArchive(std::istream& stream)
       : InputArchive<BinaryInputArchive>(this), its_writer_(stream) {}
 
   inline void LoadBinary(void* const data, std::streamsize size) {
-    its_writer_.read(static_cast<char*>(data), size);
+    const std::streamsize read =
+        failed_ ? 0
+                : its_writer_.rdbuf()->sgetn(static_cast<char*>(data), size);
+    if (read == size) return;
+
+    std::memset(static_cast<char*>(data) + read, 0,
+                static_cast<size_t>(size - read));
+    failed_ = true;
+    its_writer_.setstate(std::ios::eofbit | std::ios::failbit);
   }
 
+  /// 途中でデータが足りなくなった場合は true
+  [[nodiscard]] bool IsFailed() const { return failed_; }
+
  private:
   std::istream& its_writer_;
+  bool failed_ = false;
 };
 template <class T>
 requires std::is_fundamental_v<T>
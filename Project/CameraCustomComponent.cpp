@@ -1,5 +1,7 @@
 #include "CameraCustomComponent.h"
 
+#include "GameClock.h"
+
 CameraCustomComponent::CameraCustomComponent(base_engine::Actor* owner):Component(owner) {
 	offset_ = base_engine::Vector2{ 0, -64 - 32 };
 }
@@ -25,7 +27,7 @@ void CameraCustomComponent::MoveCamera() {
 
 	target_pos_ =
 		current_pos + (base_engine::VectorUtilities::Normalize(targetDirection) *
-			interp_velocity * 0.017f);
+			interp_velocity * base_engine::GameClock::GetInstance()->GetFixedDeltaTime());
 
 	auto move_pos = base_engine::Vector2{
 		std::lerp(current_pos.x, target_pos_.x, 0.6f),
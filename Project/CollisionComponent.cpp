@@ -65,6 +65,14 @@ void CollisionComponent::SetObjectFilter(
   }
 }
 
+void CollisionComponent::SetTrigger(const bool trigger) {
+  is_trigger_ = trigger;
+  if (physics_body_) {
+    if (!physics_body_->GetFixtureList()) return;
+    physics_body_->GetFixtureList()->SetSensor(trigger);
+  }
+}
+
 const std::bitset<kCollisionFilterSize>& CollisionComponent::GetObjectFilter()
     const {
   return object_layer_;
@@ -99,6 +107,19 @@ void CollisionComponent::SyncPosition() {
   physics_body_->SetTransform({p.x, p.y}, 0);
 }
 
+void CollisionComponent::SweepPosition() {
+  const auto p = GetPosition();
+
+  physics_body_->SweepTransform({p.x, p.y}, 0);
+}
+
+void CollisionComponent::ApplyTimeOfImpact() {
+  if (!physics_body_->HasTimeOfImpact()) return;
+
+  const auto& p = physics_body_->GetPosition();
+  owner_->SetPosition({p.x, p.y});
+}
+
 void CollisionComponent::SetEnabled(const bool enable) const
 { physics_body_->SetEnabled(enable);
 }
@@ -34,7 +34,7 @@ class CollisionComponent : public Component {
   void SetObjectFilter(const std::bitset<kCollisionFilterSize>& layer);
   [[nodiscard]] const std::bitset<kCollisionFilterSize>& GetObjectFilter()
       const;
-  void SetTrigger(const bool trigger) { is_trigger_ = trigger; }
+  void SetTrigger(bool trigger);
   bool GetTrigger() const { return is_trigger_; }
   bool IsMatch(CollisionComponent* target) const;
   void CollisionSender(const SendManifold& manifold);
@@ -50,6 +50,17 @@ class CollisionComponent : public Component {
   }
   physics::PhysicsBody* GetEnginePhysicsBody() const { return physics_body_; }
   void SyncPosition();
+
+  /**
+   * \brief アクターの現在位置までの移動を物理ボディに記録します。
+   * 前回の同期位置からの移動経路が連続衝突判定に使われます。
+   */
+  void SweepPosition();
+
+  /**
+   * \brief 物理ボディの移動が TOI で巻き戻された場合、その位置をアクターに反映します。
+   */
+  void ApplyTimeOfImpact();
   void SetEnabled(bool enable) const;
 private:
   std::shared_ptr<class IShape> shape_{};
@@ -13,6 +13,9 @@ class Component {
   virtual void Start() {}
   // このコンポーネントの入力処理
   virtual void ProcessInput() {}
+  // 押した瞬間の入力を読み終えたときの処理
+  // (固定ステップを1回実行した後に呼ばれる)
+  virtual void ConsumeInput() {}
   // このコンポーネントの更新処理
   virtual void Update() {}
   virtual void OnCollision(const class SendManifold& manifold) {}
@@ -0,0 +1,197 @@
+﻿// @ComponentRegistry.h
+// @brief コンポーネントの型一覧とフィールド記述子
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// シーンのコピー・プレハブの複製・シリアライズは、ここに並べた型一覧から
+// 生成する。新しいコンポーネントは一覧に追加し、保存するものは
+// ComponentReflection を特殊化してフィールドを並べる。
+
+#pragma once
+#include <tuple>
+#include <type_traits>
+
+#include "BodyMask.h"
+#include "BoundingBox.h"
+#include "DataComponents.h"
+#include "RigidBodyComponent.h"
+#include "ShapeComponents.h"
+#include "VelocityComponent.h"
+
+namespace base_engine {
+template <class... Components>
+struct ComponentList {
+  static constexpr size_t kSize = sizeof...(Components);
+
+  template <class Component>
+  static constexpr bool kContains =
+      (std::is_same_v<Component, Components> || ...);
+
+  /// f.operator()<Component>() を並べた順に呼ぶ
+  template <class F>
+  static void ForEach(F&& f) {
+    (f.template operator()<Components>(), ...);
+  }
+};
+
+template <class... Lists>
+struct ComponentListConcat;
+template <class... A, class... B>
+struct ComponentListConcat<ComponentList<A...>, ComponentList<B...>> {
+  using Type = ComponentList<A..., B...>;
+};
+
+/// メンバーへのポインターと保存時のキー
+template <class Component, class T>
+struct ComponentField {
+  using ValueType = T;
+
+  const char* name;
+  T Component::*member;
+
+  constexpr T& Get(Component& component) const { return component.*member; }
+  constexpr const T& Get(const Component& component) const {
+    return component.*member;
+  }
+};
+
+template <class Component, class T>
+constexpr ComponentField<Component, T> MakeComponentField(
+    const char* name, T Component::*member) {
+  return {name, member};
+}
+
+/**
+ * \brief 保存するコンポーネントの名前とフィールド。
+ * kName は YAML のキー、kFields は ComponentField の tuple。
+ */
+template <class Component>
+struct ComponentReflection;
+
+template <class Component>
+concept ReflectedComponent = requires {
+  ComponentReflection<Component>::kName;
+  ComponentReflection<Component>::kFields;
+};
+
+template <ReflectedComponent Component, class F>
+constexpr void ForEachComponentField(F&& f) {
+  std::apply([&f](const auto&... field) { (f(field), ...); },
+             ComponentReflection<Component>::kFields);
+}
+
+template <>
+struct ComponentReflection<component::SpriteRendererComponent> {
+  using Type = component::SpriteRendererComponent;
+  static constexpr auto kName = "SpriteRendererComponent";
+  static constexpr auto kFields = std::make_tuple(
+      MakeComponentField("Sprite", &Type::texture),
+      MakeComponentField("Color", &Type::color),
+      MakeComponentField("Pivot", &Type::pivot),
+      MakeComponentField("Layer", &Type::layer),
+      MakeComponentField("Static", &Type::is_static));
+};
+
+template <>
+struct ComponentReflection<component::SpriteAnimatorComponent> {
+  using Type = component::SpriteAnimatorComponent;
+  static constexpr auto kName = "SpriteAnimatorComponent";
+  static constexpr auto kFields = std::make_tuple(
+      MakeComponentField("Animation", &Type::animation),
+      MakeComponentField("Clip", &Type::clip),
+      MakeComponentField("Speed", &Type::speed),
+      MakeComponentField("Playing", &Type::is_playing));
+};
+
+template <>
+struct ComponentReflection<component::ParticleEmitterComponent> {
+  using Type = component::ParticleEmitterComponent;
+  static constexpr auto kName = "ParticleEmitterComponent";
+  static constexpr auto kFields = std::make_tuple(
+      MakeComponentField("Texture", &Type::texture),
+      MakeComponentField("MaxParticles", &Type::max_particles),
+      MakeComponentField("EmissionRate", &Type::emission_rate),
+      MakeComponentField("LifetimeMin", &Type::lifetime_min),
+      MakeComponentField("LifetimeMax", &Type::lifetime_max),
+      MakeComponentField("SpeedMin", &Type::speed_min),
+      MakeComponentField("SpeedMax", &Type::speed_max),
+      MakeComponentField("Direction", &Type::direction),
+      MakeComponentField("Spread", &Type::spread),
+      MakeComponentField("Gravity", &Type::gravity),
+      MakeComponentField("Color", &Type::color),
+      MakeComponentField("Size", &Type::size),
+      MakeComponentField("Emitting", &Type::is_emitting));
+};
+
+template <>
+struct ComponentReflection<component::AudioComponent> {
+  using Type = component::AudioComponent;
+  static constexpr auto kName = "AudioComponent";
+  static constexpr auto kFields =
+      std::make_tuple(MakeComponentField("Source", &Type::audio_source));
+};
+
+template <>
+struct ComponentReflection<physics::RigidBodyComponent> {
+  using Type = physics::RigidBodyComponent;
+  static constexpr auto kName = "RigidBodyComponent";
+  static constexpr auto kFields =
+      std::make_tuple(MakeComponentField("Restitution", &Type::restitution),
+                      MakeComponentField("Mass", &Type::mass));
+};
+
+template <>
+struct ComponentReflection<physics::BodyMask> {
+  using Type = physics::BodyMask;
+  static constexpr auto kName = "BodyMaskComponent";
+  static constexpr auto kFields = std::make_tuple(
+      MakeComponentField("ShapeType", &Type::shape_type_id),
+      MakeComponentField("BodyType", &Type::tag_type_id),
+      MakeComponentField("BodyMask", &Type::body_mask),
+      MakeComponentField("TargetMask", &Type::target_mask));
+};
+
+template <>
+struct ComponentReflection<physics::Circle> {
+  using Type = physics::Circle;
+  static constexpr auto kName = "CircleComponent";
+  static constexpr auto kFields =
+      std::make_tuple(MakeComponentField("Radius", &Type::radius));
+};
+
+/// 読み込み時にそのまま追加するコンポーネント
+using ReflectedDataComponents =
+    ComponentList<component::SpriteRendererComponent,
+                  component::SpriteAnimatorComponent,
+                  component::ParticleEmitterComponent,
+                  component::AudioComponent>;
+
+/// 読み込み時は値だけ読み、PhysicsObjectFactory で作り直すコンポーネント
+using ReflectedPhysicsComponents =
+    ComponentList<physics::RigidBodyComponent, physics::BodyMask,
+                  physics::Circle>;
+
+/// フィールドごとに保存するコンポーネント (保存順)
+using ReflectedComponents =
+    ComponentListConcat<ReflectedDataComponents,
+                        ReflectedPhysicsComponents>::Type;
+
+/// シーンのコピーとプレハブの複製で値ごとコピーするコンポーネント
+using CopyableComponents =
+    ComponentList<component::TagComponent, component::PrefabComponent,
+                  component::HierarchyComponent,
+                  component::TransformComponent, component::ScriptComponent,
+                  component::SpriteRendererComponent,
+                  component::SpriteAnimatorComponent,
+                  component::ParticleEmitterComponent,
+                  component::AudioComponent, physics::RigidBodyComponent,
+                  physics::VelocityComponent, physics::BodyMask,
+                  physics::Circle, physics::BoundingBox>;
+
+// 保存するものはコピーもされなければならない
+static_assert([]<class... Components>(ComponentList<Components...>) {
+  return (CopyableComponents::kContains<Components> && ...);
+}(ReflectedComponents{}),
+              "reflected component missing from CopyableComponents");
+}  // namespace base_engine
@@ -11,6 +11,9 @@
 #include "HierarchyComponent.h"
 #include "TransformComponent.h"
 #include "SpriteRendererComponent.h"
+#include "SpriteAnimatorComponent.h"
+#include "ParticleEmitterComponent.h"
 #include "ScriptComponent.h"
 #include "AudioComponent.h"
-#include "PrefabComponent.h"
\ No newline at end of file
+#include "PrefabComponent.h"
+#include "TransformInterpolationComponent.h"
\ No newline at end of file
@@ -1,26 +1,74 @@
 ﻿#include "EditorAssetManager.h"
 
+#include <algorithm>
 #include <cstring>
 #include <fstream>
 #include <ranges>
 #include <string>
 
 #include <yaml-cpp/yaml.h>
+
+#include "AssetRegistryCache.h"
+#include "Profiler.h"
 using namespace base_engine;
 static AssetMetadata kNullMetadata;
 
+namespace {
+constexpr auto kAssetRegistryPath = "assets.be";
+
+AssetFileStamp StampAssetRegistry() {
+  std::error_code error;
+  const auto write_time =
+      std::filesystem::last_write_time(kAssetRegistryPath, error);
+  if (error) return {};
+  const auto file_size = std::filesystem::file_size(kAssetRegistryPath, error);
+  if (error) return {};
+  return {AssetRegistryCache::ToStamp(write_time), file_size};
+}
+}  // namespace
+
 EditorAssetManager::EditorAssetManager() {
+  residency_.SetTotalBudget(kDefaultMemoryBudget);
 }
 
 void EditorAssetManager::Initialize()
 {
   AssetImporter::Init();
-  LoadAssetRegistry();
-  ReloadAssetFiles();
-  WriteRegistryToFile();
+  streamer_ = std::make_unique<AssetStreamer>(&AssetImporter::TryLoadDataAsync);
+
+  const auto start = std::chrono::steady_clock::now();
+  // キャッシュが無い初回と assets.be が更新された時だけ YAML を読み、
+  // 作業ツリーを全て走査する
+  const bool warm = LoadRegistryCache();
+  if (!warm) LoadAssetRegistry();
+  if (const bool changed = ReloadAssetFiles(); !warm || changed)
+    WriteRegistryToFile();
+
+  // 作業ディレクトリ直下のパックを名前順に読み込む
+  std::vector<std::filesystem::path> packs;
+  std::error_code error;
+  for (const auto& entry : std::filesystem::directory_iterator(".", error)) {
+    if (entry.path().extension() == ".bepak")
+      packs.push_back(entry.path().filename());
+  }
+  std::ranges::sort(packs);
+  for (const auto& pack : packs) MountAssetPack(pack);
+
+  const std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  BE_CORE_INFO(
+      "[AssetManager] Asset registry ready in {0:.2f} ms ({1} assets, {2})",
+      elapsed.count(), asset_registry_.Count(), warm ? "warm" : "cold");
 }
 
-EditorAssetManager::~EditorAssetManager() { WriteRegistryToFile(); }
+EditorAssetManager::~EditorAssetManager() {
+  // 読み込み中のジョブは破棄する
+  streamer_.reset();
+  AssetImporter::UnmountAllPacks();
+  // 書き出した assets.be の更新時刻をキャッシュへ記録する
+  ExportRegistryToYAML();
+  WriteRegistryToFile();
+}
 
 AssetType EditorAssetManager::GetAssetType(const AssetHandle asset_handle)
 {
@@ -34,7 +82,7 @@ void EditorAssetManager::AddMemoryOnlyAsset(Ref<Asset> asset)
 	metadata.is_data_loaded = true;
 	metadata.type = asset->GetAssetType();
 	metadata.is_memory_asset = true;
-	asset_registry_[metadata.handle] = metadata;
+	asset_registry_.Add(metadata);
 
 	memory_assets_[asset->handle_] = asset;
 }
@@ -48,21 +96,25 @@ bool EditorAssetManager::IsAssetHandleValid(const AssetHandle asset_handle)
 }
 
 bool EditorAssetManager::IsAssetLoaded(AssetHandle handle)
-{ return false; }
+{ return loaded_assets_.contains(handle); }
 
 std::unordered_set<AssetHandle> EditorAssetManager::GetAllAssetsWithType(AssetType type)
 {
-	return {};
+  std::unordered_set<AssetHandle> result;
+  for (const auto& metadata : asset_registry_ | std::views::values) {
+    if (metadata.type == type) result.insert(metadata.handle);
+  }
+  return result;
 }
 
 const std::unordered_map<AssetHandle, Ref<Asset>>& EditorAssetManager::GetLoadedAssets()
 {
-	return {};
+	return loaded_assets_;
 }
 
 const std::unordered_map<AssetHandle, Ref<Asset>>& EditorAssetManager::GetMemoryOnlyAssets()
 {
-	return {};
+	return memory_assets_;
 }
 
 Ref<Asset> EditorAssetManager::GetAsset(const std::filesystem::path file_path)
@@ -80,17 +132,334 @@ Ref<Asset> EditorAssetManager::GetAsset(const AssetHandle asset_handle) {
   if (!metadata.IsValid()) return nullptr;
   Ref<Asset> asset = nullptr;
   if (!metadata.is_data_loaded) {
+    const auto start = std::chrono::steady_clock::now();
     metadata.is_data_loaded = AssetImporter::TryLoadData(metadata, asset);
     if (!metadata.is_data_loaded) return nullptr;
 
-    loaded_assets_[asset_handle] = asset;
+    load_times_[asset_handle] =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start);
+    AddLoadedAsset(metadata, asset);
+    // 非同期の読み込み中なら、ワーカーの結果を待たずにここで完了させる
+    if (const auto iter = load_results_.find(asset_handle);
+        iter != load_results_.end()) {
+      iter->second->asset = asset;
+      iter->second->state.store(AssetLoadState::kReady,
+                                std::memory_order_release);
+    }
   } else {
     asset = loaded_assets_[asset_handle];
+    residency_.Touch(asset_handle);
   }
 
   return asset;
 }
 
+AssetLoadRequest EditorAssetManager::GetAssetAsync(
+    const AssetHandle asset_handle) {
+  if (const auto iter = load_results_.find(asset_handle);
+      iter != load_results_.end()) {
+    // 失敗した読み込みは、ファイルが直されたときのために間隔を空けてやり直す
+    if (iter->second->state.load(std::memory_order_acquire) !=
+            AssetLoadState::kFailed ||
+        std::chrono::steady_clock::now() < iter->second->retry_time) {
+      residency_.Touch(asset_handle);
+      return AssetLoadRequest{iter->second};
+    }
+    load_results_.erase(iter);
+  }
+
+  auto result = std::make_shared<AssetLoadResult>();
+  if (IsMemoryAsset(asset_handle)) {
+    result->asset = memory_assets_[asset_handle];
+    result->state = AssetLoadState::kReady;
+    return AssetLoadRequest{result};
+  }
+  const auto& metadata = GetMetadataInternal(asset_handle);
+  if (!metadata.IsValid()) {
+    result->state = AssetLoadState::kFailed;
+    return AssetLoadRequest{result};
+  }
+
+  load_results_.emplace(asset_handle, result);
+  if (metadata.is_data_loaded) {
+    residency_.Touch(asset_handle);
+    result->asset = loaded_assets_[asset_handle];
+    result->state = AssetLoadState::kReady;
+    return AssetLoadRequest{result};
+  }
+
+  if (const auto iter = placeholder_assets_.find(metadata.type);
+      iter != placeholder_assets_.end()) {
+    result->placeholder = iter->second;
+  }
+  streamer_->Enqueue({metadata, result});
+  return AssetLoadRequest{result};
+}
+
+void EditorAssetManager::SetPlaceholderAsset(const AssetType type,
+                                             Ref<Asset> asset) {
+  placeholder_assets_[type] = std::move(asset);
+}
+
+void EditorAssetManager::UpdateStreaming() {
+  BE_PROFILE_FUNC("AssetStreaming");
+  streamer_->TakeCompleted(completed_jobs_);
+  if (completed_jobs_.empty()) return;
+
+  // 仕上げがメインスレッドで重くならないよう、1フレームの時間を決めて残りは次に回す
+  const auto start = std::chrono::steady_clock::now();
+  size_t finished = 0;
+  while (finished < completed_jobs_.size()) {
+    FinalizeStreamJob(completed_jobs_[finished++]);
+    if (std::chrono::steady_clock::now() - start >= kStreamingFrameBudget) {
+      break;
+    }
+  }
+  completed_jobs_.erase(completed_jobs_.begin(),
+                        completed_jobs_.begin() + finished);
+}
+
+void EditorAssetManager::FinalizeStreamJob(AssetStreamJob& job) {
+  auto& metadata = GetMetadataInternal(job.metadata.handle);
+  // 待っている間に GetAsset で読み込まれていれば、結果は設定済み
+  if (metadata.IsValid() && metadata.is_data_loaded) return;
+
+  const auto start = std::chrono::steady_clock::now();
+  bool loaded = false;
+  if (metadata.IsValid()) {
+    switch (job.status) {
+      case AssetStreamStatus::kLoaded:
+        loaded = AssetImporter::FinalizeData(metadata, job.asset);
+        break;
+      case AssetStreamStatus::kMainThread:
+        loaded = AssetImporter::TryLoadData(metadata, job.asset);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (!loaded || !job.asset) {
+    BE_CORE_WARN("[AssetManager] Failed to stream asset {0}",
+                 job.metadata.file_path.string());
+    // 失敗した結果もしばらく残し、毎フレーム読み込み直さないようにする
+    job.result->retry_time = std::chrono::steady_clock::now() +
+                             kLoadRetryInterval;
+    job.result->state.store(AssetLoadState::kFailed,
+                            std::memory_order_release);
+    return;
+  }
+
+  metadata.is_data_loaded = true;
+  load_times_[metadata.handle] =
+      job.load_time + std::chrono::duration_cast<std::chrono::microseconds>(
+                          std::chrono::steady_clock::now() - start);
+  AddLoadedAsset(metadata, job.asset);
+  job.result->asset = job.asset;
+  job.result->state.store(AssetLoadState::kReady, std::memory_order_release);
+}
+
+void EditorAssetManager::AddLoadedAsset(const AssetMetadata& metadata,
+                                        const Ref<Asset>& asset) {
+  loaded_assets_[metadata.handle] = asset;
+
+  size_t memory_size = asset->GetMemorySize();
+  if (memory_size == 0) {
+    if (const auto it = file_stamps_.find(metadata.handle);
+        it != file_stamps_.end())
+      memory_size = it->second.file_size;
+  }
+  residency_.Add(metadata.handle, metadata.type, memory_size);
+
+  // 読み込んだ内容で参照先を記録し直し、参照先の読み込みを始めておく
+  if (std::vector<AssetHandle> dependencies;
+      AssetImporter::TryGetDependencies(asset, dependencies)) {
+    dependency_graph_.SetDependencies(metadata.handle, std::move(dependencies));
+    const AssetHandle handle = metadata.handle;
+    PrefetchAssets({&handle, 1}, false);
+  }
+}
+
+AssetPrefetchReport EditorAssetManager::PrefetchAssets(
+    const std::span<const AssetHandle> roots, const bool wait) {
+  const auto start = std::chrono::steady_clock::now();
+  AssetPrefetchReport report;
+
+  // 全て読み込み済みなら、集合も配列も作らずに戻る
+  if (size_t visits = 0; IsClosureResident(roots, 0, visits)) {
+    report.resident_count = visits;
+    return report;
+  }
+
+  // 依存される側から要求し、ワーカーがまとめて読み込めるようにする
+  std::unordered_set<AssetHandle> requested;
+  for (const AssetHandle handle : dependency_graph_.CollectTransitive(roots)) {
+    const auto& metadata = GetMetadataInternal(handle);
+    if (!metadata.IsValid() || !AssetImporter::IsLoadable(metadata.type))
+      continue;
+    if (metadata.is_data_loaded) {
+      residency_.Touch(handle);
+      ++report.resident_count;
+      continue;
+    }
+    if (GetAssetAsync(handle).IsLoading()) requested.insert(handle);
+  }
+  report.loaded_count = requested.size();
+  if (!wait || requested.empty()) return report;
+
+  BE_PROFILE_FUNC("AssetPrefetch");
+  WaitForAssets(roots, requested);
+
+  const auto load_time = [this,
+                          &requested](const AssetHandle handle) -> int64_t {
+    if (!requested.contains(handle)) return 0;
+    const auto it = load_times_.find(handle);
+    return it != load_times_.end() ? it->second.count() : 0;
+  };
+  report.wall_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  for (const AssetHandle handle : requested)
+    report.total_load_time += std::chrono::microseconds{load_time(handle)};
+  report.critical_path = dependency_graph_.FindCriticalPath(roots, load_time);
+  for (const AssetHandle handle : report.critical_path)
+    report.critical_path_time += std::chrono::microseconds{load_time(handle)};
+
+  LogPrefetchReport(report);
+  return report;
+}
+
+void EditorAssetManager::SetAssetDependencies(
+    const AssetHandle handle, std::vector<AssetHandle> dependencies) {
+  dependency_graph_.SetDependencies(handle, std::move(dependencies));
+}
+
+void EditorAssetManager::ScanDependencies(const AssetHandle handle) {
+  if (std::vector<AssetHandle> dependencies;
+      AssetImporter::TryGetDependencies(GetMetadataInternal(handle),
+                                        dependencies)) {
+    dependency_graph_.SetDependencies(handle, std::move(dependencies));
+  }
+}
+
+bool EditorAssetManager::IsClosureResident(
+    const std::span<const AssetHandle> handles, const uint32_t depth,
+    size_t& visits) {
+  for (const AssetHandle handle : handles) {
+    if (handle == 0) continue;
+    // 循環している参照もここで打ち切られる
+    if (++visits > kResidentCheckLimit || depth >= kResidentCheckDepth)
+      return false;
+    const auto& metadata = GetMetadataInternal(handle);
+    if (metadata.IsValid() && AssetImporter::IsLoadable(metadata.type)) {
+      if (!metadata.is_data_loaded) return false;
+      residency_.Touch(handle);
+    }
+    if (!IsClosureResident(dependency_graph_.GetDependencies(handle),
+                           depth + 1, visits))
+      return false;
+  }
+  return true;
+}
+
+void EditorAssetManager::WaitForAssets(
+    const std::span<const AssetHandle> roots,
+    std::unordered_set<AssetHandle>& requested) {
+  while (true) {
+    // 終わったジョブは他のアセットの分も仕上げる。待つのは roots の分だけ
+    streamer_->TakeCompleted(completed_jobs_);
+    for (auto& job : completed_jobs_) FinalizeStreamJob(job);
+    completed_jobs_.clear();
+
+    // 仕上げで参照先が分かったアセットがあるので、毎回辿り直す
+    bool loading = false;
+    for (const AssetHandle handle :
+         dependency_graph_.CollectTransitive(roots)) {
+      const auto& metadata = GetMetadataInternal(handle);
+      if (!metadata.IsValid() || metadata.is_data_loaded ||
+          !AssetImporter::IsLoadable(metadata.type))
+        continue;
+      if (GetAssetAsync(handle).IsLoading()) {
+        requested.insert(handle);
+        loading = true;
+      }
+    }
+    if (!loading || !streamer_->WaitCompleted()) return;
+  }
+}
+
+void EditorAssetManager::LogPrefetchReport(const AssetPrefetchReport& report) {
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  BE_CORE_INFO(
+      "[AssetManager] Prefetched {0} assets ({1} resident) in {2:.2f} ms, "
+      "sequential {3:.2f} ms",
+      report.loaded_count, report.resident_count,
+      Milliseconds{report.wall_time}.count(),
+      Milliseconds{report.total_load_time}.count());
+  BE_CORE_INFO("[AssetManager] Critical path {0:.2f} ms",
+               Milliseconds{report.critical_path_time}.count());
+  for (const AssetHandle handle : report.critical_path) {
+    const auto it = load_times_.find(handle);
+    BE_CORE_INFO(
+        "[AssetManager]   {0} {1:.2f} ms",
+        GetMetadataInternal(handle).file_path.string(),
+        Milliseconds{it != load_times_.end() ? it->second
+                                             : std::chrono::microseconds{}}
+            .count());
+  }
+}
+
+void EditorAssetManager::UnloadAsset(const AssetHandle handle) {
+  loaded_assets_.erase(handle);
+  // 次に要求されたときは読み込み直す
+  load_results_.erase(handle);
+  GetMetadataInternal(handle).is_data_loaded = false;
+  load_times_.erase(handle);
+  residency_.Evict(handle);
+}
+
+bool EditorAssetManager::IsAssetReferenced(const AssetHandle handle) {
+  const auto asset = loaded_assets_.find(handle);
+  if (asset == loaded_assets_.end()) return false;
+
+  // loaded_assets_ と、自分だけが持っている読み込み結果の分は数えない
+  uint32_t owners = 1;
+  if (const auto result = load_results_.find(handle);
+      result != load_results_.end()) {
+    if (result->second.use_count() > 1) return true;
+    if (result->second->asset.Raw() == asset->second.Raw()) ++owners;
+  }
+  return asset->second->GetRefCount() > owners;
+}
+
+void EditorAssetManager::UpdateResidency() {
+  residency_.AdvanceFrame();
+  if (!residency_.IsOverBudget()) return;
+
+  BE_PROFILE_FUNC("AssetResidency");
+  const auto evictions = residency_.SelectEvictions(
+      [this](const AssetHandle handle) { return !IsAssetReferenced(handle); });
+  for (const AssetHandle handle : evictions) UnloadAsset(handle);
+}
+
+void EditorAssetManager::SetMemoryBudget(const AssetType type,
+                                         const size_t bytes) {
+  residency_.SetBudget(type, bytes);
+}
+
+void EditorAssetManager::SetTotalMemoryBudget(const size_t bytes) {
+  residency_.SetTotalBudget(bytes);
+}
+
+size_t EditorAssetManager::EvictUnreferencedAssets() {
+  std::vector<AssetHandle> evictions;
+  for (const auto& entry : residency_.GetEntries()) {
+    if (!IsAssetReferenced(entry.handle)) evictions.push_back(entry.handle);
+  }
+  for (const AssetHandle handle : evictions) UnloadAsset(handle);
+  return evictions.size();
+}
+
 bool EditorAssetManager::IsMemoryAsset(AssetHandle handle) {
   return memory_assets_.contains(handle);
 }
@@ -103,9 +472,8 @@ const AssetMetadata& EditorAssetManager::GetMetadata(const AssetHandle handle) {
 
 const AssetMetadata& EditorAssetManager::GetMetadata(
     const std::filesystem::path& filepath) {
-  for (auto& metadata : asset_registry_ | std::views::values) {
-    if (metadata.file_path == filepath) return metadata;
-  }
+  if (const AssetHandle handle = asset_registry_.Find(filepath); handle != 0)
+    return asset_registry_.Get(handle);
 
   return kNullMetadata;
 }
@@ -123,7 +491,7 @@ AssetHandle EditorAssetManager::ImportAsset(
   metadata.handle = AssetHandle();
   metadata.file_path = filepath;
   metadata.type = type;
-  asset_registry_[metadata.handle] = metadata;
+  asset_registry_.Add(metadata);
 
   return metadata.handle;
 }
@@ -138,14 +506,40 @@ AssetMetadata& EditorAssetManager::GetMutableMetadata(AssetHandle handle) {
 
   return kNullMetadata;
 }
+
+bool EditorAssetManager::MountAssetPack(const std::filesystem::path& path) {
+  const AssetPack* pack = AssetImporter::MountPack(path);
+  if (!pack) {
+    BE_CORE_WARN("[AssetManager] Failed to mount asset pack {0}", path.string());
+    return false;
+  }
+
+  // ルーズファイルが無くてもハンドルやパスで引けるように登録する
+  for (const auto& entry : pack->GetEntries()) {
+    if (asset_registry_.Contains(entry.handle)) continue;
+    AssetMetadata metadata;
+    metadata.handle = entry.handle;
+    metadata.type = entry.type;
+    metadata.file_path = pack->GetEntryPath(entry);
+    asset_registry_.Add(metadata);
+  }
+  BE_CORE_INFO("[AssetManager] Mounted asset pack {0} ({1} assets)",
+               path.string(), pack->GetEntries().size());
+  return true;
+}
+
+void EditorAssetManager::SetAssetFilePath(
+    const AssetHandle handle, const std::filesystem::path& file_path) {
+  asset_registry_.SetFilePath(handle, file_path);
+}
+
 void EditorAssetManager::LoadAssetRegistry()
 {
   BE_CORE_INFO("[AssetManager] Loading Asset Registry");
 
-  const auto& asset_registry_path = "assets.be";
-  if (!std::filesystem::exists(asset_registry_path)) return;
+  if (!std::filesystem::exists(kAssetRegistryPath)) return;
 
-  std::ifstream stream(asset_registry_path);
+  std::ifstream stream(kAssetRegistryPath);
   std::stringstream str_stream;
   str_stream << stream.rdbuf();
 
@@ -171,60 +565,198 @@ void EditorAssetManager::LoadAssetRegistry()
       metadata.type = GetAssetTypeFromPath(filepath);
     }
 
-    if (!std::filesystem::exists(metadata.file_path)) {
+    if (metadata.handle == 0) {
+      continue;
+    }
 
-      std::string mostLikelyCandidate;
-      uint32_t bestScore = 0;
-      for (auto& pathEntry : std::filesystem::recursive_directory_iterator(
-               std::filesystem::current_path())) {
-        const std::filesystem::path& path = pathEntry.path();
+    asset_registry_.Add(metadata);
+  }
+  
+}
 
-        if (path.filename() != metadata.file_path.filename()) continue;
+bool EditorAssetManager::LoadRegistryCache() {
+  BE_PROFILE_FUNC("LoadRegistryCache");
 
-      	uint32_t score = 0;
-        for (const auto& part : path) {
-          if (filepath.find(part.string()) != std::string::npos) score++;
-        }
+  AssetRegistryCache cache;
+  if (!cache.Load(AssetRegistryCache::kFileName)) return false;
+  // pull 等で assets.be が変わっていればキャッシュのハンドルは古い
+  if (cache.GetRegistryStamp() != StampAssetRegistry()) {
+    BE_CORE_INFO("[AssetManager] {0} changed, ignoring {1}",
+                 kAssetRegistryPath, AssetRegistryCache::kFileName);
+    return false;
+  }
 
-        if (bestScore > 0 && score == bestScore) {
-          // TODO: How do we handle this?
-          // Probably prompt the user at this point?
-        }
+  for (const auto& entry : cache.GetAssets()) {
+    AssetMetadata metadata;
+    metadata.handle = entry.handle;
+    metadata.type = entry.type;
+    metadata.file_path = entry.file_path;
+    asset_registry_.Add(metadata);
+    file_stamps_[entry.handle] = entry.stamp;
+    if (entry.dependencies)
+      dependency_graph_.SetDependencies(entry.handle, *entry.dependencies);
+  }
+  for (const auto& directory : cache.GetDirectories()) {
+    directory_stamps_[AssetRegistry::NormalizePath(directory.path)] =
+        directory.write_time;
+  }
+  return true;
+}
 
-        if (score <= bestScore) continue;
+bool EditorAssetManager::ReloadAssetFiles() {
+  BE_PROFILE_FUNC("ReloadAssetFiles");
 
-        bestScore = score;
-        mostLikelyCandidate = path.string();
-      }
+  DirectoryScanState state;
+  for (const auto& directory : directory_stamps_ | std::views::keys) {
+    if (directory == ".") continue;
+    const std::string parent =
+        std::filesystem::path{directory}.parent_path().generic_string();
+    state.children[parent.empty() ? "." : parent].push_back(directory);
+  }
+  ScanDirectory(".", state);
 
-      if (mostLikelyCandidate.empty() && bestScore == 0) {
-        continue;
-      }
-      
-      metadata.file_path = std::filesystem::path{mostLikelyCandidate}.make_preferred();
+  // 走査し直したディレクトリや消えたディレクトリにあったアセットを集める
+  std::vector<AssetHandle> missing;
+  for (const auto& metadata : asset_registry_ | std::views::values) {
+    if (metadata.is_memory_asset || metadata.file_path.empty() ||
+        state.seen.contains(metadata.handle))
+      continue;
+    std::string parent =
+        AssetRegistry::NormalizePath(metadata.file_path.parent_path());
+    if (parent.empty()) parent = ".";
+    if (state.directories.contains(parent) && !state.rescanned.contains(parent))
+      continue;
+    missing.push_back(metadata.handle);
+  }
 
+  // 移動したファイルは同名の新規ファイルへハンドルを付け替える
+  for (const AssetHandle handle : missing) {
+    const std::filesystem::path old_path = asset_registry_.Get(handle).file_path;
+    const std::string old_string = old_path.string();
+
+    AssetHandle* candidate = nullptr;
+    uint32_t best_score = 0;
+    for (AssetHandle& imported : state.imported) {
+      if (imported == 0) continue;
+      const auto& new_path = asset_registry_.Get(imported).file_path;
+      if (new_path.filename() != old_path.filename()) continue;
+
+      uint32_t score = 1;
+      for (const auto& part : new_path) {
+        if (old_string.find(part.string()) != std::string::npos) score++;
+      }
+      if (score <= best_score) continue;
+      best_score = score;
+      candidate = &imported;
     }
 
-    if (metadata.handle == 0) {
+    if (!candidate) {
+      asset_registry_.Remove(handle);
+      file_stamps_.erase(handle);
+      dependency_graph_.Remove(handle);
       continue;
     }
 
-    asset_registry_[metadata.handle] = metadata;
+    const std::filesystem::path new_path =
+        asset_registry_.Get(*candidate).file_path;
+    asset_registry_.Remove(*candidate);
+    asset_registry_.SetFilePath(handle, new_path);
+    file_stamps_[handle] = file_stamps_[*candidate];
+    file_stamps_.erase(*candidate);
+    dependency_graph_.Remove(*candidate);
+    ScanDependencies(handle);
+    *candidate = 0;
   }
-  
+
+  // キャッシュ自体の書き込みで作業ツリー直下の更新時刻は毎回変わるので、
+  // 列挙し直しただけでは変化として扱わない
+  const bool changed =
+      !state.imported.empty() || !missing.empty() ||
+      state.directories.size() != directory_stamps_.size() ||
+      std::ranges::any_of(state.directories | std::views::keys,
+                          [this](const std::string& directory) {
+                            return !directory_stamps_.contains(directory);
+                          });
+  directory_stamps_ = std::move(state.directories);
+  return changed;
 }
 
-void EditorAssetManager::ReloadAssetFiles()
-{
-  for (const std::filesystem::directory_entry& x :
-       std::filesystem::recursive_directory_iterator(".")) {
-    const auto str = proximate(x.path());
-    ImportAsset(str);
+void EditorAssetManager::ScanDirectory(const std::string& directory,
+                                       DirectoryScanState& state) {
+  std::error_code error;
+  const auto write_time = std::filesystem::last_write_time(directory, error);
+  if (error) return;
+  const int64_t stamp = AssetRegistryCache::ToStamp(write_time);
+  state.directories[directory] = stamp;
+
+  // 直下の追加・削除・名前変更が無ければ前回のサブディレクトリだけ辿る
+  if (const auto it = directory_stamps_.find(directory);
+      it != directory_stamps_.end() && it->second == stamp) {
+    if (const auto child = state.children.find(directory);
+        child != state.children.end()) {
+      for (const auto& sub_directory : child->second)
+        ScanDirectory(sub_directory, state);
+    }
+    return;
+  }
 
+  state.rescanned.insert(directory);
+  for (const auto& entry :
+       std::filesystem::directory_iterator(directory, error)) {
+    const std::filesystem::path path = entry.path().lexically_normal();
+    if (entry.is_directory(error) && !entry.is_symlink(error)) {
+      ScanDirectory(path.generic_string(), state);
+      continue;
+    }
+    if (!entry.is_regular_file(error)) continue;
+
+    const bool known = asset_registry_.Find(path) != 0;
+    const AssetHandle handle = ImportAsset(path);
+    if (handle == 0) continue;
+    if (!known) state.imported.push_back(handle);
+
+    state.seen.insert(handle);
+    const AssetFileStamp stamp{
+        AssetRegistryCache::ToStamp(entry.last_write_time(error)),
+        entry.file_size(error)};
+    // 新しいファイルと変更されたファイルは参照先を調べ直す
+    auto& previous = file_stamps_[handle];
+    if (!known || previous != stamp || !dependency_graph_.Contains(handle))
+      ScanDependencies(handle);
+    previous = stamp;
   }
 }
 
 void EditorAssetManager::WriteRegistryToFile() {
+  BE_PROFILE_FUNC("WriteRegistryCache");
+
+  AssetRegistryCache cache;
+  for (const auto& metadata : asset_registry_ | std::views::values) {
+    if (metadata.is_memory_asset || metadata.file_path.empty()) continue;
+
+    AssetFileStamp stamp;
+    if (const auto it = file_stamps_.find(metadata.handle);
+        it != file_stamps_.end())
+      stamp = it->second;
+    std::optional<std::vector<AssetHandle>> dependencies;
+    if (dependency_graph_.Contains(metadata.handle)) {
+      const auto handles = dependency_graph_.GetDependencies(metadata.handle);
+      dependencies.emplace(handles.begin(), handles.end());
+    }
+    cache.AddAsset({metadata.handle, metadata.type, metadata.file_path, stamp,
+                    std::move(dependencies)});
+  }
+  for (const auto& [directory, write_time] : directory_stamps_) {
+    cache.AddDirectory({directory, write_time});
+  }
+  cache.SetRegistryStamp(StampAssetRegistry());
+
+  if (!cache.Save(AssetRegistryCache::kFileName))
+    BE_CORE_WARN("[AssetManager] Failed to write {0}",
+                 AssetRegistryCache::kFileName);
+}
+
+void EditorAssetManager::ExportRegistryToYAML() {
   struct AssetRegistryEntry {
     std::string file_path;
     AssetType type;
@@ -257,8 +789,7 @@ void EditorAssetManager::WriteRegistryToFile() {
   out << YAML::EndSeq;
   out << YAML::EndMap;
 
-  const std::string& asset_registry_path = "assets.be";
-  std::ofstream fout(asset_registry_path);
+  std::ofstream fout(kAssetRegistryPath);
   fout << out.c_str();
 }
 
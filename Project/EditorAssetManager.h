@@ -6,8 +6,14 @@
 // @details
 
 #pragma once
+#include <chrono>
+#include <memory>
+#include <unordered_set>
+
 #include "AssetImporter.h"
 #include "AssetRegistry.h"
+#include "AssetRegistryCache.h"
+#include "AssetStreamer.h"
 #include "IBaseEngineAssetManager.h"
 
 namespace base_engine {
@@ -34,6 +40,22 @@ class EditorAssetManager : public IBaseEngineAssetManager {
       override;
 
   Ref<Asset> GetAsset(const std::filesystem::path file_path) override;
+  AssetLoadRequest GetAssetAsync(AssetHandle asset_handle) override;
+  void SetPlaceholderAsset(AssetType type, Ref<Asset> asset) override;
+  void UpdateStreaming() override;
+  void UpdateResidency() override;
+  void SetMemoryBudget(AssetType type, size_t bytes) override;
+  void SetTotalMemoryBudget(size_t bytes) override;
+  size_t EvictUnreferencedAssets() override;
+  const AssetResidency& GetResidency() const override { return residency_; }
+  bool IsAssetReferenced(AssetHandle handle) override;
+  AssetPrefetchReport PrefetchAssets(std::span<const AssetHandle> roots,
+                                     bool wait) override;
+  void SetAssetDependencies(AssetHandle handle,
+                            std::vector<AssetHandle> dependencies) override;
+  const AssetDependencyGraph& GetDependencyGraph() const override {
+    return dependency_graph_;
+  }
 
   const AssetMetadata& GetMetadata(AssetHandle handle);
   const AssetMetadata& GetMetadata(const std::filesystem::path& filepath);
@@ -42,6 +64,9 @@ class EditorAssetManager : public IBaseEngineAssetManager {
 
   static AssetType GetAssetTypeFromPath(const std::filesystem::path& path);
   AssetMetadata& GetMutableMetadata(AssetHandle handle) override;
+  void SetAssetFilePath(AssetHandle handle,
+                        const std::filesystem::path& file_path) override;
+  bool MountAssetPack(const std::filesystem::path& path) override;
   const AssetRegistry& GetAssetRegistry() const;
   template <typename T, typename... Args>
   Ref<T> CreateNewAsset(const std::filesystem::path& filename,
@@ -59,30 +84,99 @@ class EditorAssetManager : public IBaseEngineAssetManager {
       if (pre_asset->GetAssetType() == T::GetStaticType())
         return pre_asset.As<T>();
     }
-    asset_registry_[metadata.handle] = metadata;
+    asset_registry_.Add(metadata);
 
     WriteRegistryToFile();
 
     Ref<T> asset = Ref<T>::Create(std::forward<Args>(args)...);
     asset->handle_ = metadata.handle;
-    loaded_assets_[asset->handle_] = asset;
+    AddLoadedAsset(metadata, asset);
     AssetImporter::Serialize(metadata, asset);
 
     return asset;
   }
 
  private:
+  /// 1フレームで読み込みの仕上げに使う時間の目安
+  static constexpr std::chrono::microseconds kStreamingFrameBudget{2000};
+  /// 読み込みに失敗したアセットを要求し直せるまでの時間
+  static constexpr std::chrono::seconds kLoadRetryInterval{2};
+  /// 読み込み済みかを確保せずに調べるときに辿る深さと数の上限
+  static constexpr uint32_t kResidentCheckDepth = 8;
+  static constexpr size_t kResidentCheckLimit = 256;
+  /// 読み込み済みアセット全体の既定のメモリ予算
+  static constexpr size_t kDefaultMemoryBudget = size_t{512} * 1024 * 1024;
+
+  struct DirectoryScanState {
+    //! 前回の走査で見つかったサブディレクトリ
+    std::unordered_map<std::string, std::vector<std::string>> children;
+    //! 今回の走査で見つかったディレクトリと更新時刻
+    std::unordered_map<std::string, int64_t> directories;
+    //! 中身を列挙し直したディレクトリ
+    std::unordered_set<std::string> rescanned;
+    std::unordered_set<AssetHandle> seen;
+    //! 今回新しく登録したアセット。移動の付け替えに使う
+    std::vector<AssetHandle> imported;
+  };
+
+  /// YAML のレジストリを読む。バイナリキャッシュが無い場合だけ使う
   void LoadAssetRegistry();
-
-  void ReloadAssetFiles();
+  bool LoadRegistryCache();
+  void FinalizeStreamJob(AssetStreamJob& job);
+  void AddLoadedAsset(const AssetMetadata& metadata, const Ref<Asset>& asset);
+  void UnloadAsset(AssetHandle handle);
+  /// 読み込まずにファイルから参照先を調べて依存グラフに記録する
+  void ScanDependencies(AssetHandle handle);
+  /**
+   * \brief roots とその参照先の読み込みが終わるまで待ち、仕上げまで行う
+   *
+   * 他のアセットの読み込みは待たない。仕上げの中で新しく見つかった参照先も待つ
+   * \param requested 待っている間に要求したアセットを加える
+   */
+  void WaitForAssets(std::span<const AssetHandle> roots,
+                     std::unordered_set<AssetHandle>& requested);
+  /**
+   * \brief handles から辿れるアセットが全て読み込み済みか、確保をせずに調べる
+   * \param visits 調べたアセットの数。多すぎる場合は false を返して打ち切る
+   */
+  bool IsClosureResident(std::span<const AssetHandle> handles, uint32_t depth,
+                         size_t& visits);
+  void LogPrefetchReport(const AssetPrefetchReport& report);
+
+  /**
+   * \brief 作業ツリーを走査して新しいファイルを登録する
+   *
+   * 更新時刻が前回と同じディレクトリは列挙せず、サブディレクトリだけ辿る
+   * \return レジストリやディレクトリ構成に変化があれば true
+   */
+  bool ReloadAssetFiles();
+  void ScanDirectory(const std::string& directory, DirectoryScanState& state);
+  /// バイナリキャッシュを書き出す
   void WriteRegistryToFile();
+  /// バージョン管理用に YAML のレジストリを書き出す
+  void ExportRegistryToYAML();
   AssetMetadata& GetMetadataInternal(AssetHandle handle);
 
  private:
   std::unordered_map<AssetHandle, Ref<Asset>> loaded_assets_;
   std::unordered_map<AssetHandle, Ref<Asset>> memory_assets_;
+  AssetResidency residency_;
+  AssetDependencyGraph dependency_graph_;
+  //! 最後に読み込んだときにかかった時間
+  std::unordered_map<AssetHandle, std::chrono::microseconds> load_times_;
 
   AssetRegistry asset_registry_;
+  std::unordered_map<AssetHandle, AssetFileStamp> file_stamps_;
+  //! 正規化済みディレクトリパスと最終更新時刻
+  std::unordered_map<std::string, int64_t> directory_stamps_;
+
+  std::unique_ptr<AssetStreamer> streamer_;
+  // 一度でも非同期に要求したアセットの読み込み結果
+  std::unordered_map<AssetHandle, std::shared_ptr<AssetLoadResult>>
+      load_results_;
+  std::unordered_map<AssetType, Ref<Asset>> placeholder_assets_;
+  // 仕上げが次のフレームに持ち越されたジョブ
+  std::vector<AssetStreamJob> completed_jobs_;
 };
 
 }  // namespace base_engine
@@ -1,8 +1,10 @@
 ﻿#include "EditorPanelManager.h"
 
+#include "AssetResidencyPanel.h"
 #include "HierarchyPanel.h"
 #include "imgui.h"
 #include "InspectorPanel.h"
+#include "RenderStatsPanel.h"
 #include "ToolbarPanel.h"
 
 namespace base_engine::editor {
@@ -10,6 +12,8 @@ void EditorPanelManager::Initialize() {
   panels_.emplace_back(std::make_shared<HierarchyPanel>());
   panels_.emplace_back(std::make_shared<InspectorPanel>());
   panels_.emplace_back(std::make_shared<ToolbarPanel>(this));
+  panels_.emplace_back(std::make_shared<RenderStatsPanel>());
+  panels_.emplace_back(std::make_shared<AssetResidencyPanel>());
 
   for (const auto& editor_panel : panels_) {
     editor_panel->Initialize(scene_context_);
@@ -1,5 +1,6 @@
 ﻿#include "FollowComponent.h"
 
+#include "GameClock.h"
 #include "VectorUtilities.h"
 FollowComponent::FollowComponent(base_engine::Actor* owner) : Component(owner) {
   offset_ = base_engine::Vector2{0, -64 - 32};
@@ -18,7 +19,8 @@ void FollowComponent::Update() {
 
   target_pos_ =
       current_pos + (base_engine::VectorUtilities::Normalize(targetDirection) *
-                     interp_velocity_ * 0.017f);
+                     interp_velocity_ *
+                     base_engine::GameClock::GetInstance()->GetFixedDeltaTime());
 
   const auto move_pos = base_engine::Vector2{
       std::lerp(current_pos.x, target_pos_.x, 0.6f),
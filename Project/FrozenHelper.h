@@ -44,6 +44,11 @@ SizeTag<T> make_size_tag(T&& size) {
   return SizeTag<T>{std::forward<T>(size)};
 }
 
+/// 連続した要素をまとめて書き込んでも、要素ごとに書き込んだ場合と同じバイト列になる型
+template <class T>
+concept ContiguousBinary =
+    std::is_arithmetic_v<T> && !std::is_same_v<T, bool>;
+
 }  // namespace frozen
 template <class ArchiveType, class T>
 concept BinaryArchiveConcept = requires(ArchiveType& ar,
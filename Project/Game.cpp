@@ -2,8 +2,12 @@
 
 #include <Mof.h>
 #include <Utilities/GraphicsUtilities.h>
+#include <shellapi.h>
 
+#include <filesystem>
 #include <iostream>
+#include <optional>
+#include <string_view>
 
 #include "Actor.h"
 #include "AssetManager.h"
@@ -12,20 +16,37 @@
 #include "ConnectableObject.h"
 #include "DataComponents.h"
 #include "EditorLayer.h"
+#include "GameClock.h"
 #include "GameScene.h"
 #include "IBaseEngineCollider.h"
 #include "IBaseEngineRender.h"
+#include "IBaseEngineTexture.h"
+#include "Log.h"
 #include "MethodBind.h"
 #include "ObjectEntity.h"
 #include "PhysicsObjectFactory.h"
 #include "Profiler.h"
-#include "RenderComponent.h"
 #include "Scene.h"
 #include "SceneSerializer.h"
 #include "Script.h"
 #include "Texture.h"
 base_engine::IBaseEngineCollider* b_collision;
 
+namespace {
+// N --render-stats <o͐> Ŏw肳ꂽA`擝v̏o
+std::optional<std::filesystem::path> FindRenderStatsCapturePath() {
+  int argc = 0;
+  LPWSTR* argv = CommandLineToArgvW(GetCommandLineW(), &argc);
+  if (!argv) return std::nullopt;
+  std::optional<std::filesystem::path> path;
+  for (int i = 1; i + 1 < argc; ++i) {
+    if (std::wstring_view{argv[i]} == L"--render-stats") path = argv[i + 1];
+  }
+  LocalFree(argv);
+  return path;
+}
+}  // namespace
+
 namespace base_engine {
 
 bool Game::Initialize() {
@@ -61,7 +82,20 @@ bool Game::Initialize() {
   editor_layer_ = std::make_unique<editor::EditorLayer>(this);
   editor_layer_->Initialize(scene_);
   BASE_ENGINE(Render)->Initialize();
+  // CI ȂǃGfB^𑀍삵Ȃł́ANŃLv`n߂
+  if (const auto path = FindRenderStatsCapturePath();
+      path && !BASE_ENGINE(Render)->StartStatsCapture(
+                  *path, RenderStatsCapture::GetFormatFromPath(*path))) {
+    BE_CORE_WARN("Render stats capture could not open {}", path->string());
+  }
   BASE_ENGINE(AssetManager)->Initialize();
+  // ǂݍݒ̃eNX`̑ɕ`
+  BASE_ENGINE(AssetManager)
+      ->SetPlaceholderAsset(AssetType::kTexture,
+                            TextureUtility::Create("no-texture.png"));
+#ifdef BE_DEBUG
+  BASE_ENGINE(Texture)->SetHotReloadEnabled(true);
+#endif
 
   actors_.reserve(1024);
   BASE_ENGINE(Collider)->SetCallBack(this);
@@ -111,9 +145,19 @@ void Game::Update() {
 
   CreateObjectRegister();
   ProcessInput();
-  UpdateGame();
-  b_collision->Collide();
-  scene_->OnUpdate(0);
+  // LbV̓eNX`̃|C^Ŕׂ̂ŁAgςj
+  if (BASE_ENGINE(Texture)->PollHotReload(Mof::CUtilities::GetFrameSecond()))
+    BASE_ENGINE(Render)->InvalidateLayerCaches();
+  BASE_ENGINE(AssetManager)->UpdateStreaming();
+  BASE_ENGINE(AssetManager)->UpdateResidency();
+
+  const auto clock = GameClock::GetInstance();
+  const int32_t steps = clock->Advance(Mof::CUtilities::GetFrameSecond());
+  for (int32_t i = 0; i < steps; ++i) {
+    FixedUpdate(clock->GetFixedDeltaTime());
+    // uԂ͍̓͂ŏ̃Xebvǂ݁AXebvȂΎ̃t[Ɏc
+    if (i == 0) ConsumeInput();
+  }
 
   if (g_pInput->IsKeyPush(MOFKEY_B)) {
     g_pGraphics->SetScreenMode(false);
@@ -121,11 +165,11 @@ void Game::Update() {
 
   if (g_pInput->IsKeyPush(MOFKEY_P) && g_pInput->IsKeyHold(MOFKEY_LCONTROL)) {
     SceneSerializer serializer(scene_);
-    serializer.Serialize("Test.bscene");
+    serializer.Serialize("Test.bsceneb");
   }
   if (g_pInput->IsKeyPush(MOFKEY_L) && g_pInput->IsKeyHold(MOFKEY_LCONTROL)) {
     SceneSerializer serializer(scene_);
-    serializer.Deserialize("Test.bscene");
+    serializer.Deserialize("Test.bsceneb");
   }
   if (g_pInput->IsKeyPush(MOFKEY_V)) {
     g_pGraphics->SetScreenMode(true);
@@ -190,23 +234,6 @@ ActorWeakPtr Game::FindTagActor(std::string_view tag) {
   return ActorPtr{};
 }
 
-void Game::AddSprite(RenderComponent* render_component) {
-  const int my_draw_order = render_component->GetDrawOrder();
-  auto iter = sprites_.begin();
-  for (; iter != sprites_.end(); ++iter) {
-    if (my_draw_order < (*iter)->GetDrawOrder()) {
-      break;
-    }
-  }
-
-  sprites_.insert(iter, render_component);
-}
-
-void Game::RemoveSprite(RenderComponent* render_component) {
-  auto iter = std::ranges::find(sprites_, render_component);
-  sprites_.erase(iter);
-}
-
 void Game::CreateObjectRegister() {
   for (int i = 0; i < next_frame_event_.size(); ++i) {
     next_frame_event_[i]();
@@ -241,6 +268,21 @@ void Game::ProcessInput() {
   updating_actors_ = false;
 }
 
+void Game::ConsumeInput() {
+  updating_actors_ = true;
+  for (const auto& actor : actors_) {
+    actor->ConsumeInput();
+  }
+  updating_actors_ = false;
+}
+
+void Game::FixedUpdate(const float time) {
+  BE_PROFILE_FUNC("FixedUpdate");
+  UpdateGame();
+  b_collision->Collide(time);
+  scene_->OnUpdate(time);
+}
+
 void Game::UpdateGame() {
   updating_actors_ = true;
   for (int i = 0; i < actors_.size(); ++i) {
@@ -297,7 +339,7 @@ void Game::SetNextFrameEvent(const std::function<void()>& event) {
 void Game::Render(){
   BE_PROFILE_FUNC("GameRender");
   BASE_ENGINE(Render)->Begin();
-  scene_->OnRender(0);
+  scene_->OnRender(GameClock::GetInstance()->GetInterpolationAlpha());
   BASE_ENGINE(Render)->Next();
   editor_layer_->OnRender();
   BASE_ENGINE(Render)->End();
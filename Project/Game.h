@@ -32,8 +32,6 @@ class Game {
   ActorWeakPtr GetActor(ActorId id);
   ActorWeakPtr FindTagActor(std::string_view tag);
 
-  void AddSprite(class RenderComponent* render_component);
-  void RemoveSprite(class RenderComponent* render_component);
   void Clear();
   void AddScene(std::string_view name);
   void AddScene(std::string_view name, const size_t index);
@@ -45,11 +43,16 @@ class Game {
  private:
   void CreateObjectRegister();
   void ProcessInput();
+  void ConsumeInput();
+  /**
+   * \brief 固定ステップ1回分ゲームを進める
+   * \param time 固定ステップの時間(秒)
+   */
+  void FixedUpdate(float time);
   void UpdateGame();
   std::vector<ActorWeakPtr> actor_id_cash_{1};
   std::vector<ActorPtr> actors_;
   std::vector<ActorPtr> actors_next_frame_delete_;
-  std::vector<class RenderComponent*> sprites_;
 
   bool updating_actors_;
   bool clear_wait_actors_ = false;
@@ -0,0 +1,42 @@
+﻿#include "GameClock.h"
+
+#include <algorithm>
+
+namespace base_engine {
+int32_t GameClock::Advance(const float frame_time) {
+  frame_delta_time_ = std::max(frame_time, 0.0f);
+  accumulator_ += frame_delta_time_;
+
+  int32_t steps = 0;
+  while (accumulator_ >= fixed_delta_time_ && steps < max_steps_per_frame_) {
+    accumulator_ -= fixed_delta_time_;
+    ++steps;
+  }
+
+  // 打ち切った分の時間は捨てる
+  if (accumulator_ >= fixed_delta_time_) {
+    accumulator_ = 0.0f;
+  }
+
+  fixed_step_count_ += steps;
+  return steps;
+}
+
+void GameClock::Reset() {
+  accumulator_ = 0.0f;
+  frame_delta_time_ = 0.0f;
+  fixed_step_count_ = 0;
+}
+
+void GameClock::SetFixedDeltaTime(const float time) {
+  fixed_delta_time_ = std::clamp(time, kMinFixedDeltaTime, kMaxFixedDeltaTime);
+}
+
+void GameClock::SetSubSteps(const int32_t count) {
+  sub_steps_ = std::clamp(count, 1, kMaxSubSteps);
+}
+
+void GameClock::SetMaxStepsPerFrame(const int32_t count) {
+  max_steps_per_frame_ = std::max(count, 1);
+}
+}  // namespace base_engine
@@ -0,0 +1,88 @@
+﻿// @GameClock.h
+// @brief
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 固定タイムステップのアキュムレータ。
+// 描画フレームの経過時間を貯め、固定ステップ分ずつ消費してシミュレーションを
+// 進める。余った時間は描画時の補間係数として使う。
+
+#pragma once
+#include <cstdint>
+
+namespace base_engine {
+constexpr float kDefaultFixedDeltaTime = 1.0f / 60.0f;
+constexpr float kMinFixedDeltaTime = 1.0f / 120.0f;
+constexpr float kMaxFixedDeltaTime = 1.0f / 30.0f;
+constexpr int32_t kDefaultMaxStepsPerFrame = 8;
+constexpr int32_t kMaxSubSteps = 16;
+
+class GameClock {
+ public:
+  static GameClock* GetInstance() {
+    if (instance_ == nullptr) {
+      instance_ = new GameClock();
+    }
+
+    return instance_;
+  }
+
+  /**
+   * \brief 描画フレームの経過時間を加算し、このフレームで実行する固定ステップ数を返します。
+   * 処理落ちで時間が貯まり続けないよう、1フレームのステップ数は
+   * GetMaxStepsPerFrame() で打ち切られます。
+   * \param frame_time 前回のフレームからの経過時間(秒)
+   * \return 実行する固定ステップ数
+   */
+  int32_t Advance(float frame_time);
+
+  void Reset();
+
+  /**
+   * \brief 固定ステップの間隔を設定します。
+   * \param time 1ステップの時間(秒)。1/120 から 1/30 の範囲に丸められます
+   */
+  void SetFixedDeltaTime(float time);
+  [[nodiscard]] float GetFixedDeltaTime() const { return fixed_delta_time_; }
+
+  /**
+   * \brief 1つの固定ステップを物理演算で分割する数を設定します。
+   */
+  void SetSubSteps(int32_t count);
+  [[nodiscard]] int32_t GetSubSteps() const { return sub_steps_; }
+  [[nodiscard]] float GetSubStepDeltaTime() const {
+    return fixed_delta_time_ / static_cast<float>(sub_steps_);
+  }
+
+  void SetMaxStepsPerFrame(int32_t count);
+  [[nodiscard]] int32_t GetMaxStepsPerFrame() const {
+    return max_steps_per_frame_;
+  }
+
+  /// 直前のフレームの経過時間(秒)
+  [[nodiscard]] float GetFrameDeltaTime() const { return frame_delta_time_; }
+
+  /**
+   * \brief 前回の固定ステップから現在の固定ステップまでの補間係数 [0,1) を返します。
+   * 描画では 前回の状態 * (1 - alpha) + 現在の状態 * alpha を使います。
+   */
+  [[nodiscard]] float GetInterpolationAlpha() const {
+    return accumulator_ / fixed_delta_time_;
+  }
+
+  [[nodiscard]] uint64_t GetFixedStepCount() const { return fixed_step_count_; }
+
+ private:
+  GameClock() = default;
+  inline static GameClock* instance_ = nullptr;
+
+  float fixed_delta_time_ = kDefaultFixedDeltaTime;
+  int32_t sub_steps_ = 1;
+  int32_t max_steps_per_frame_ = kDefaultMaxStepsPerFrame;
+
+  float accumulator_ = 0.0f;
+  float frame_delta_time_ = 0.0f;
+  uint64_t fixed_step_count_ = 0;
+};
+}  // namespace base_engine
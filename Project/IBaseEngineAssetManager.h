@@ -11,7 +11,10 @@
 #include <unordered_set>
 
 #include "Asset.h"
+#include "AssetDependencyGraph.h"
+#include "AssetLoadRequest.h"
 #include "AssetMetadata.h"
+#include "AssetResidency.h"
 
 namespace base_engine {
 class IBaseEngineAssetManager {
@@ -24,6 +27,51 @@ class IBaseEngineAssetManager {
   virtual AssetType GetAssetType(AssetHandle asset_handle) = 0;
   virtual Ref<Asset> GetAsset(AssetHandle asset_handle) = 0;
   virtual Ref<Asset> GetAsset(std::filesystem::path file_path) = 0;
+  /**
+   * \brief アセットを別スレッドで読み込みます。読み込み済みならすぐに kReady になります。
+   * 同じアセットを読み込み中に呼ぶと、同じ読み込みを返します。
+   */
+  virtual AssetLoadRequest GetAssetAsync(AssetHandle asset_handle) = 0;
+  /**
+   * \brief 読み込み中に AssetLoadRequest::Get が返すアセットを種類ごとに設定します。
+   */
+  virtual void SetPlaceholderAsset(AssetType type, Ref<Asset> asset) = 0;
+  /**
+   * \brief 別スレッドで読み込み終えたアセットを仕上げて登録します。メインスレッドから毎フレーム呼びます。
+   */
+  virtual void UpdateStreaming() = 0;
+  /**
+   * \brief メモリの予算を超えていれば、どこからも参照されていないアセットを
+   * 使われていない順に解放します。メインスレッドから毎フレーム呼びます。
+   */
+  virtual void UpdateResidency() = 0;
+  /**
+   * \brief 種類ごとのメモリの予算を設定します。0 なら上限なし
+   */
+  virtual void SetMemoryBudget(AssetType type, size_t bytes) = 0;
+  /**
+   * \brief 読み込み済みアセット全体のメモリの予算を設定します。0 なら上限なし
+   */
+  virtual void SetTotalMemoryBudget(size_t bytes) = 0;
+  /**
+   * \brief 予算に関係なく、参照されていないアセットを全て解放します。
+   * \return 解放した数
+   */
+  virtual size_t EvictUnreferencedAssets() = 0;
+  virtual const AssetResidency& GetResidency() const = 0;
+  virtual bool IsAssetReferenced(AssetHandle handle) = 0;
+  /**
+   * \brief roots と、依存グラフを辿って見つかる全てのアセットを並列に読み込みます。
+   * \param wait true なら全て読み込み終えるまで待ち、時間の内訳を返します。
+   */
+  virtual AssetPrefetchReport PrefetchAssets(std::span<const AssetHandle> roots,
+                                             bool wait) = 0;
+  /**
+   * \brief アセットが参照しているアセットを依存グラフに記録します。
+   */
+  virtual void SetAssetDependencies(AssetHandle handle,
+                                    std::vector<AssetHandle> dependencies) = 0;
+  virtual const AssetDependencyGraph& GetDependencyGraph() const = 0;
   virtual void AddMemoryOnlyAsset(Ref<Asset> asset) = 0;
   virtual bool ReloadData(AssetHandle asset_handle) = 0;
   virtual bool IsAssetHandleValid(AssetHandle asset_handle) = 0;
@@ -38,5 +86,8 @@ class IBaseEngineAssetManager {
   GetMemoryOnlyAssets() = 0;
 
   virtual AssetMetadata& GetMutableMetadata(AssetHandle handle) = 0;
+  virtual void SetAssetFilePath(AssetHandle handle,
+                                const std::filesystem::path& file_path) = 0;
+  virtual bool MountAssetPack(const std::filesystem::path& path) = 0;
 };
 }  // namespace base_engine
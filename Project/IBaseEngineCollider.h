@@ -19,7 +19,11 @@ class IBaseEngineCollider {
  public:
   static IBaseEngineCollider* Create();
   virtual ~IBaseEngineCollider();
-  virtual void Collide() = 0;
+  /**
+   * \brief 固定ステップ1回分の衝突判定を行う
+   * \param time_step 固定ステップの時間(秒)
+   */
+  virtual void Collide(float time_step) = 0;
   virtual void Register(class CollisionComponent* collision) = 0;
   virtual void Remove(class CollisionComponent* collision) = 0;
   virtual void SendComponentsMessage(class Component* component,
@@ -2,6 +2,8 @@
 #include <memory>
 #include <Graphics/Texture.h>
 
+#include "RenderStatsCapture.h"
+
 namespace base_engine {
 class IBaseEngineRender {
  public:
@@ -39,11 +41,67 @@ class IBaseEngineRender {
   virtual void AddCircleFrame(const Circle& circle, const Color& color) = 0;
   virtual void SetCameraPosition(const Vector& position) = 0;
   virtual void SetMaterial(const std::shared_ptr<Material>& material) = 0;
+  /**
+   * \brief ȍ~ɒǉ`̃C[ƕ`揇ݒ肷
+   * ` End/Next ŃC[A`揇̏ɍsA`揇͒ǉɕ`
+   */
+  virtual void SetSortOrder(uint8_t layer, int32_t draw_order) = 0;
+
+  /**
+   * \brief ʃXbhŕ`R}h邽߁Ã݂Jƕ`揇 list 
+   */
+  virtual void BeginCommandList(class RenderCommandList& list) = 0;
+
+  /**
+   * \brief ʃXbhō`R}hǉB`XbhĂ
+   */
+  virtual void Submit(const class RenderCommandList& list) = 0;
   virtual void Begin() = 0;
   virtual void Next() = 0;
   virtual void End() = 0;
 
   virtual ITexturePtr GetTargetTexture() = 0;
   virtual Vector GetCameraPosition() = 0;
+  /**
+   * \brief ݂̕`ɉf郏[hW͈̔͂Ԃ
+   */
+  virtual Rect GetViewRect() = 0;
+
+  /**
+   * \brief C[̕`挋ʂLbV邩ݒ肷
+   * LbVC[́A`R}h̓eJ̃oPbgςƂ`
+   */
+  virtual void SetLayerCached(uint8_t layer, bool cached) = 0;
+  virtual bool IsLayerCached(uint8_t layer) const = 0;
+
+  /**
+   * \brief eNX`̏ȂǁA`R}hɌȂύXLbVɔf
+   */
+  virtual void InvalidateLayerCache(uint8_t layer) = 0;
+  /**
+   * \brief SẴC[̃LbVjBeNX`̍ēǂݍ݂ȂǂŎg
+   */
+  virtual void InvalidateLayerCaches() = 0;
+
+  /**
+   * \brief LbVC[[hW͈̔͂Ԃ
+   * LbV郌C[͈͂̔͂ŃJOƁAoPbgς܂ŕ`Ȃ
+   */
+  virtual Rect GetLayerCacheRect() = 0;
+
+  /**
+   * \brief Õt[̕`R}hAob`A`̐Ԃ
+   */
+  virtual const struct RenderFrameStats& GetFrameStats() const = 0;
+
+  /**
+   * \brief t[̕`擝vt@C֏on߂
+   * GfB^g킸ɁAN --render-stats Jnł
+   * \return t@CJȂ false
+   */
+  virtual bool StartStatsCapture(const std::filesystem::path& path,
+                                 RenderStatsCaptureFormat format) = 0;
+  virtual void StopStatsCapture() = 0;
+  virtual const RenderStatsCapture& GetStatsCapture() const = 0;
 };
 }  // namespace base_engine
\ No newline at end of file
@@ -1,11 +1,20 @@
 #pragma once
 #include <Graphics/Texture.h>
 
+#include <cstdint>
 #include <string>
 
 namespace base_engine {
+/**
+ * \brief パスを一度だけ解決して得る密なテクスチャハンドル
+ * Get(TextureHandle) は配列の添え字アクセスになる
+ */
 struct TextureHandle {
-  size_t handle;
+  static constexpr size_t kInvalid = SIZE_MAX;
+  size_t handle = kInvalid;
+
+  [[nodiscard]] bool IsValid() const { return handle != kInvalid; }
+  bool operator==(const TextureHandle&) const = default;
 };
 
 using TexturePtr = Mof::LPTexture;
@@ -17,8 +26,29 @@ class IBaseEngineTexture {
   virtual ~IBaseEngineTexture();
 
   virtual bool Load(std::string_view name) = 0;
+  /**
+   * \brief パスをハンドルに解決する。ファイルシステムには触れない
+   * \param name テクスチャのパス
+   * \return 未ロードなら無効なハンドル
+   */
+  virtual TextureHandle Resolve(std::string_view name) = 0;
+  virtual TexturePtr Get(TextureHandle handle) = 0;
   virtual TexturePtr Get(std::string_view name) = 0;
   virtual bool Release(std::string_view name) = 0;
   virtual void Clear() = 0;
+
+  /**
+   * \brief 更新されたファイルの再読み込みを有効にする
+   * ハンドルと TexturePtr は再読み込み後もそのまま使える
+   */
+  virtual void SetHotReloadEnabled(bool enabled) = 0;
+  /**
+   * \brief 一定間隔ごとにファイルの更新時刻を確認し再読み込みする
+   * 読み込めなかったファイルは今のテクスチャをそのまま残す
+   * \param delta_time 前回呼び出しからの経過秒
+   * \return 再読み込みしたテクスチャがあれば true。
+   * TexturePtr は変わらないので、レイヤーのキャッシュは呼び出し側で破棄する
+   */
+  virtual bool PollHotReload(float delta_time) = 0;
 };
-}  // namespace base_engine
\ No newline at end of file
+}  // namespace base_engine
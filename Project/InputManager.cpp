@@ -28,8 +28,6 @@ InputManager::~InputManager()
 
 void InputManager::ProcessInput() {
   move_horizontal_ = 0;
-  button_horizontal_ = 0;
-  button_vertical_ = 0;
   if (IsKeyHold(MOFKEY_A)) {
     move_horizontal_ += -1;
   }
@@ -37,28 +35,45 @@ void InputManager::ProcessInput() {
     move_horizontal_ += 1;
   }
 
+  // 押した瞬間の入力は ConsumeInput まで残す。
+  // 固定ステップがないフレームで押されても次のフレームで読まれる
+  float button_horizontal = 0;
+  float button_vertical = 0;
   if (IsKeyPush(MOFKEY_A)) {
-    button_horizontal_ += -1;
+    button_horizontal += -1;
   }
   if (IsKeyPush(MOFKEY_D)) {
-    button_horizontal_ += 1;
+    button_horizontal += 1;
   }
   if (IsKeyPush(MOFKEY_W)) {
-    button_vertical_ += -1;
+    button_vertical += -1;
   }
   if (IsKeyPush(MOFKEY_S)) {
-    button_vertical_ += 1;
+    button_vertical += 1;
   }
+  if (button_horizontal != 0) button_horizontal_ = button_horizontal;
+  if (button_vertical != 0) button_vertical_ = button_vertical;
 
-  button_decision_ = IsKeyPush(MOFKEY_SPACE);
-  button_back_ = IsKeyPush(MOFKEY_ESCAPE);
-  jump_fire_ = IsKeyPush(MOFKEY_SPACE);
-  place_beacon_fire_ = IsKeyPush(MOFKEY_S);
+  button_decision_ |= IsKeyPush(MOFKEY_SPACE);
+  button_back_ |= IsKeyPush(MOFKEY_ESCAPE);
+  jump_fire_ |= IsKeyPush(MOFKEY_SPACE);
+  place_beacon_fire_ |= IsKeyPush(MOFKEY_S);
   collect_beacon_fire_ = IsKeyHold(MOFKEY_W);
-  action_fire_ = IsKeyPush(MOFKEY_E);
-  pause_fire_ = IsKeyPush(MOFKEY_ESCAPE);
+  action_fire_ |= IsKeyPush(MOFKEY_E);
+  pause_fire_ |= IsKeyPush(MOFKEY_ESCAPE);
   sneak_fire_ = IsKeyHold(MOFKEY_LSHIFT);
   mouse_position_ = GetMousePos();
 }
 
+void InputManager::ConsumeInput() {
+  button_horizontal_ = 0;
+  button_vertical_ = 0;
+  button_decision_ = false;
+  button_back_ = false;
+  jump_fire_ = false;
+  place_beacon_fire_ = false;
+  action_fire_ = false;
+  pause_fire_ = false;
+}
+
 void InputManager::Update() {}
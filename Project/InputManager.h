@@ -22,6 +22,11 @@ class InputManager final : public base_engine::InputComponent {
   explicit InputManager(base_engine::InputActor* owner);
   ~InputManager() override;
   void ProcessInput() override;
+  /**
+   * \brief 押した瞬間の入力を消す。最初の固定ステップの後に呼ばれるので、
+   * 1回の押下は1つのステップだけが読む
+   */
+  void ConsumeInput() override;
   void Update() override;
 
   [[nodiscard]] float MoveHorizontal() const;
@@ -1,5 +1,6 @@
 ﻿#include "InspectorPanel.h"
 
+#include <algorithm>
 #include <numbers>
 
 #include "BodyMask.h"
@@ -44,6 +45,8 @@ void InspectorPanel::RenderProperties() {
   RenderTag(object);
   RenderTransform(object);
   RenderSprite(object);
+  RenderSpriteAnimator(object);
+  RenderParticleEmitter(object);
   RenderScript(object);
   RenderRigidBody(object);
   RenderCircleShape(object);
@@ -86,6 +89,8 @@ void InspectorPanel::RenderAddComponentButton(ObjectEntity& object) {
   if (ImGui::BeginPopup("AddComponent")) {
     using namespace component;
     AddComponentButton<SpriteRendererComponent>("SpriteRenderer", object);
+    AddComponentButton<SpriteAnimatorComponent>("SpriteAnimator", object);
+    AddComponentButton<ParticleEmitterComponent>("ParticleEmitter", object);
     AddComponentButton<ScriptComponent>("Script", object);
     AddComponentsButtonEvent<physics::Circle>(
         "Circle Shape", object,
@@ -150,6 +155,61 @@ void InspectorPanel::RenderSprite(ObjectEntity& object) {
     ImGui::ColorEdit4(
         "Color", sprite_component.color.fv,
         ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_AlphaBar);
+
+    int layer = sprite_component.layer;
+    if (ImGui::InputInt("Layer", &layer)) {
+      sprite_component.layer = static_cast<uint8_t>(std::clamp(layer, 0, 255));
+    }
+    ImGui::Checkbox("Static", &sprite_component.is_static);
+    ImGui::EndGroup();
+  }
+}
+
+void InspectorPanel::RenderSpriteAnimator(ObjectEntity& object) {
+  if (!object.HasComponent<component::SpriteAnimatorComponent>()) return;
+
+  if (ImGui::CollapsingHeader("Sprite Animator",
+                              ImGuiTreeNodeFlags_DefaultOpen)) {
+    ImGui::BeginGroup();
+    auto& animator = object.GetComponent<component::SpriteAnimatorComponent>();
+    ImGuiHelper::AssetReferenceField("Animation", &animator.animation,
+                                     AssetType::kSpriteAnimation);
+
+    int clip = static_cast<int>(animator.clip);
+    if (ImGui::InputInt("Clip", &clip) && clip >= 0) {
+      animator.Play(static_cast<uint32_t>(clip));
+    }
+    ImGui::DragFloat("Speed", &animator.speed, 0.01f);
+    ImGui::Checkbox("Playing", &animator.is_playing);
+    ImGui::EndGroup();
+  }
+}
+
+void InspectorPanel::RenderParticleEmitter(ObjectEntity& object) {
+  if (!object.HasComponent<component::ParticleEmitterComponent>()) return;
+
+  if (ImGui::CollapsingHeader("Particle Emitter",
+                              ImGuiTreeNodeFlags_DefaultOpen)) {
+    ImGui::BeginGroup();
+    auto& emitter = object.GetComponent<component::ParticleEmitterComponent>();
+    ImGuiHelper::AssetReferenceField("Texture", &emitter.texture,
+                                     AssetType::kTexture);
+    int max_particles = static_cast<int>(emitter.max_particles);
+    if (ImGui::InputInt("Max Particles", &max_particles) && max_particles > 0) {
+      emitter.max_particles = static_cast<uint32_t>(max_particles);
+    }
+    ImGui::DragFloat("Emission Rate", &emitter.emission_rate, 1.0f, 0.0f);
+    ImGui::DragFloatRange2("Lifetime", &emitter.lifetime_min,
+                           &emitter.lifetime_max, 0.01f, 0.0f);
+    ImGui::DragFloatRange2("Speed", &emitter.speed_min, &emitter.speed_max);
+    ImGui::SliderAngle("Direction", &emitter.direction);
+    ImGui::SliderAngle("Spread", &emitter.spread, 0.0f, 180.0f);
+    ImGui::DragFloat2("Gravity", &emitter.gravity.x);
+    ImGui::DragFloat("Size", &emitter.size, 0.01f, 0.0f);
+    ImGui::ColorEdit4(
+        "Color", emitter.color.fv,
+        ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_AlphaBar);
+    ImGui::Checkbox("Emitting", &emitter.is_emitting);
     ImGui::EndGroup();
   }
 }
@@ -23,6 +23,8 @@ class InspectorPanel : public EditorPanel {
   void RenderTag(ObjectEntity& object);
 	void RenderTransform(ObjectEntity& object);
 	void RenderSprite(ObjectEntity& object);
+	void RenderSpriteAnimator(ObjectEntity& object);
+	void RenderParticleEmitter(ObjectEntity& object);
 	void RenderScript(ObjectEntity& object);
 	void RenderRigidBody(ObjectEntity& object);
 	void RenderCircleShape(ObjectEntity& object);
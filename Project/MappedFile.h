@@ -0,0 +1,45 @@
+﻿// @MappedFile.h
+// @brief 読み取り専用のメモリマップドファイル
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// ファイル全体をアドレス空間に割り当て、コピーせずに参照できるようにする。
+
+#pragma once
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace base_engine {
+class MappedFile {
+ public:
+  MappedFile() = default;
+  explicit MappedFile(const std::filesystem::path& path) { Open(path); }
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  /**
+   * \brief ファイルを開いて読み取り専用で割り当てる
+   * \return 空のファイルや開けなかった場合は false
+   */
+  bool Open(const std::filesystem::path& path);
+  void Close();
+
+  [[nodiscard]] bool IsOpen() const { return data_ != nullptr; }
+  [[nodiscard]] std::span<const std::byte> GetData() const {
+    return {data_, size_};
+  }
+
+ private:
+  const std::byte* data_ = nullptr;
+  size_t size_ = 0;
+  //! HANDLE を Windows.h なしで持つ
+  void* file_ = nullptr;
+  void* mapping_ = nullptr;
+};
+}  // namespace base_engine
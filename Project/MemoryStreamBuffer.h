@@ -0,0 +1,24 @@
+﻿// @MemoryStreamBuffer.h
+// @brief メモリ上のデータを std::istream で読むためのバッファ
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// データはコピーせずに参照する。読み込みが終わるまで元のデータを保持すること。
+
+#pragma once
+#include <cstddef>
+#include <span>
+#include <streambuf>
+
+namespace base_engine {
+class MemoryStreamBuffer : public std::streambuf {
+ public:
+  explicit MemoryStreamBuffer(const std::span<const std::byte> data) {
+    // 読み込み専用なので const を外しても書き換えられることはない
+    const auto begin =
+        const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+    setg(begin, begin, begin + data.size());
+  }
+};
+}  // namespace base_engine
@@ -0,0 +1,58 @@
+﻿// @MofBlendState.h
+// @brief Mof の描画に D3D11 のブレンドステートを差し込む
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// Mof の SetBlending には無い合成(上書きや乗算済みアルファ)が必要な描画で使う。
+// Mof が使っているデバイスコンテキストへ直接ブレンドステートを設定し、
+// 終わったら元のステートに戻す。
+
+#pragma once
+#include <Mof.h>
+#include <d3d11.h>
+#include <wrl/client.h>
+
+namespace base_engine {
+using BlendStatePtr = Microsoft::WRL::ComPtr<ID3D11BlendState>;
+
+/**
+ * \brief 描画先0番に使うブレンドステートを作成します。
+ * \return 作成に失敗した場合は空
+ */
+inline BlendStatePtr CreateBlendState(
+    const D3D11_RENDER_TARGET_BLEND_DESC& target) {
+  D3D11_BLEND_DESC desc{};
+  desc.RenderTarget[0] = target;
+  BlendStatePtr state;
+  if (FAILED(g_pGraphics->GetDevice()->CreateBlendState(&desc, &state)))
+    return nullptr;
+  return state;
+}
+
+/**
+ * \brief 生存期間の間だけブレンドステートを差し替えます。
+ * state が空なら何もしません。
+ */
+class ScopedBlendState {
+ public:
+  explicit ScopedBlendState(ID3D11BlendState* state) {
+    if (!state) return;
+    context_ = g_pGraphics->GetDeviceContext();
+    context_->OMGetBlendState(&hold_state_, hold_factor_, &hold_mask_);
+    context_->OMSetBlendState(state, nullptr, 0xffffffff);
+  }
+  ~ScopedBlendState() {
+    if (context_)
+      context_->OMSetBlendState(hold_state_.Get(), hold_factor_, hold_mask_);
+  }
+  ScopedBlendState(const ScopedBlendState&) = delete;
+  ScopedBlendState& operator=(const ScopedBlendState&) = delete;
+
+ private:
+  ID3D11DeviceContext* context_ = nullptr;
+  BlendStatePtr hold_state_;
+  float hold_factor_[4]{};
+  UINT hold_mask_ = 0xffffffff;
+};
+}  // namespace base_engine
@@ -20,6 +20,13 @@ class MofTexture final : public Texture {
   ~MofTexture() override
   {
   	texture_->Release();
+  	delete texture_;
+  }
+  MofTexture(const MofTexture&) = delete;
+  MofTexture& operator=(const MofTexture&) = delete;
+  /// 展開後の RGBA8 の大きさ
+  size_t GetMemorySize() const override {
+    return size_t{texture_->GetWidth()} * texture_->GetHeight() * 4;
   }
   Mof::LPTexture texture_;
 };
@@ -71,8 +71,7 @@ void MonoScriptCacheStorage::GenerateCacheForAssembly(
       const auto id = std::hash<std::string>{}(managed_class.full_name);
       const AssetHandle handle =
           AssetManager::CreateMemoryOnlyAssetWithHandle<Script>(id, class_id);
-      AssetManager::GetMutableMetadata(handle).file_path =
-          managed_class.full_name;
+      AssetManager::SetAssetFilePath(handle, managed_class.full_name);
     }
   }
 }
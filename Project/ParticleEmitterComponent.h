@@ -0,0 +1,54 @@
+﻿// @ParticleEmitterComponent.h
+// @brief
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include <memory>
+#include <numbers>
+
+#include "Asset.h"
+#include "ParticlePool.h"
+#include "Vector2.h"
+#include "Vector4.h"
+
+namespace base_engine::component {
+/**
+ * \brief Entity の位置からパーティクルを放出する設定
+ * 粒そのものは ParticlePoolComponent のプールに入る
+ */
+struct ParticleEmitterComponent {
+  AssetHandle texture = kNullUuid;
+  uint32_t max_particles = 1024;
+  //! 1秒あたりの放出数
+  float emission_rate = 64.0f;
+  //! 次の更新でまとめて放出する数。放出後に 0 に戻る
+  uint32_t burst_count = 0;
+  float lifetime_min = 0.5f;
+  float lifetime_max = 1.0f;
+  float speed_min = 50.0f;
+  float speed_max = 100.0f;
+  //! 放出方向(ラジアン)と、その前後に広げる角度
+  float direction = -std::numbers::pi_v<float> * 0.5f;
+  float spread = std::numbers::pi_v<float> * 0.25f;
+  Vector2 gravity{0.0f, 0.0f};
+  Vector4 color = {1.0f, 1.0f, 1.0f, 1.0f};
+  float size = 1.0f;
+  bool is_emitting = true;
+
+  ParticleEmitterComponent() = default;
+  ParticleEmitterComponent(const ParticleEmitterComponent& other) = default;
+};
+
+/**
+ * \brief ParticleEmitterComponent の実行時の状態
+ * Scene が必要になった時点で追加し、複製やシリアライズの対象にはしない
+ */
+struct ParticlePoolComponent {
+  std::shared_ptr<ParticlePool> pool;
+  float emit_accumulator = 0.0f;
+  uint32_t random_state = 0x9E3779B9u;
+};
+}  // namespace base_engine::component
@@ -0,0 +1,118 @@
+﻿#include "ParticlePool.h"
+
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE__)
+#include <xmmintrin.h>
+#define BE_PARTICLE_SIMD
+#endif
+
+namespace base_engine {
+ParticlePool::ParticlePool(const size_t capacity) : capacity_(capacity) {
+  const size_t padded = (capacity + 3) & ~static_cast<size_t>(3);
+  position_x_.resize(padded);
+  position_y_.resize(padded);
+  velocity_x_.resize(padded);
+  velocity_y_.resize(padded);
+  life_.resize(padded);
+  inverse_lifetime_.resize(padded);
+  alpha_.resize(padded);
+  size_.resize(padded);
+  color_.resize(padded);
+}
+
+bool ParticlePool::Spawn(const ParticleSpawn& spawn) {
+  if (count_ >= capacity_ || spawn.lifetime <= 0.0f) return false;
+  const size_t i = count_++;
+  position_x_[i] = spawn.position_x;
+  position_y_[i] = spawn.position_y;
+  velocity_x_[i] = spawn.velocity_x;
+  velocity_y_[i] = spawn.velocity_y;
+  life_[i] = spawn.lifetime;
+  inverse_lifetime_[i] = 1.0f / spawn.lifetime;
+  alpha_[i] = 1.0f;
+  size_[i] = spawn.size;
+  color_[i] = spawn.color;
+  return true;
+}
+
+void ParticlePool::Update(const float delta_time, const float gravity_x,
+                          const float gravity_y) {
+  if (count_ == 0) return;
+  if (Integrate(delta_time, gravity_x, gravity_y)) {
+    Compact();
+  }
+}
+
+bool ParticlePool::Integrate(const float delta_time, const float gravity_x,
+                             const float gravity_y) {
+  // 配列は4の倍数に切り上げてあるので、端数の粒も4要素単位で計算してよい
+  const size_t count = (count_ + 3) & ~static_cast<size_t>(3);
+#ifdef BE_PARTICLE_SIMD
+  const __m128 dt = _mm_set1_ps(delta_time);
+  const __m128 gx = _mm_set1_ps(gravity_x * delta_time);
+  const __m128 gy = _mm_set1_ps(gravity_y * delta_time);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128 dead = zero;
+  for (size_t i = 0; i < count; i += 4) {
+    const __m128 vx = _mm_add_ps(_mm_loadu_ps(&velocity_x_[i]), gx);
+    const __m128 vy = _mm_add_ps(_mm_loadu_ps(&velocity_y_[i]), gy);
+    _mm_storeu_ps(&velocity_x_[i], vx);
+    _mm_storeu_ps(&velocity_y_[i], vy);
+    _mm_storeu_ps(&position_x_[i],
+                  _mm_add_ps(_mm_loadu_ps(&position_x_[i]), _mm_mul_ps(vx, dt)));
+    _mm_storeu_ps(&position_y_[i],
+                  _mm_add_ps(_mm_loadu_ps(&position_y_[i]), _mm_mul_ps(vy, dt)));
+
+    const __m128 life = _mm_sub_ps(_mm_loadu_ps(&life_[i]), dt);
+    _mm_storeu_ps(&life_[i], life);
+    if (i + 4 <= count_) {
+      dead = _mm_or_ps(dead, _mm_cmple_ps(life, zero));
+    }
+    const __m128 alpha =
+        _mm_mul_ps(life, _mm_loadu_ps(&inverse_lifetime_[i]));
+    _mm_storeu_ps(&alpha_[i], _mm_min_ps(_mm_max_ps(alpha, zero), one));
+  }
+  // 端数の枠には使われていない値が入っているので、寿命の判定は個別に行う
+  bool tail_dead = false;
+  for (size_t i = count_ & ~static_cast<size_t>(3); i < count_; ++i) {
+    tail_dead |= life_[i] <= 0.0f;
+  }
+  return tail_dead || _mm_movemask_ps(dead) != 0;
+#else
+  bool dead = false;
+  for (size_t i = 0; i < count; ++i) {
+    velocity_x_[i] += gravity_x * delta_time;
+    velocity_y_[i] += gravity_y * delta_time;
+    position_x_[i] += velocity_x_[i] * delta_time;
+    position_y_[i] += velocity_y_[i] * delta_time;
+    life_[i] -= delta_time;
+    alpha_[i] = std::clamp(life_[i] * inverse_lifetime_[i], 0.0f, 1.0f);
+    dead |= life_[i] <= 0.0f;
+  }
+  return dead;
+#endif
+}
+
+void ParticlePool::Compact() {
+  // 寿命の尽きた粒に末尾の粒を移して詰める。描画順は保たない
+  size_t i = 0;
+  while (i < count_) {
+    if (life_[i] > 0.0f) {
+      ++i;
+      continue;
+    }
+    const size_t last = --count_;
+    position_x_[i] = position_x_[last];
+    position_y_[i] = position_y_[last];
+    velocity_x_[i] = velocity_x_[last];
+    velocity_y_[i] = velocity_y_[last];
+    life_[i] = life_[last];
+    inverse_lifetime_[i] = inverse_lifetime_[last];
+    alpha_[i] = alpha_[last];
+    size_[i] = size_[last];
+    color_[i] = color_[last];
+  }
+}
+}  // namespace base_engine
@@ -0,0 +1,77 @@
+﻿// @ParticlePool.h
+// @brief パーティクルを成分ごとの配列(SoA)で持つプール
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 位置や速度を成分ごとの連続した配列に置き、更新を4要素ずつの SIMD で行う。
+// 配列の長さは4の倍数に切り上げてあるので、末尾の端数もまとめて計算できる。
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace base_engine {
+/**
+ * \brief 1粒を生成するときの初期値
+ */
+struct ParticleSpawn {
+  float position_x;
+  float position_y;
+  float velocity_x;
+  float velocity_y;
+  float lifetime;
+  float size;
+  uint32_t color;
+};
+
+class ParticlePool {
+ public:
+  explicit ParticlePool(size_t capacity);
+
+  /**
+   * \brief 1粒を追加します
+   * \return 満杯で追加できなければ false
+   */
+  bool Spawn(const ParticleSpawn& spawn);
+
+  /**
+   * \brief 速度と位置を積分し、残り寿命からアルファを求め、寿命の尽きた粒を詰めます
+   * \param delta_time 経過時間(秒)
+   * \param gravity_x 加速度x
+   * \param gravity_y 加速度y
+   */
+  void Update(float delta_time, float gravity_x, float gravity_y);
+
+  void Clear() { count_ = 0; }
+
+  [[nodiscard]] size_t GetCount() const { return count_; }
+  [[nodiscard]] size_t GetCapacity() const { return capacity_; }
+
+  [[nodiscard]] const float* GetPositionX() const { return position_x_.data(); }
+  [[nodiscard]] const float* GetPositionY() const { return position_y_.data(); }
+  [[nodiscard]] const float* GetAlpha() const { return alpha_.data(); }
+  [[nodiscard]] const float* GetSize() const { return size_.data(); }
+  [[nodiscard]] const uint32_t* GetColor() const { return color_.data(); }
+
+ private:
+  /// \return 寿命の尽きた粒があれば true
+  bool Integrate(float delta_time, float gravity_x, float gravity_y);
+  void Compact();
+
+  size_t capacity_;
+  size_t count_ = 0;
+  std::vector<float> position_x_;
+  std::vector<float> position_y_;
+  std::vector<float> velocity_x_;
+  std::vector<float> velocity_y_;
+  //! 残り寿命(秒)
+  std::vector<float> life_;
+  std::vector<float> inverse_lifetime_;
+  //! 残り寿命の割合。描画時に色のアルファへ掛ける
+  std::vector<float> alpha_;
+  std::vector<float> size_;
+  std::vector<uint32_t> color_;
+};
+}  // namespace base_engine
@@ -1,8 +1,10 @@
 ﻿#include "PhysicsBlockAllocator.h"
 
+#include <algorithm>
 #include <array>
 #include <memory>
 #include <span>
+#include <thread>
 #include <xpolymorphic_allocator.h>
 
 namespace base_engine::physics {
@@ -10,6 +12,10 @@ constexpr int32_t kPhysicsChunkSize = 16 * 1024;
 constexpr int32_t kPhysicsMaxBlockSize = 640;
 constexpr int32_t kPhysicsChunkArrayIncrement = 128;
 
+// スレッドキャッシュが共有プールと一度にやり取りするブロック数
+constexpr int32_t kPhysicsCacheBatchCount = 32;
+constexpr int32_t kPhysicsCacheMaxCount = kPhysicsCacheBatchCount * 2;
+
 constexpr std::array kPhysicsBlockSizes = {
     static_cast<int32_t>(16),  // 0
     32,                        // 1
@@ -52,6 +58,29 @@ struct PhysicsBlock {
   PhysicsBlock* next;
 };
 
+struct PhysicsBlockCache {
+  std::thread::id owner;
+  PhysicsBlock* free_lists[kBlockSizeCount]{};
+  int32_t free_counts[kBlockSizeCount]{};
+  // 所有スレッドだけが書き込み、GetStats が読み込む
+  std::atomic<int64_t> live_counts[kBlockSizeCount]{};
+};
+
+namespace {
+std::atomic<uint32_t> g_physics_allocator_id = 1;
+
+struct PhysicsThreadCacheSlot {
+  uint32_t allocator_id = 0;
+  PhysicsBlockCache* cache = nullptr;
+};
+thread_local PhysicsThreadCacheSlot t_physics_cache_slot;
+
+void AddLiveCount(std::atomic<int64_t>& count, const int64_t value) {
+  count.store(count.load(std::memory_order_relaxed) + value,
+              std::memory_order_relaxed);
+}
+}  // namespace
+
 PhysicsBlockAllocator::PhysicsBlockAllocator() {
   m_chunkSpace = kPhysicsChunkArrayIncrement;
   m_chunkCount = 0;
@@ -60,6 +89,9 @@ PhysicsBlockAllocator::PhysicsBlockAllocator() {
 
   memset(m_chunks, 0, m_chunkSpace * sizeof(PhysicsChunk));
   memset(m_freeLists, 0, sizeof(m_freeLists));
+  memset(m_freeCounts, 0, sizeof(m_freeCounts));
+
+  m_id = g_physics_allocator_id.fetch_add(1, std::memory_order_relaxed);
 }
 
 PhysicsBlockAllocator::~PhysicsBlockAllocator() {
@@ -75,52 +107,21 @@ void* PhysicsBlockAllocator::Allocate(const int32_t size) {
     return nullptr;
   }
   if (size > kPhysicsMaxBlockSize) {
+    m_largeBytes.fetch_add(size, std::memory_order_relaxed);
     return malloc(size);
   }
 
-  if (const int32_t index = kPhysicsSizeMap[size]; m_freeLists[index]) {
-    PhysicsBlock* block = m_freeLists[index];
-    m_freeLists[index] = block->next;
-    return block;
-  } else {
-    if (m_chunkCount == m_chunkSpace) {
-      PhysicsChunk* oldChunks = m_chunks;
-      m_chunkSpace += kPhysicsChunkArrayIncrement;
-      m_chunks = static_cast<PhysicsChunk*>(
-          malloc(m_chunkSpace * sizeof(PhysicsChunk)));
-      memcpy(m_chunks, oldChunks, m_chunkCount * sizeof(PhysicsChunk));
-      memset(m_chunks + m_chunkCount, 0,
-             kPhysicsChunkArrayIncrement * sizeof(PhysicsChunk));
-      free(oldChunks);
-    }
-
-    PhysicsChunk* chunk = m_chunks + m_chunkCount;
-    chunk->blocks = static_cast<PhysicsBlock*>(malloc(kPhysicsChunkSize));
-
-#if defined(_DEBUG)
-    memset(chunk->blocks, 0xcd, kPhysicsChunkSize);
-#endif
-
-    const int32_t block_size = kPhysicsBlockSizes[index];
-    chunk->block_size = block_size;
-    const int32_t block_count = kPhysicsChunkSize / block_size;
-    for (int32_t i = 0; i < block_count - 1; ++i) {
-      const auto block = reinterpret_cast<PhysicsBlock*>(
-          reinterpret_cast<int8_t*>(chunk->blocks) + block_size * i);
-      const auto next = reinterpret_cast<PhysicsBlock*>(
-          reinterpret_cast<int8_t*>(chunk->blocks) + block_size * (i + 1));
-      block->next = next;
-    }
-    const auto last = reinterpret_cast<PhysicsBlock*>(
-        reinterpret_cast<int8_t*>(chunk->blocks) +
-        block_size * (block_count - 1));
-    last->next = nullptr;
-
-    m_freeLists[index] = chunk->blocks->next;
-    ++m_chunkCount;
-
-    return chunk->blocks;
+  const int32_t index = kPhysicsSizeMap[size];
+  PhysicsBlockCache* cache = GetThreadCache();
+  if (cache->free_lists[index] == nullptr) {
+    Refill(cache, index);
   }
+
+  PhysicsBlock* block = cache->free_lists[index];
+  cache->free_lists[index] = block->next;
+  --cache->free_counts[index];
+  AddLiveCount(cache->live_counts[index], 1);
+  return block;
 }
 
 void PhysicsBlockAllocator::Free(void* p, const int32_t size) {
@@ -129,6 +130,7 @@ void PhysicsBlockAllocator::Free(void* p, const int32_t size) {
   }
 
   if (size > kPhysicsMaxBlockSize) {
+    m_largeBytes.fetch_sub(size, std::memory_order_relaxed);
     free(p);
     return;
   }
@@ -138,29 +140,49 @@ void PhysicsBlockAllocator::Free(void* p, const int32_t size) {
 #if defined(_DEBUG)
   // Verify the memory address and size is valid.
   const int32_t block_size = kPhysicsBlockSizes[index];
-  bool found = false;
-  for (int32_t i = 0; i < m_chunkCount; ++i) {
-    PhysicsChunk* chunk = m_chunks + i;
-    if (chunk->block_size == block_size) {
-      if (chunk->blocks <= p &&
-          static_cast<int8_t*>(p) + block_size <=
-              reinterpret_cast<int8_t*>(chunk->blocks) + kPhysicsChunkSize) {
-        found = true;
+  {
+    std::lock_guard lock(m_mutex);
+    bool found = false;
+    for (int32_t i = 0; i < m_chunkCount; ++i) {
+      PhysicsChunk* chunk = m_chunks + i;
+      if (chunk->block_size == block_size) {
+        if (chunk->blocks <= p &&
+            static_cast<int8_t*>(p) + block_size <=
+                reinterpret_cast<int8_t*>(chunk->blocks) + kPhysicsChunkSize) {
+          found = true;
+        }
+      } else {
+        // TODO エラー処理
       }
-    } else {
-      // TODO エラー処理
     }
   }
 
   memset(p, 0xfd, block_size);
 #endif
 
+  PhysicsBlockCache* cache = GetThreadCache();
   const auto block = static_cast<PhysicsBlock*>(p);
-  block->next = m_freeLists[index];
-  m_freeLists[index] = block;
+  block->next = cache->free_lists[index];
+  cache->free_lists[index] = block;
+  ++cache->free_counts[index];
+  AddLiveCount(cache->live_counts[index], -1);
+
+  if (cache->free_counts[index] > kPhysicsCacheMaxCount) {
+    Drain(cache, index, kPhysicsCacheBatchCount);
+  }
+}
+
+void PhysicsBlockAllocator::FlushThreadCache() {
+  PhysicsBlockCache* cache = GetThreadCache();
+  for (int32_t i = 0; i < kBlockSizeCount; ++i) {
+    if (cache->free_counts[i] > 0) {
+      Drain(cache, i, 0);
+    }
+  }
 }
 
 void PhysicsBlockAllocator::Clear() {
+  std::lock_guard lock(m_mutex);
   for (int32_t i = 0; i < m_chunkCount; ++i) {
     free(m_chunks[i].blocks);
   }
@@ -168,5 +190,145 @@ void PhysicsBlockAllocator::Clear() {
   m_chunkCount = 0;
   memset(m_chunks, 0, m_chunkSpace * sizeof(PhysicsChunk));
   memset(m_freeLists, 0, sizeof(m_freeLists));
+  memset(m_freeCounts, 0, sizeof(m_freeCounts));
+
+  for (const auto& cache : m_caches) {
+    memset(cache->free_lists, 0, sizeof(cache->free_lists));
+    memset(cache->free_counts, 0, sizeof(cache->free_counts));
+    for (auto& count : cache->live_counts) {
+      count.store(0, std::memory_order_relaxed);
+    }
+  }
+  m_lentBytes = 0;
+}
+
+PhysicsBlockAllocatorStats PhysicsBlockAllocator::GetStats() const {
+  PhysicsBlockAllocatorStats stats;
+  std::lock_guard lock(m_mutex);
+  for (int32_t i = 0; i < m_chunkCount; ++i) {
+    const int32_t index = kPhysicsSizeMap[m_chunks[i].block_size];
+    stats.bytes_reserved[index] += kPhysicsChunkSize;
+  }
+  for (const auto& cache : m_caches) {
+    for (int32_t i = 0; i < kBlockSizeCount; ++i) {
+      stats.bytes_in_use[i] +=
+          cache->live_counts[i].load(std::memory_order_relaxed) *
+          kPhysicsBlockSizes[i];
+    }
+  }
+  stats.high_water_bytes = m_highWaterBytes;
+  stats.large_bytes_in_use = m_largeBytes.load(std::memory_order_relaxed);
+  stats.chunk_count = m_chunkCount;
+  stats.thread_cache_count = static_cast<int32_t>(m_caches.size());
+  return stats;
+}
+
+PhysicsBlockCache* PhysicsBlockAllocator::GetThreadCache() {
+  if (t_physics_cache_slot.allocator_id == m_id) {
+    return t_physics_cache_slot.cache;
+  }
+
+  std::lock_guard lock(m_mutex);
+  const auto thread_id = std::this_thread::get_id();
+  PhysicsBlockCache* result = nullptr;
+  for (const auto& cache : m_caches) {
+    if (cache->owner == thread_id) {
+      result = cache.get();
+      break;
+    }
+  }
+  if (result == nullptr) {
+    result = m_caches.emplace_back(std::make_unique<PhysicsBlockCache>()).get();
+    result->owner = thread_id;
+  }
+
+  t_physics_cache_slot = {m_id, result};
+  return result;
+}
+
+void PhysicsBlockAllocator::Refill(PhysicsBlockCache* cache,
+                                   const int32_t index) {
+  std::lock_guard lock(m_mutex);
+  if (m_freeLists[index] == nullptr) {
+    AllocateChunk(index);
+  }
+
+  int32_t count = 0;
+  PhysicsBlock* last = m_freeLists[index];
+  while (last->next && count + 1 < kPhysicsCacheBatchCount) {
+    last = last->next;
+    ++count;
+  }
+  ++count;
+
+  cache->free_lists[index] = m_freeLists[index];
+  cache->free_counts[index] = count;
+  m_freeLists[index] = last->next;
+  m_freeCounts[index] -= count;
+  last->next = nullptr;
+
+  m_lentBytes += static_cast<int64_t>(count) * kPhysicsBlockSizes[index];
+  m_highWaterBytes = std::max(m_highWaterBytes, m_lentBytes);
+}
+
+void PhysicsBlockAllocator::Drain(PhysicsBlockCache* cache, const int32_t index,
+                                  const int32_t keep) {
+  const int32_t count = cache->free_counts[index] - keep;
+  if (count <= 0) {
+    return;
+  }
+
+  PhysicsBlock* first = cache->free_lists[index];
+  PhysicsBlock* last = first;
+  for (int32_t i = 1; i < count; ++i) {
+    last = last->next;
+  }
+  cache->free_lists[index] = last->next;
+  cache->free_counts[index] = keep;
+
+  std::lock_guard lock(m_mutex);
+  last->next = m_freeLists[index];
+  m_freeLists[index] = first;
+  m_freeCounts[index] += count;
+  m_lentBytes -= static_cast<int64_t>(count) * kPhysicsBlockSizes[index];
+}
+
+void PhysicsBlockAllocator::AllocateChunk(const int32_t index) {
+  if (m_chunkCount == m_chunkSpace) {
+    PhysicsChunk* oldChunks = m_chunks;
+    m_chunkSpace += kPhysicsChunkArrayIncrement;
+    m_chunks =
+        static_cast<PhysicsChunk*>(malloc(m_chunkSpace * sizeof(PhysicsChunk)));
+    memcpy(m_chunks, oldChunks, m_chunkCount * sizeof(PhysicsChunk));
+    memset(m_chunks + m_chunkCount, 0,
+           kPhysicsChunkArrayIncrement * sizeof(PhysicsChunk));
+    free(oldChunks);
+  }
+
+  PhysicsChunk* chunk = m_chunks + m_chunkCount;
+  chunk->blocks = static_cast<PhysicsBlock*>(malloc(kPhysicsChunkSize));
+
+#if defined(_DEBUG)
+  memset(chunk->blocks, 0xcd, kPhysicsChunkSize);
+#endif
+
+  const int32_t block_size = kPhysicsBlockSizes[index];
+  chunk->block_size = block_size;
+  const int32_t block_count = kPhysicsChunkSize / block_size;
+  for (int32_t i = 0; i < block_count - 1; ++i) {
+    const auto block = reinterpret_cast<PhysicsBlock*>(
+        reinterpret_cast<int8_t*>(chunk->blocks) + block_size * i);
+    const auto next = reinterpret_cast<PhysicsBlock*>(
+        reinterpret_cast<int8_t*>(chunk->blocks) + block_size * (i + 1));
+    block->next = next;
+  }
+  const auto last = reinterpret_cast<PhysicsBlock*>(
+      reinterpret_cast<int8_t*>(chunk->blocks) +
+      block_size * (block_count - 1));
+  last->next = m_freeLists[index];
+
+  m_freeLists[index] = chunk->blocks;
+  m_freeCounts[index] += block_count;
+  ++m_chunkCount;
 }
 }  // namespace base_engine::physics
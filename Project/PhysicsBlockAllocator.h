@@ -4,32 +4,85 @@
 // @date 2022/10/16
 //
 // @details
+// 固定サイズブロックのアロケータ。
+// チャンクとフリーリストは全スレッドで共有し、各スレッドはブロックを
+// 一定数まとめて借りる PhysicsBlockCache を持つため、通常の Allocate / Free
+// はロックを取らない。
 
 #pragma once
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace base_engine::physics {
 constexpr int32_t kBlockSizeCount = 14;
 
 struct PhysicsBlock;
 struct PhysicsChunk;
+struct PhysicsBlockCache;
+
+struct PhysicsBlockAllocatorStats {
+  /// サイズクラスごとの使用中バイト数
+  std::array<int64_t, kBlockSizeCount> bytes_in_use{};
+  /// サイズクラスごとに確保済みのチャンクバイト数
+  std::array<int64_t, kBlockSizeCount> bytes_reserved{};
+  /// 共有プールから貸し出されたバイト数の最大値
+  int64_t high_water_bytes = 0;
+  /// ブロックサイズを超えるため malloc へ回したバイト数
+  int64_t large_bytes_in_use = 0;
+  int32_t chunk_count = 0;
+  int32_t thread_cache_count = 0;
+};
 
 class PhysicsBlockAllocator {
  public:
   PhysicsBlockAllocator();
   ~PhysicsBlockAllocator();
 
+  PhysicsBlockAllocator(const PhysicsBlockAllocator&) = delete;
+  PhysicsBlockAllocator& operator=(const PhysicsBlockAllocator&) = delete;
+
   void* Allocate(int32_t size);
 
   void Free(void* p, int32_t size);
 
+  /**
+   * \brief 呼び出したスレッドのキャッシュにあるブロックを共有プールへ返却します。
+   * ワーカースレッドの作業終了時に呼び出してください。
+   */
+  void FlushThreadCache();
+
+  /**
+   * \brief 全てのチャンクを解放します。
+   * 他のスレッドがこのアロケータを使用していない時に呼び出してください。
+   */
   void Clear();
 
+  [[nodiscard]] PhysicsBlockAllocatorStats GetStats() const;
+
 private:
+  PhysicsBlockCache* GetThreadCache();
+  void Refill(PhysicsBlockCache* cache, int32_t index);
+  void Drain(PhysicsBlockCache* cache, int32_t index, int32_t keep);
+  void AllocateChunk(int32_t index);
+
+  mutable std::mutex m_mutex;
+
   PhysicsChunk* m_chunks;
   int32_t m_chunkCount;
   int32_t m_chunkSpace;
 
   PhysicsBlock* m_freeLists[kBlockSizeCount];
+  int32_t m_freeCounts[kBlockSizeCount];
+
+  std::vector<std::unique_ptr<PhysicsBlockCache>> m_caches;
+  uint32_t m_id;
+
+  int64_t m_lentBytes = 0;
+  int64_t m_highWaterBytes = 0;
+  std::atomic<int64_t> m_largeBytes = 0;
 };
 }  // namespace base_engine::physics
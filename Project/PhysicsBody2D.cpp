@@ -134,6 +134,65 @@ void PhysicsBody::SetTransform(const PVec2& position, const float angle)
   m_world->new_contacts_ = true;
 }
 
+void PhysicsBody::SweepTransform(const PVec2& position, const float angle) {
+  m_flags &= ~e_toiFlag;
+
+  m_sweep.c0 = m_sweep.c;
+  m_sweep.a0 = m_sweep.a;
+  m_sweep.alpha0 = 0.0f;
+
+  m_xf.Set(position, angle);
+  m_sweep.c = PhysicsMul(m_xf, m_sweep.localCenter);
+  m_sweep.a = angle;
+
+  if (m_sweep.c0 == m_sweep.c && m_sweep.a0 == m_sweep.a) {
+    return;
+  }
+
+  SynchronizeFixtures();
+
+  // Check for new contacts the next step
+  m_world->new_contacts_ = true;
+}
+
+void PhysicsBody::SynchronizeFixtures() {
+  PhysicsTransform xf1;
+  xf1.q.Set(m_sweep.a0);
+  xf1.p = m_sweep.c0 - PhysicsMul(xf1.q, m_sweep.localCenter);
+
+  bp::BroadPhase* broadPhase = &m_world->contact_manager_.m_broadPhase;
+  for (PhysicsFixture* f = m_fixtureList; f; f = f->m_next) {
+    f->Synchronize(broadPhase, xf1, m_xf);
+  }
+}
+
+void PhysicsBody::SynchronizeTransform() {
+  m_xf.q.Set(m_sweep.a);
+  m_xf.p = m_sweep.c - PhysicsMul(m_xf.q, m_sweep.localCenter);
+}
+
+void PhysicsBody::Advance(const float t) {
+  // Advance to the new safe time. This doesn't sync the broad-phase.
+  m_sweep.Advance(t);
+  m_sweep.c = m_sweep.c0;
+  m_sweep.a = m_sweep.a0;
+  SynchronizeTransform();
+}
+
+void PhysicsBody::SetBullet(const bool flag) {
+  if (flag) {
+    m_flags |= e_bulletFlag;
+  } else {
+    m_flags &= ~e_bulletFlag;
+  }
+}
+
+bool PhysicsBody::IsBullet() const {
+  return (m_flags & e_bulletFlag) == e_bulletFlag;
+}
+
+PhysicsBodyType PhysicsBody::GetType() const { return m_type; }
+
 void PhysicsBody::SetEnabled(const bool flag) {
   if (flag) {
     m_flags |= e_enabledFlag;
@@ -80,6 +80,20 @@ class PhysicsBody {
   void DestroyFixture(PhysicsFixture* fixture);
 
   void SetTransform(const PVec2& position, float angle);
+
+  /**
+   * \brief 現在の姿勢からの移動としてボディを動かします。
+   * 移動前の姿勢はスイープの始点として残り、ブロードフェーズには移動経路全体を
+   * 覆う AABB が登録されるため、経路上の物体との接触が事前に生成されます。
+   * \param position 移動先の位置
+   * \param angle 移動先の角度
+   */
+  void SweepTransform(const PVec2& position, float angle);
+
+  /// 直前のステップで TOI によって移動が巻き戻されたか
+  [[nodiscard]] bool HasTimeOfImpact() const {
+    return (m_flags & e_toiFlag) == e_toiFlag;
+  }
   
   [[nodiscard]] const PhysicsTransform& GetTransform() const { return m_xf; }
 
@@ -14,6 +14,15 @@ void base_engine::PhysicsBodyComponent::Start() {
   if (collider.expired()) return;
   collider.lock()->SetPhysicsBody(this);
 }
+void base_engine::PhysicsBodyComponent::SetBullet(const bool flag) {
+  is_bullet_ = flag;
+  const auto collider = owner_->GetComponent<CollisionComponent>();
+  if (collider.expired()) return;
+  if (const auto body = collider.lock()->GetEnginePhysicsBody(); body) {
+    body->SetBullet(flag);
+  }
+}
+
 using enum base_engine::physics::BodyMotionType;
 void base_engine::PhysicsBodyComponent::OnCollision(
     const SendManifold& manifold) {
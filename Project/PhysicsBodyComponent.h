@@ -33,6 +33,7 @@ enum class BodyMotionType {
 class PhysicsBodyComponent final : public Component {
   physics::BodyMotionType motion_type_ = physics::BodyMotionType::kDynamic;
   Vector2 liner_velocity_;
+  bool is_bullet_ = false;
 
  public:
   PhysicsBodyComponent(Actor* owner,
@@ -52,6 +53,14 @@ class PhysicsBodyComponent final : public Component {
   void SetType(const physics::BodyMotionType type) {
     motion_type_ = type;
   }
+
+  /**
+   * \brief 高速に移動するボディとして扱うか設定します。
+   * 弾丸として扱われたボディは静的なボディだけでなく、
+   * 全てのボディに対して連続衝突判定を行います。
+   */
+  void SetBullet(bool flag);
+  bool IsBullet() const { return is_bullet_; }
   
   void Solver(physics::Manifold& manifold, const PhysicsBodyComponent* target_body);
 };
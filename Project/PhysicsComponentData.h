@@ -14,6 +14,16 @@ constexpr double kAABBExtension = 0.1 * kLengthUnitsPerMeter;
 
 constexpr float kAABBMultiplier = 4.0f;
 
+// TOI で許容する重なりの深さ。狭域判定で確実に接触として検出されるよう、
+// 接触直前ではなくわずかに食い込んだ位置で停止させる。
+constexpr float kLinearSlop = static_cast<float>(0.5 * kLengthUnitsPerMeter);
+
+constexpr int32_t kMaxTOIIterations = 20;
+
+// 弾丸でないボディは、1ステップの移動量が形状の最小半径のこの割合を
+// 超えた時だけ TOI を計算する。ゆっくり動くボディは離散判定で十分なため。
+constexpr float kCoreFraction = 0.25f;
+
 constexpr uint8_t kMaxPolygonVertices = 8;
 
 template <class Tag>
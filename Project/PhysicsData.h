@@ -23,5 +23,7 @@ using ContactSolverReferenceServiceTable =
 struct PhysicsData {
   ContactTesterReferenceServiceTable contact_tester_table;
   ContactSolverReferenceServiceTable contact_solver_table;
+  // サブステップ1回分の時間(秒)
+  float time_step = 1.0f / 60.0f;
 };
 }  // namespace base_engine::physics
@@ -0,0 +1,201 @@
+﻿#include "PhysicsTimeOfImpact.h"
+
+#include <limits>
+
+#include "PhysicsCircleShape.h"
+#include "PhysicsPolygonShape.h"
+
+namespace base_engine::physics {
+namespace {
+struct WorldPolygon {
+  PVec2 vertices[kMaxPolygonVertices];
+  PVec2 normals[kMaxPolygonVertices];
+  int32_t count;
+};
+
+WorldPolygon ToWorldPolygon(const PhysicsPolygonShape* polygon,
+                            const PhysicsTransform& xf) {
+  WorldPolygon result{};
+  result.count = polygon->m_count;
+  for (int32_t i = 0; i < polygon->m_count; ++i) {
+    result.vertices[i] = PhysicsMul(xf, polygon->m_vertices[i]);
+    result.normals[i] = PhysicsMul(xf.q, polygon->m_normals[i]);
+  }
+  return result;
+}
+
+float SegmentDistanceSquared(const PVec2& p, const PVec2& a, const PVec2& b) {
+  const PVec2 ab = b - a;
+  const float length_squared = ab.LengthSquared();
+  float t = 0.0f;
+  if (length_squared > std::numeric_limits<float>::epsilon()) {
+    t = PhysicsClamp(PhysicsDot(p - a, ab) / length_squared, 0.0f, 1.0f);
+  }
+  return PhysicsDistanceSquared(p, a + t * ab);
+}
+
+// 点と凸多角形の符号付き距離
+float PointPolygonDistance(const PVec2& p, const WorldPolygon& polygon) {
+  float separation = -std::numeric_limits<float>::max();
+  for (int32_t i = 0; i < polygon.count; ++i) {
+    separation = PhysicsMax(
+        separation, PhysicsDot(polygon.normals[i], p - polygon.vertices[i]));
+  }
+  if (separation <= 0.0f) {
+    return separation;
+  }
+
+  float distance_squared = std::numeric_limits<float>::max();
+  for (int32_t i = 0; i < polygon.count; ++i) {
+    const int32_t next = i + 1 < polygon.count ? i + 1 : 0;
+    distance_squared = PhysicsMin(
+        distance_squared,
+        SegmentDistanceSquared(p, polygon.vertices[i], polygon.vertices[next]));
+  }
+  return std::sqrt(distance_squared);
+}
+
+// poly1 の辺の法線で分離軸判定を行い、最大の分離距離を返す
+float FindMaxSeparation(const WorldPolygon& poly1, const WorldPolygon& poly2) {
+  float max_separation = -std::numeric_limits<float>::max();
+  for (int32_t i = 0; i < poly1.count; ++i) {
+    float si = std::numeric_limits<float>::max();
+    for (int32_t j = 0; j < poly2.count; ++j) {
+      si = PhysicsMin(si, PhysicsDot(poly1.normals[i],
+                                     poly2.vertices[j] - poly1.vertices[i]));
+    }
+    max_separation = PhysicsMax(max_separation, si);
+  }
+  return max_separation;
+}
+
+float PolygonPolygonDistance(const WorldPolygon& poly_a,
+                             const WorldPolygon& poly_b) {
+  const float separation =
+      PhysicsMax(FindMaxSeparation(poly_a, poly_b),
+                 FindMaxSeparation(poly_b, poly_a));
+  if (separation <= 0.0f) {
+    return separation;
+  }
+
+  // 分離している凸多角形の最近点は必ず一方の頂点ともう一方の辺の組になる
+  float distance = std::numeric_limits<float>::max();
+  for (int32_t i = 0; i < poly_a.count; ++i) {
+    distance = PhysicsMin(distance,
+                          PointPolygonDistance(poly_a.vertices[i], poly_b));
+  }
+  for (int32_t i = 0; i < poly_b.count; ++i) {
+    distance = PhysicsMin(distance,
+                          PointPolygonDistance(poly_b.vertices[i], poly_a));
+  }
+  return distance;
+}
+
+// 形状の原点から最も遠い点までの距離。回転による移動量の上限に使う
+float ComputeExtent(const PhysicsShape* shape, const PVec2& local_center) {
+  if (shape->GetType() == PhysicsShape::Type::kCircle) {
+    const auto circle = static_cast<const b2CircleShape*>(shape);
+    return (circle->m_p - local_center).Length() + circle->m_radius;
+  }
+  const auto polygon = static_cast<const PhysicsPolygonShape*>(shape);
+  float extent = 0.0f;
+  for (int32_t i = 0; i < polygon->m_count; ++i) {
+    extent =
+        PhysicsMax(extent, (polygon->m_vertices[i] - local_center).Length());
+  }
+  return extent;
+}
+}  // namespace
+
+float PhysicsShapeDistance(const PhysicsShape* shape_a,
+                           const PhysicsTransform& xf_a,
+                           const PhysicsShape* shape_b,
+                           const PhysicsTransform& xf_b) {
+  const bool circle_a = shape_a->GetType() == PhysicsShape::Type::kCircle;
+  const bool circle_b = shape_b->GetType() == PhysicsShape::Type::kCircle;
+
+  if (circle_a && circle_b) {
+    const auto a = static_cast<const b2CircleShape*>(shape_a);
+    const auto b = static_cast<const b2CircleShape*>(shape_b);
+    return PhysicsDistance(PhysicsMul(xf_a, a->m_p), PhysicsMul(xf_b, b->m_p)) -
+           a->m_radius - b->m_radius;
+  }
+
+  if (circle_a || circle_b) {
+    const auto circle = static_cast<const b2CircleShape*>(circle_a ? shape_a
+                                                                   : shape_b);
+    const auto polygon = static_cast<const PhysicsPolygonShape*>(
+        circle_a ? shape_b : shape_a);
+    const PhysicsTransform& xf_circle = circle_a ? xf_a : xf_b;
+    const PhysicsTransform& xf_polygon = circle_a ? xf_b : xf_a;
+    return PointPolygonDistance(PhysicsMul(xf_circle, circle->m_p),
+                                ToWorldPolygon(polygon, xf_polygon)) -
+           circle->m_radius;
+  }
+
+  return PolygonPolygonDistance(
+      ToWorldPolygon(static_cast<const PhysicsPolygonShape*>(shape_a), xf_a),
+      ToWorldPolygon(static_cast<const PhysicsPolygonShape*>(shape_b), xf_b));
+}
+
+void PhysicsTimeOfImpact(PhysicsTOIOutput* output,
+                         const PhysicsTOIInput* input) {
+  output->state = PhysicsTOIOutput::State::kUnknown;
+  output->t = input->t_max;
+
+  const b2Sweep& sweep_a = input->sweep_a;
+  const b2Sweep& sweep_b = input->sweep_b;
+
+  // 区間 [0,1] での相対移動量の上限。
+  // 符号付き距離はこの値を超えて変化しないので、(距離 / 上限) だけ進めても
+  // 接触を飛び越えることはない。
+  const PVec2 translation_a = sweep_a.c - sweep_a.c0;
+  const PVec2 translation_b = sweep_b.c - sweep_b.c0;
+  const float bound =
+      (translation_b - translation_a).Length() +
+      PhysicsAbs(sweep_a.a - sweep_a.a0) *
+          ComputeExtent(input->shape_a, sweep_a.localCenter) +
+      PhysicsAbs(sweep_b.a - sweep_b.a0) *
+          ComputeExtent(input->shape_b, sweep_b.localCenter);
+
+  const float target = -kLinearSlop;
+  const float tolerance = 0.25f * kLinearSlop;
+
+  float t = 0.0f;
+  for (int32_t iteration = 0; iteration < kMaxTOIIterations; ++iteration) {
+    PhysicsTransform xf_a, xf_b;
+    sweep_a.GetTransform(&xf_a, t);
+    sweep_b.GetTransform(&xf_b, t);
+
+    const float distance =
+        PhysicsShapeDistance(input->shape_a, xf_a, input->shape_b, xf_b);
+
+    if (distance < target - tolerance && iteration == 0) {
+      // 開始時点で既に重なっているので離散判定に任せる
+      output->state = PhysicsTOIOutput::State::kOverlapped;
+      output->t = 0.0f;
+      return;
+    }
+
+    if (distance <= target + tolerance) {
+      output->state = PhysicsTOIOutput::State::kTouching;
+      output->t = t;
+      return;
+    }
+
+    if (bound <= std::numeric_limits<float>::epsilon()) {
+      output->state = PhysicsTOIOutput::State::kSeparated;
+      return;
+    }
+
+    t += (distance - target) / bound;
+    if (t >= input->t_max) {
+      output->state = PhysicsTOIOutput::State::kSeparated;
+      return;
+    }
+  }
+
+  output->state = PhysicsTOIOutput::State::kFailed;
+  output->t = t;
+}
+}  // namespace base_engine::physics
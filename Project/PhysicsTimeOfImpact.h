@@ -0,0 +1,47 @@
+﻿// @PhysicsTimeOfImpact.h
+// @brief
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 保守的前進法(Conservative Advancement)による衝突時刻(TOI)の計算。
+
+#pragma once
+#include "PhysicsShapes.h"
+#include "PhysicsSweep.h"
+
+namespace base_engine::physics {
+struct PhysicsTOIInput {
+  const PhysicsShape* shape_a;
+  const PhysicsShape* shape_b;
+  b2Sweep sweep_a;
+  b2Sweep sweep_b;
+  /// 探索する区間 [0, t_max]
+  float t_max;
+};
+
+struct PhysicsTOIOutput {
+  enum class State { kUnknown, kFailed, kOverlapped, kTouching, kSeparated };
+
+  State state;
+  float t;
+};
+
+/**
+ * \brief 2つの形状の符号付き距離を求めます。
+ * 重なっている場合は最小の押し出し量を負の値で返します。
+ */
+float PhysicsShapeDistance(const PhysicsShape* shape_a,
+                           const PhysicsTransform& xf_a,
+                           const PhysicsShape* shape_b,
+                           const PhysicsTransform& xf_b);
+
+/**
+ * \brief 2つの形状がスイープ中に初めて接触する時刻を求めます。
+ * 接触位置は kLinearSlop だけ重なった状態になります。
+ * \param output 計算結果
+ * \param input スイープする形状
+ */
+void PhysicsTimeOfImpact(PhysicsTOIOutput* output,
+                         const PhysicsTOIInput* input);
+}  // namespace base_engine::physics
@@ -1,8 +1,12 @@
 ﻿#include "PhysicsWorld.h"
 
+#include <limits>
+#include <utility>
+
 #include "PhysicsBody2D.h"
 #include "PhysicsContact.h"
 #include "PhysicsFixture.h"
+#include "PhysicsTimeOfImpact.h"
 #include "PhysicsWorldCallBack.h"
 
 namespace base_engine::physics {
@@ -76,6 +80,79 @@ void PhysicsWorld::Step(float timeStep) {
     new_contacts_ = false;
   }
   { contact_manager_.Collide(); }
+
+  SolveTOI();
+}
+
+void PhysicsWorld::SolveTOI() {
+  toi_count_ = 0;
+  for (PhysicsBody* b = body_list_; b; b = b->m_next) {
+    if (b->m_type != PhysicsBodyType::kDynamicBody || !b->IsEnabled()) {
+      continue;
+    }
+
+    const b2Sweep& sweep = b->m_sweep;
+    if (sweep.c0 == sweep.c && sweep.a0 == sweep.a) {
+      continue;
+    }
+
+    if (!b->IsBullet()) {
+      float core_extent = std::numeric_limits<float>::max();
+      const PhysicsTransform identity({0.0f, 0.0f}, PRot(0.0f));
+      for (const PhysicsFixture* f = b->m_fixtureList; f; f = f->m_next) {
+        PhysicsAABB aabb;
+        f->GetShape()->ComputeAABB(&aabb, identity, 0);
+        const PVec2 extents = aabb.GetExtents();
+        core_extent = PhysicsMin(core_extent, PhysicsMin(extents.x, extents.y));
+      }
+      if ((sweep.c - sweep.c0).Length() <= kCoreFraction * core_extent) {
+        continue;
+      }
+    }
+
+    float min_alpha = 1.0f;
+    for (const ContactEdge* ce = b->m_contactList; ce; ce = ce->next) {
+      const PhysicsBody* other = ce->other;
+      if (!b->IsBullet() && other->m_type != PhysicsBodyType::kStaticBody) {
+        continue;
+      }
+
+      PhysicsContact* c = ce->contact;
+      const PhysicsFixture* fixture_a = c->GetFixtureA();
+      const PhysicsFixture* fixture_b = c->GetFixtureB();
+      if (fixture_a->IsSensor() || fixture_b->IsSensor()) {
+        continue;
+      }
+      if (fixture_a->GetBody() != b) {
+        std::swap(fixture_a, fixture_b);
+      }
+
+      // 相手は移動後の位置で止まっているものとして扱う
+      PhysicsTOIInput input;
+      input.shape_a = fixture_a->GetShape();
+      input.shape_b = fixture_b->GetShape();
+      input.sweep_a = sweep;
+      input.sweep_b = other->m_sweep;
+      input.sweep_b.c0 = input.sweep_b.c;
+      input.sweep_b.a0 = input.sweep_b.a;
+      input.t_max = min_alpha;
+
+      PhysicsTOIOutput output;
+      PhysicsTimeOfImpact(&output, &input);
+      if ((output.state == PhysicsTOIOutput::State::kTouching ||
+           output.state == PhysicsTOIOutput::State::kFailed) &&
+          output.t < min_alpha) {
+        min_alpha = output.t;
+      }
+    }
+
+    if (min_alpha < 1.0f) {
+      b->Advance(min_alpha);
+      b->SynchronizeFixtures();
+      b->m_flags |= PhysicsBody::e_toiFlag;
+      ++toi_count_;
+    }
+  }
 }
 
 struct b2WorldQueryWrapper {
@@ -62,6 +62,16 @@ class PhysicsWorld {
   void RayCast(PhysicsRayCastCallback* callback, const PVec2& point1,
                const PVec2& point2) const;
 
+  /// 直前のステップで TOI によって巻き戻されたボディの数
+  [[nodiscard]] int32_t GetTOICount() const { return toi_count_; }
+
+ private:
+  // 動的ボディを接触相手との衝突時刻まで巻き戻します。
+  // 全ての動的ボディは静的ボディに対して、弾丸フラグ付きのボディは
+  // 全てのボディに対して計算します。
+  void SolveTOI();
+
+ public:
   friend class PhysicsBody;
   PhysicsBlockAllocator block_allocator_;
   PhysicsContactManager contact_manager_;
@@ -70,5 +80,6 @@ class PhysicsWorld {
 
   PVec2 gravity_{};
   bool new_contacts_;
+  int32_t toi_count_ = 0;
 };
 }  // namespace base_engine::physics
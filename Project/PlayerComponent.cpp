@@ -1,10 +1,11 @@
-#include "PlayerComponent.h"
+﻿#include "PlayerComponent.h"
 
 #include <Mof.h>
 
 #include <fstream>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include "ActionToolTipComponent.h"
 #include "Actor.h"
@@ -164,7 +165,11 @@ void PlayerComponent::Start() {
   machine_.TransitionTo<PlayerIdle>();
 }
 
-void PlayerComponent::ProcessInput() { machine_.ProcessInput(); }
+void PlayerComponent::ProcessInput() {
+  machine_.ProcessInput();
+  // Update は1フレームに0回以上呼ばれるので押下はここで取る
+  if (g_pInput->IsKeyPush(MOFKEY_L)) goal_key_pushed_ = true;
+}
 
 void PlayerComponent::SetInput(const InputManager* input_manager) {
   input_manager_ = input_manager;
@@ -283,6 +288,7 @@ void PlayerComponent::MachineActionExecute() {
 }
 
 void PlayerComponent::Update() {
+  const bool goal_key_pushed = std::exchange(goal_key_pushed_, false);
   const auto aabb = collision_.lock()->AABB();
   sound_effect_->SetPosition({aabb.GetCenter().x, aabb.Bottom});
   physics_body_.lock()->AddForce({0, kGravity});
@@ -296,7 +302,7 @@ void PlayerComponent::Update() {
   CheckGround();
   MachineActionExecute();
 
-  if (g_pInput->IsKeyPush(MOFKEY_L)) {
+  if (goal_key_pushed) {
     auto a = std::any{1};
     GoalEvent goal{a};
     EventBus::FireEvent(goal);
@@ -121,6 +121,8 @@ namespace player {
 		bool is_ground_ = false;
 		bool can_control_ = true;
 		bool goal_event_ = false;
+		//! ŒXebvĂ1񂾂悤t[Pʂŕێ
+		bool goal_key_pushed_ = false;
 		SoundEffectActor* sound_effect_;
 		base_engine::AudioStreamComponent* audio_stream_ = nullptr;
 		std::vector<base_engine::Actor*> action_machine_buffer_{};
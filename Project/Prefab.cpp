@@ -3,15 +3,12 @@
 #include <yaml-cpp/yaml.h>
 
 #include <fstream>
+#include <type_traits>
 
 #include "AssetImporter.h"
-#include "BodyMask.h"
-#include "BoundingBox.h"
 #include "CSharpScriptEngine.h"
-#include "RigidBodyComponent.h"
+#include "ComponentRegistry.h"
 #include "SceneSerializer.h"
-#include "ShapeComponents.h"
-#include "VelocityComponent.h"
 
 namespace base_engine {
 Prefab::Prefab() { scene_ = Ref<Scene>::Create("Empty"); }
@@ -38,21 +35,16 @@ ObjectEntity Prefab::CreatePrefabFromEntity(ObjectEntity entity) {
   ObjectEntity new_entity = scene_->CreateEntity();
   new_entity.AddComponent<PrefabComponent>(
       handle_, new_entity.GetComponent<IdComponent>().uuid);
-  auto CopyComponentIfExistsFunc = [&entity, &new_entity,
-                                    this]<typename Component>() {
-    CopyComponentIfExists<Component>(new_entity, scene_->GetRegistry(), entity,
-                                     entity.GetScene()->GetRegistry());
-  };
-  
-  CopyComponentIfExistsFunc.operator()<TagComponent>();
-  CopyComponentIfExistsFunc.operator()<TransformComponent>();
-  CopyComponentIfExistsFunc.operator()<ScriptComponent>();
-  CopyComponentIfExistsFunc.operator()<SpriteRendererComponent>();
-  CopyComponentIfExistsFunc.operator()<physics::RigidBodyComponent>();
-  CopyComponentIfExistsFunc.operator()<physics::VelocityComponent>();
-  CopyComponentIfExistsFunc.operator()<physics::BodyMask>();
-  CopyComponentIfExistsFunc.operator()<physics::Circle>();
-  CopyComponentIfExistsFunc.operator()<physics::BoundingBox>();
+  // PrefabComponent と親子関係はプレハブ側で設定し直すのでコピーしない
+  CopyableComponents::ForEach([&entity, &new_entity,
+                               this]<typename Component>() {
+    if constexpr (!std::is_same_v<Component, PrefabComponent> &&
+                  !std::is_same_v<Component, HierarchyComponent>) {
+      CopyComponentIfExists<Component>(new_entity, scene_->GetRegistry(),
+                                       entity,
+                                       entity.GetScene()->GetRegistry());
+    }
+  });
   for (const auto child_id : entity.Children()) {
     ObjectEntity child_duplicate =
         CreatePrefabFromEntity(entity.GetScene()->GetEntityWithUUID(child_id));
@@ -95,6 +87,41 @@ bool PrefabSerializer::TryLoadData(const AssetMetadata& metadata,
   return true;
 }
 
+bool PrefabSerializer::TryLoadDataFromMemory(
+    const AssetMetadata& metadata, const std::span<const std::byte> data,
+    Ref<Asset>& asset) const {
+  const std::string yaml_string(reinterpret_cast<const char*>(data.data()),
+                                data.size());
+
+  const auto prefab = Ref<Prefab>::Create();
+  if (!DeserializeFromYAML(yaml_string, prefab)) return false;
+
+  asset = prefab;
+  asset->handle_ = metadata.handle;
+  return true;
+}
+
+bool PrefabSerializer::TryGetDependencies(
+    const AssetMetadata& metadata,
+    std::vector<AssetHandle>& dependencies) const {
+  const std::ifstream stream(metadata.file_path);
+  if (!stream.is_open()) return false;
+
+  std::stringstream str_stream;
+  str_stream << stream.rdbuf();
+
+  const YAML::Node data = YAML::Load(str_stream.str());
+  if (!data["Prefab"]) return false;
+  SceneSerializer::CollectDependencies(data["Prefab"], dependencies);
+  return true;
+}
+
+void PrefabSerializer::GetDependencies(
+    const Ref<Asset>& asset, std::vector<AssetHandle>& dependencies) const {
+  SceneSerializer::CollectDependencies(asset.As<Prefab>()->scene_,
+                                       dependencies);
+}
+
 void PrefabSerializer::GetRecognizedExtensions(
     std::list<std::string>* extensions) const {
   extensions->emplace_back(".prefab");
@@ -29,13 +29,22 @@ class Prefab : public Asset {
   friend class Scene;
 };
 
-class PrefabSerializer : public AssetSerializer {
+class PrefabSerializer : public AssetSerializer,
+                         public MemoryAssetSerializer,
+                         public DependencyAssetSerializer {
  public:
   void Serialize(const AssetMetadata& metadata,
                  const Ref<Asset>& asset) const override;
 
   bool TryLoadData(const AssetMetadata& metadata,
                    Ref<Asset>& asset) const override;
+  bool TryLoadDataFromMemory(const AssetMetadata& metadata,
+                             std::span<const std::byte> data,
+                             Ref<Asset>& asset) const override;
+  bool TryGetDependencies(const AssetMetadata& metadata,
+                          std::vector<AssetHandle>& dependencies) const override;
+  void GetDependencies(const Ref<Asset>& asset,
+                       std::vector<AssetHandle>& dependencies) const override;
 
   void GetRecognizedExtensions(
       std::list<std::string>* extensions) const override;
@@ -0,0 +1,38 @@
+﻿#include "RecordingRenderBackend.h"
+
+namespace base_engine {
+void RecordingRenderBackend::Execute(const RenderCommand& command) {
+  if (commands_.empty() || commands_.back().texture != command.texture ||
+      commands_.back().material != command.material) {
+    ++state_change_count_;
+  }
+  commands_.emplace_back(command);
+}
+
+uint32_t RecordingRenderBackend::ExecuteBatch(const RenderBatch& batch,
+                                              const RenderCommand* commands) {
+  auto& recorded = batches_.emplace_back(batch);
+  recorded.first = static_cast<uint32_t>(commands_.size());
+  for (uint32_t i = 0; i < batch.count; ++i) {
+    Execute(commands[i]);
+  }
+  return 1;
+}
+
+bool RecordingRenderBackend::BeginCachedLayer(
+    [[maybe_unused]] RenderLayerCacheTarget& target) {
+  return true;
+}
+
+void RecordingRenderBackend::EndCachedLayer(
+    const RenderLayerCacheTarget& target) {
+  cached_layers_.emplace_back(target);
+}
+
+void RecordingRenderBackend::Clear() {
+  commands_.clear();
+  batches_.clear();
+  cached_layers_.clear();
+  state_change_count_ = 0;
+}
+}  // namespace base_engine
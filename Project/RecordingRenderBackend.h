@@ -0,0 +1,57 @@
+﻿// @RecordingRenderBackend.h
+// @brief 描画せずにコマンドを記録するバックエンド
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// グラフィックスデバイスのない環境で、ソートやバッチングの結果を確認するために使う。
+
+#pragma once
+#include <vector>
+
+#include "RenderCommandBuffer.h"
+
+namespace base_engine {
+class RecordingRenderBackend final : public IRenderCommandBackend {
+ public:
+  void Execute(const RenderCommand& command) override;
+
+  /**
+   * \brief バッチを記録し、インスタンス描画1回として数えます。
+   */
+  uint32_t ExecuteBatch(const RenderBatch& batch,
+                        const RenderCommand* commands) override;
+
+  /**
+   * \brief キャッシュしたレイヤーの描き直しと合成を記録します。
+   * 描き直したときは、キャッシュの座標に移したコマンドが記録されます。
+   */
+  bool BeginCachedLayer(RenderLayerCacheTarget& target) override;
+  void EndCachedLayer(const RenderLayerCacheTarget& target) override;
+
+  void Clear();
+
+  [[nodiscard]] const std::vector<RenderCommand>& GetCommands() const {
+    return commands_;
+  }
+  [[nodiscard]] const std::vector<RenderBatch>& GetBatches() const {
+    return batches_;
+  }
+
+  [[nodiscard]] const std::vector<RenderLayerCacheTarget>& GetCachedLayers()
+      const {
+    return cached_layers_;
+  }
+
+  /// テクスチャかマテリアルが直前のコマンドから切り替わった回数
+  [[nodiscard]] size_t GetStateChangeCount() const {
+    return state_change_count_;
+  }
+
+ private:
+  std::vector<RenderCommand> commands_;
+  std::vector<RenderBatch> batches_;
+  std::vector<RenderLayerCacheTarget> cached_layers_;
+  size_t state_change_count_ = 0;
+};
+}  // namespace base_engine
@@ -0,0 +1,94 @@
+﻿// @RenderCommand.h
+// @brief 描画コマンドとソートキー
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 描画APIの呼び出しを1フレーム分のコマンドとして記録するためのデータ。
+// グラフィックスライブラリに依存しないので、ヘッドレス環境でも扱える。
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace base_engine {
+class Material;
+
+enum class RenderCommandType : uint8_t {
+  kTexture,
+  kTextureTransform,
+  kTextureMaterial,
+  kLine,
+  kRect,
+  kRectFrame,
+  kCircle,
+  kCircleFrame,
+};
+
+/**
+ * \brief 64bitのソートキー
+ * 上位から レイヤー(8bit) 描画順(16bit)。残りのビットは使わない。
+ * 半透明のスプライトは重なり順が見た目に出るので、テクスチャでは並べ替えず、
+ * 同じキーのコマンドは追加した順番に描く(ソートが安定なので追加順が最下位になる)
+ */
+struct RenderSortKey {
+  static constexpr int kReservedBits = 40;
+  static constexpr int kDrawOrderBits = 16;
+  static constexpr int kLayerBits = 8;
+
+  static constexpr int kDrawOrderShift = kReservedBits;
+  static constexpr int kLayerShift = kDrawOrderShift + kDrawOrderBits;
+
+  static constexpr int32_t kMinDrawOrder = INT16_MIN;
+  static constexpr int32_t kMaxDrawOrder = INT16_MAX;
+
+  [[nodiscard]] static uint64_t Make(uint8_t layer, int32_t draw_order);
+
+  [[nodiscard]] static uint8_t GetLayer(const uint64_t key) {
+    return static_cast<uint8_t>(key >> kLayerShift);
+  }
+  [[nodiscard]] static int32_t GetDrawOrder(const uint64_t key) {
+    return static_cast<int32_t>((key >> kDrawOrderShift) &
+                                ((1ull << kDrawOrderBits) - 1)) +
+           kMinDrawOrder;
+  }
+};
+
+struct RenderCommand {
+  uint64_t sort_key = 0;
+  RenderCommandType type = RenderCommandType::kTexture;
+  int32_t alignment = 0;
+  uint32_t color = 0;
+  // バックエンド固有のテクスチャ
+  const void* texture = nullptr;
+  const Material* material = nullptr;
+  // kTextureTransform の RenderTransform の番号
+  uint32_t payload = 0;
+  float angle = 0;
+  // kTexture : 座標xy 拡縮xy / kLine : 始点xy 終点xy
+  // kRect : 左上右下 / kCircle : 中心xy 半径
+  float values[4]{};
+  float uv[4]{};
+};
+
+/**
+ * \brief kTextureTransform の行列とピボット
+ */
+struct RenderTransform {
+  float matrix[4][4];
+  float pivot[3];
+};
+
+/**
+ * \brief ソート後に同じテクスチャ、マテリアル、種類が連続するコマンドのまとまり
+ * 描く順番は変えないので、間に別のテクスチャを挟んだコマンドはまとめない
+ * ソート済みのコマンド配列の [first, first + count) をインスタンスの配列として扱う
+ */
+struct RenderBatch {
+  RenderCommandType type = RenderCommandType::kTexture;
+  const void* texture = nullptr;
+  const Material* material = nullptr;
+  uint32_t first = 0;
+  uint32_t count = 0;
+};
+}  // namespace base_engine
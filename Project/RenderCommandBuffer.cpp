@@ -0,0 +1,282 @@
+﻿#include "RenderCommandBuffer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+
+#include "RenderStatsCapture.h"
+
+namespace base_engine {
+namespace {
+constexpr size_t kInitialCommandCapacity = 1024;
+constexpr int kRadixBits = 8;
+constexpr size_t kRadixSize = 1 << kRadixBits;
+
+uint32_t GetVertexCount(const RenderCommandType type) {
+  switch (type) {
+    case RenderCommandType::kTexture:
+    case RenderCommandType::kTextureTransform:
+    case RenderCommandType::kTextureMaterial:
+    case RenderCommandType::kRect:
+    case RenderCommandType::kRectFrame:
+      return 4;
+    case RenderCommandType::kLine:
+      return 2;
+    default:
+      return 0;
+  }
+}
+
+// 塗りつぶす面積(ピクセル)。線と枠は 0 とする
+float GetCoveredArea(const RenderCommand& command,
+                     const RenderCommandList& list) {
+  const float uv_width = std::abs(command.uv[2] - command.uv[0]);
+  const float uv_height = std::abs(command.uv[3] - command.uv[1]);
+  const float* v = command.values;
+  switch (command.type) {
+    case RenderCommandType::kTexture:
+      return uv_width * uv_height * std::abs(v[2] * v[3]);
+    case RenderCommandType::kTextureTransform: {
+      // 2x2 部分の行列式が面積の拡大率になる
+      const auto& m = list.GetTransform(command.payload).matrix;
+      return uv_width * uv_height *
+             std::abs(m[0][0] * m[1][1] - m[0][1] * m[1][0]);
+    }
+    case RenderCommandType::kRect:
+      return std::abs((v[2] - v[0]) * (v[3] - v[1]));
+    case RenderCommandType::kCircle:
+      return std::numbers::pi_v<float> * v[2] * v[2];
+    default:
+      return 0.0f;
+  }
+}
+
+bool CanBatch(const RenderCommand& a, const RenderCommand& b) {
+  return a.type == b.type && a.texture == b.texture &&
+         a.material == b.material;
+}
+}  // namespace
+
+uint64_t RenderSortKey::Make(const uint8_t layer, const int32_t draw_order) {
+  const auto order = static_cast<uint64_t>(
+      std::clamp(draw_order, kMinDrawOrder, kMaxDrawOrder) - kMinDrawOrder);
+  return static_cast<uint64_t>(layer) << kLayerShift |
+         order << kDrawOrderShift;
+}
+
+RenderCommandBuffer::RenderCommandBuffer() {
+  list_.Reserve(kInitialCommandCapacity);
+}
+
+void RenderCommandBuffer::SetSortOrder(const uint8_t layer,
+                                       const int32_t draw_order) {
+  list_.SetSortOrder(layer, draw_order);
+}
+
+RenderCommand& RenderCommandBuffer::Add(const RenderCommandType type,
+                                        const void* texture,
+                                        const Material* material) {
+  return list_.Add(type, texture, material);
+}
+
+RenderCommand& RenderCommandBuffer::AddTexture(
+    const void* texture, const RenderTransform& transform,
+    const float (&uv)[4], const uint32_t color) {
+  return list_.AddTexture(texture, transform, uv, color);
+}
+
+void RenderCommandBuffer::BeginCommandList(RenderCommandList& list) const {
+  list.Clear();
+  list.SetSortOrder(list_.layer_, list_.draw_order_);
+  list.SetViewOffset(list_.view_offset_[0], list_.view_offset_[1]);
+}
+
+void RenderCommandBuffer::Append(const RenderCommandList& list) {
+  const auto transform_base = static_cast<uint32_t>(list_.transforms_.size());
+  list_.transforms_.insert(list_.transforms_.end(), list.transforms_.begin(),
+                           list.transforms_.end());
+  const size_t command_base = list_.commands_.size();
+  list_.commands_.insert(list_.commands_.end(), list.commands_.begin(),
+                         list.commands_.end());
+  for (size_t i = command_base; i < list_.commands_.size(); ++i) {
+    if (auto& command = list_.commands_[i];
+        command.type == RenderCommandType::kTextureTransform) {
+      command.payload += transform_base;
+    }
+  }
+}
+
+void RenderCommandBuffer::Sort() {
+  auto& commands = list_.commands_;
+  const size_t count = commands.size();
+  if (count < 2) return;
+
+  entries_.resize(count);
+  sort_work_.resize(count);
+  uint64_t all_or = 0;
+  uint64_t all_and = ~0ull;
+  for (size_t i = 0; i < count; ++i) {
+    entries_[i] = {commands[i].sort_key, static_cast<uint32_t>(i)};
+    all_or |= commands[i].sort_key;
+    all_and &= commands[i].sort_key;
+  }
+
+  // LSD 基数ソート。全コマンドで同じ値の桁は飛ばす
+  const uint64_t varying = all_or ^ all_and;
+  for (int shift = 0; shift < 64; shift += kRadixBits) {
+    if (((varying >> shift) & (kRadixSize - 1)) == 0) continue;
+
+    std::array<size_t, kRadixSize> offsets{};
+    for (const auto& entry : entries_) {
+      ++offsets[(entry.key >> shift) & (kRadixSize - 1)];
+    }
+    size_t total = 0;
+    for (auto& offset : offsets) {
+      const size_t bucket = offset;
+      offset = total;
+      total += bucket;
+    }
+    for (const auto& entry : entries_) {
+      sort_work_[offsets[(entry.key >> shift) & (kRadixSize - 1)]++] = entry;
+    }
+    entries_.swap(sort_work_);
+  }
+
+  sorted_.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    sorted_[i] = commands[entries_[i].index];
+  }
+  commands.swap(sorted_);
+}
+
+void RenderCommandBuffer::Flush(IRenderCommandBackend& backend) {
+  Sort();
+  const auto& commands = list_.commands_;
+  const auto count = static_cast<uint32_t>(commands.size());
+  uint32_t first = 0;
+  while (first < count) {
+    // レイヤーはソートキーの最上位なので、同じレイヤーのコマンドは連続している
+    const uint8_t layer = RenderSortKey::GetLayer(commands[first].sort_key);
+    uint32_t last = first + 1;
+    while (last < count &&
+           RenderSortKey::GetLayer(commands[last].sort_key) == layer) {
+      ++last;
+    }
+    if (layer_cache_.IsCached(layer)) {
+      ExecuteCachedLayer(backend, layer, first, last);
+    } else {
+      ExecuteBatches(backend, first, last);
+    }
+    first = last;
+  }
+  Clear();
+}
+
+void RenderCommandBuffer::ExecuteBatches(IRenderCommandBackend& backend,
+                                         uint32_t first, const uint32_t last) {
+  const auto& commands = list_.commands_;
+  while (first < last) {
+    const RenderCommand& head = commands[first];
+    uint32_t batch_last = first + 1;
+    while (batch_last < last && CanBatch(head, commands[batch_last])) {
+      ++batch_last;
+    }
+
+    const RenderBatch batch{head.type, head.texture, head.material, first,
+                            batch_last - first};
+    RenderGroupStats batch_stats;
+    batch_stats.command_count = batch.count;
+    batch_stats.batch_count = 1;
+    batch_stats.draw_call_count =
+        backend.ExecuteBatch(batch, &commands[first]);
+    batch_stats.vertex_count = GetVertexCount(head.type) * batch.count;
+    if (head.texture && head.texture != bound_texture_) {
+      batch_stats.texture_bind_count = 1;
+      bound_texture_ = head.texture;
+    }
+    if (head.material != bound_material_) {
+      batch_stats.material_bind_count = 1;
+      bound_material_ = head.material;
+    }
+    for (uint32_t i = first; i < batch_last; ++i) {
+      batch_stats.covered_area += GetCoveredArea(commands[i], list_);
+    }
+    stats_.Add(RenderSortKey::GetLayer(head.sort_key), head.material,
+               batch_stats);
+    first = batch_last;
+  }
+}
+
+void RenderCommandBuffer::ExecuteCachedLayer(IRenderCommandBackend& backend,
+                                             const uint8_t layer,
+                                             const uint32_t first,
+                                             const uint32_t last) {
+  auto& commands = list_.commands_;
+  auto target = layer_cache_.Prepare(
+      layer, &commands[first], last - first, list_, list_.view_offset_[0],
+      list_.view_offset_[1], stats_.target_width, stats_.target_height);
+  if (!backend.BeginCachedLayer(target)) {
+    layer_cache_.Invalidate(layer);
+    ExecuteBatches(backend, first, last);
+    return;
+  }
+
+  if (target.rebuild) {
+    // バッファはこの後空にするので、コマンドをそのままキャッシュの座標に移す
+    for (uint32_t i = first; i < last; ++i) {
+      auto& command = commands[i];
+      RenderLayerCache::Translate(
+          command,
+          command.type == RenderCommandType::kTextureTransform
+              ? &list_.transforms_[command.payload]
+              : nullptr,
+          target.translate[0], target.translate[1]);
+    }
+    ExecuteBatches(backend, first, last);
+    ++stats_.cached_layer_rebuild_count;
+  } else {
+    RenderGroupStats reuse_stats;
+    reuse_stats.command_count = last - first;
+    stats_.Add(layer, nullptr, reuse_stats);
+    ++stats_.cached_layer_reuse_count;
+  }
+  backend.EndCachedLayer(target);
+
+  // 合成は描画先全体へのテクスチャ1枚として数える
+  RenderGroupStats composite_stats;
+  composite_stats.draw_call_count = 1;
+  composite_stats.vertex_count = 4;
+  composite_stats.texture_bind_count = 1;
+  composite_stats.covered_area = stats_.target_width * stats_.target_height;
+  stats_.Add(layer, nullptr, composite_stats);
+  bound_texture_ = nullptr;
+  bound_material_ = nullptr;
+}
+
+void RenderCommandBuffer::BeginFrame() {
+  const float target_width = stats_.target_width;
+  const float target_height = stats_.target_height;
+  last_stats_ = std::move(stats_);
+  stats_ = {};
+  if (stats_capture_ && has_frame_ && stats_capture_->IsOpen()) {
+    stats_capture_->Record(last_stats_);
+  }
+  has_frame_ = true;
+  SetTargetSize(target_width, target_height);
+  bound_texture_ = nullptr;
+  bound_material_ = nullptr;
+}
+
+void RenderCommandBuffer::SetTargetSize(const float width, const float height) {
+  stats_.target_width = width;
+  stats_.target_height = height;
+}
+
+void RenderCommandBuffer::GetLayerCacheRect(float (&rect)[4]) const {
+  layer_cache_.GetCacheRect(list_.view_offset_[0], list_.view_offset_[1],
+                            stats_.target_width, stats_.target_height, rect);
+}
+
+void RenderCommandBuffer::Clear() { list_.Clear(); }
+}  // namespace base_engine
@@ -0,0 +1,211 @@
+﻿// @RenderCommandBuffer.h
+// @brief 1フレーム分の描画コマンドを溜めてソートする
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include <vector>
+
+#include "RenderCommand.h"
+#include "RenderCommandList.h"
+#include "RenderLayerCache.h"
+#include "RenderStats.h"
+
+namespace base_engine {
+class RenderStatsCapture;
+
+/**
+ * \brief ソート済みの描画コマンドを実際に描画するバックエンド
+ */
+class IRenderCommandBackend {
+ public:
+  virtual ~IRenderCommandBackend() = default;
+  virtual void Execute(const RenderCommand& command) = 0;
+
+  /**
+   * \brief バッチをまとめて描画します。
+   * 既定ではコマンドを1つずつ Execute します。
+   * \param batch 描画するバッチ
+   * \param commands バッチに含まれるコマンドの先頭
+   * \return 発行した描画の数
+   */
+  virtual uint32_t ExecuteBatch(const RenderBatch& batch,
+                                const RenderCommand* commands) {
+    for (uint32_t i = 0; i < batch.count; ++i) {
+      Execute(commands[i]);
+    }
+    return batch.count;
+  }
+
+  /**
+   * \brief キャッシュしたレイヤーの描画を始めます。
+   * target.rebuild が true なら描画先をキャッシュに切り替えて消去します。
+   * キャッシュを作り直したときは target.rebuild を true にします。
+   * \return キャッシュに対応していなければ false。レイヤーは通常どおり描画されます
+   */
+  virtual bool BeginCachedLayer(
+      [[maybe_unused]] RenderLayerCacheTarget& target) {
+    return false;
+  }
+
+  /**
+   * \brief 描画先を戻し、キャッシュを target.offset の位置に合成します。
+   */
+  virtual void EndCachedLayer(
+      [[maybe_unused]] const RenderLayerCacheTarget& target) {}
+};
+
+class RenderCommandBuffer {
+ public:
+  RenderCommandBuffer();
+
+  /**
+   * \brief 以降に追加するコマンドのレイヤーと描画順を設定します。
+   * 描画順は -32768 から 32767 の範囲に丸められます。
+   */
+  void SetSortOrder(uint8_t layer, int32_t draw_order);
+  [[nodiscard]] uint8_t GetLayer() const { return list_.GetLayer(); }
+  [[nodiscard]] int32_t GetDrawOrder() const { return list_.GetDrawOrder(); }
+
+  /**
+   * \brief コマンドを追加し、現在のレイヤーと描画順からソートキーを設定します。
+   * \return 追加したコマンド
+   */
+  RenderCommand& Add(RenderCommandType type, const void* texture = nullptr,
+                     const Material* material = nullptr);
+
+  /**
+   * \brief ワールド座標から描画先の座標へのずれ(カメラ)を設定します。
+   */
+  void SetViewOffset(float x, float y) { list_.SetViewOffset(x, y); }
+
+  /**
+   * \brief 行列で配置するテクスチャを追加します。
+   * \param transform ワールド行列とピボット
+   */
+  RenderCommand& AddTexture(const void* texture,
+                            const RenderTransform& transform,
+                            const float (&uv)[4], uint32_t color);
+
+  /**
+   * \brief 別スレッドで作ったコマンド列を追加します。
+   * 各コマンドのソートキーは list で設定したものが使われます。
+   */
+  void Append(const RenderCommandList& list);
+
+  /**
+   * \brief 並列に作るコマンド列を、現在のビューと描画順で初期化します。
+   */
+  void BeginCommandList(RenderCommandList& list) const;
+
+  [[nodiscard]] const RenderTransform& GetTransform(
+      const uint32_t index) const {
+    return list_.GetTransform(index);
+  }
+
+  /**
+   * \brief コマンドをソートキー順に並べ替えます。
+   * 同じキーのコマンドは追加した順番を保ちます。
+   */
+  void Sort();
+
+  /**
+   * \brief ソートしてから連続するコマンドをバッチにまとめ、backend で実行します。
+   * 実行後はバッファを空にします。
+   */
+  void Flush(IRenderCommandBackend& backend);
+
+  /**
+   * \brief フレームの区切り。現在の統計を前フレームの統計として保存します。
+   * キャプチャが設定されていれば、前フレームの統計を書き出します。
+   */
+  void BeginFrame();
+
+  /**
+   * \brief BeginFrame ごとに統計を書き出す先を設定します。nullptr で解除します。
+   * バックエンドに依存しないので、RecordingRenderBackend でも記録できます。
+   */
+  void SetStatsCapture(RenderStatsCapture* capture) {
+    stats_capture_ = capture;
+  }
+
+  /**
+   * \brief 描画先の大きさを設定します。オーバードローの計算に使います。
+   */
+  void SetTargetSize(float width, float height);
+
+  /**
+   * \brief レイヤーの描画結果をキャッシュするか設定します。
+   * キャッシュしたレイヤーは、コマンドの内容かカメラのバケットが変わったときだけ描き直します。
+   */
+  void SetLayerCached(const uint8_t layer, const bool cached) {
+    layer_cache_.SetCached(layer, cached);
+  }
+  [[nodiscard]] bool IsLayerCached(const uint8_t layer) const {
+    return layer_cache_.IsCached(layer);
+  }
+  /**
+   * \brief テクスチャの中身を書き換えたときなど、コマンドに現れない変更を反映します。
+   */
+  void InvalidateLayerCache(const uint8_t layer) {
+    layer_cache_.Invalidate(layer);
+  }
+  [[nodiscard]] RenderLayerCache& GetLayerCache() { return layer_cache_; }
+  [[nodiscard]] const RenderLayerCache& GetLayerCache() const {
+    return layer_cache_;
+  }
+
+  /**
+   * \brief キャッシュしたレイヤーが覆うワールド座標の範囲を求めます。
+   */
+  void GetLayerCacheRect(float (&rect)[4]) const;
+
+  /// 直前に完了したフレームの統計
+  [[nodiscard]] const RenderFrameStats& GetFrameStats() const {
+    return last_stats_;
+  }
+
+  void Clear();
+
+  [[nodiscard]] size_t GetCommandCount() const {
+    return list_.GetCommandCount();
+  }
+  [[nodiscard]] const std::vector<RenderCommand>& GetCommands() const {
+    return list_.GetCommands();
+  }
+
+ private:
+  /**
+   * \brief [first, last) のコマンドをバッチにまとめて実行し、統計に加えます。
+   */
+  void ExecuteBatches(IRenderCommandBackend& backend, uint32_t first,
+                      uint32_t last);
+
+  /**
+   * \brief キャッシュするレイヤー1つ分のコマンドを、必要ならキャッシュに描き直して合成します。
+   */
+  void ExecuteCachedLayer(IRenderCommandBackend& backend, uint8_t layer,
+                          uint32_t first, uint32_t last);
+
+  struct SortEntry {
+    uint64_t key;
+    uint32_t index;
+  };
+
+  RenderCommandList list_;
+  std::vector<SortEntry> entries_;
+  std::vector<SortEntry> sort_work_;
+  std::vector<RenderCommand> sorted_;
+  RenderFrameStats stats_;
+  RenderFrameStats last_stats_;
+  // フレーム内で最後に使ったテクスチャとマテリアル。Flush をまたいで切り替えを数える
+  const void* bound_texture_ = nullptr;
+  const Material* bound_material_ = nullptr;
+  RenderLayerCache layer_cache_;
+  RenderStatsCapture* stats_capture_ = nullptr;
+  // 最初の BeginFrame では、まだ完了したフレームがない
+  bool has_frame_ = false;
+};
+}  // namespace base_engine
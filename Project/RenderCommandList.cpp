@@ -0,0 +1,71 @@
+﻿#include "RenderCommandList.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace base_engine {
+void RenderCommandList::SetSortOrder(const uint8_t layer,
+                                     const int32_t draw_order) {
+  layer_ = layer;
+  draw_order_ = std::clamp(draw_order, RenderSortKey::kMinDrawOrder,
+                           RenderSortKey::kMaxDrawOrder);
+}
+
+void RenderCommandList::SetViewOffset(const float x, const float y) {
+  view_offset_[0] = x;
+  view_offset_[1] = y;
+}
+
+RenderCommand& RenderCommandList::Add(const RenderCommandType type,
+                                      const void* texture,
+                                      const Material* material) {
+  auto& command = commands_.emplace_back();
+  command.type = type;
+  command.texture = texture;
+  command.material = material;
+  command.sort_key = RenderSortKey::Make(layer_, draw_order_);
+  return command;
+}
+
+RenderCommand& RenderCommandList::AddTexture(const void* texture,
+                                             const RenderTransform& transform,
+                                             const float (&uv)[4],
+                                             const uint32_t color) {
+  auto& command = Add(RenderCommandType::kTextureTransform, texture);
+  command.payload = static_cast<uint32_t>(transforms_.size());
+  std::copy_n(uv, 4, command.uv);
+  command.color = color;
+
+  // アフィン行列の右から平行移動を掛けるのと同じ
+  auto& view_transform = transforms_.emplace_back(transform);
+  view_transform.matrix[3][0] += view_offset_[0];
+  view_transform.matrix[3][1] += view_offset_[1];
+  return command;
+}
+
+RenderCommand& RenderCommandList::AddTexture(
+    const void* texture, const float x, const float y, const float scale_x,
+    const float scale_y, const float angle, const float (&uv)[4],
+    const uint32_t color, const int32_t alignment) {
+  auto& command = Add(RenderCommandType::kTexture, texture);
+  command.values[0] = std::round(x + view_offset_[0]);
+  command.values[1] = std::round(y + view_offset_[1]);
+  command.values[2] = scale_x;
+  command.values[3] = scale_y;
+  command.angle = angle;
+  std::copy_n(uv, 4, command.uv);
+  command.color = color;
+  command.alignment = alignment;
+  return command;
+}
+
+void RenderCommandList::Reserve(const size_t count) {
+  commands_.reserve(count);
+  transforms_.reserve(count);
+}
+
+void RenderCommandList::Clear() {
+  commands_.clear();
+  transforms_.clear();
+}
+}  // namespace base_engine
@@ -0,0 +1,78 @@
+﻿// @RenderCommandList.h
+// @brief ソート前の描画コマンドの列
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// ワーカースレッドごとに1つずつ用意して並列にコマンドを作り、
+// 描画スレッドで RenderCommandBuffer にまとめる。
+
+#pragma once
+#include <vector>
+
+#include "RenderCommand.h"
+
+namespace base_engine {
+class RenderCommandList {
+  friend class RenderCommandBuffer;
+
+ public:
+  /**
+   * \brief 以降に追加するコマンドのレイヤーと描画順を設定します。
+   * 描画順は -32768 から 32767 の範囲に丸められます。
+   */
+  void SetSortOrder(uint8_t layer, int32_t draw_order);
+  [[nodiscard]] uint8_t GetLayer() const { return layer_; }
+  [[nodiscard]] int32_t GetDrawOrder() const { return draw_order_; }
+
+  /**
+   * \brief ワールド座標から描画先の座標へのずれ(カメラ)を設定します。
+   * AddTexture で追加する行列に加算されます。
+   */
+  void SetViewOffset(float x, float y);
+
+  /**
+   * \brief コマンドを追加し、現在のレイヤーと描画順からソートキーを設定します。
+   * \return 追加したコマンド
+   */
+  RenderCommand& Add(RenderCommandType type, const void* texture = nullptr,
+                     const Material* material = nullptr);
+
+  /**
+   * \brief 行列で配置するテクスチャを追加します。
+   * \param transform ワールド行列とピボット。ビューのずれはこの関数で加算されます
+   */
+  RenderCommand& AddTexture(const void* texture,
+                            const RenderTransform& transform,
+                            const float (&uv)[4], uint32_t color);
+
+  /**
+   * \brief 座標と拡縮で配置するテクスチャを追加します。
+   * \param x, y ワールド座標。ビューのずれはこの関数で加算されます
+   * \param alignment バックエンドの配置の指定
+   */
+  RenderCommand& AddTexture(const void* texture, float x, float y,
+                            float scale_x, float scale_y, float angle,
+                            const float (&uv)[4], uint32_t color,
+                            int32_t alignment);
+
+  void Reserve(size_t count);
+  void Clear();
+
+  [[nodiscard]] size_t GetCommandCount() const { return commands_.size(); }
+  [[nodiscard]] const std::vector<RenderCommand>& GetCommands() const {
+    return commands_;
+  }
+  [[nodiscard]] const RenderTransform& GetTransform(
+      const uint32_t index) const {
+    return transforms_[index];
+  }
+
+ private:
+  std::vector<RenderCommand> commands_;
+  std::vector<RenderTransform> transforms_;
+  uint8_t layer_ = 0;
+  int32_t draw_order_ = 0;
+  float view_offset_[2]{};
+};
+}  // namespace base_engine
@@ -0,0 +1,174 @@
+﻿#include "RenderLayerCache.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+#include "RenderCommandList.h"
+
+namespace base_engine {
+namespace {
+void HashCombine(uint64_t& hash, const uint64_t value) {
+  hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+}
+
+void HashFloat(uint64_t& hash, const float value) {
+  HashCombine(hash, std::bit_cast<uint32_t>(value));
+}
+
+// 座標は 1 ピクセル未満の差を同じ内容とみなす。
+// カメラの小数部分で描画先の座標が丸められても描き直さないようにする
+void HashPosition(uint64_t& hash, const float value) {
+  HashCombine(hash, static_cast<uint64_t>(std::llround(value)));
+}
+
+// splitmix64 の仕上げ
+uint64_t Mix(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+int64_t GetBucket(const float view_offset, const float bucket_size) {
+  // 描画先の左上に映るワールド座標を含むバケット
+  return static_cast<int64_t>(std::floor(-view_offset / bucket_size));
+}
+
+int GetPositionCount(const RenderCommandType type) {
+  switch (type) {
+    case RenderCommandType::kLine:
+    case RenderCommandType::kRect:
+    case RenderCommandType::kRectFrame:
+      return 4;
+    case RenderCommandType::kTextureTransform:
+      return 0;
+    default:
+      return 2;
+  }
+}
+}  // namespace
+
+void RenderLayerCache::SetCached(const uint8_t layer, const bool cached) {
+  cached_[layer] = cached;
+  if (!cached) Invalidate(layer);
+}
+
+void RenderLayerCache::SetBucketSize(const float size) {
+  bucket_size_ = std::max(size, 1.0f);
+  InvalidateAll();
+}
+
+void RenderLayerCache::Invalidate(const uint8_t layer) {
+  entries_[layer].valid = false;
+}
+
+void RenderLayerCache::InvalidateAll() {
+  for (auto& entry : entries_) {
+    entry.valid = false;
+  }
+}
+
+RenderLayerCacheTarget RenderLayerCache::Prepare(
+    const uint8_t layer, const RenderCommand* commands, const uint32_t count,
+    const RenderCommandList& list, const float view_offset_x,
+    const float view_offset_y, const float target_width,
+    const float target_height) {
+  const int64_t bucket_x = GetBucket(view_offset_x, bucket_size_);
+  const int64_t bucket_y = GetBucket(view_offset_y, bucket_size_);
+  const float origin_x = static_cast<float>(bucket_x) * bucket_size_;
+  const float origin_y = static_cast<float>(bucket_y) * bucket_size_;
+
+  RenderLayerCacheTarget target;
+  target.layer = layer;
+  target.width = static_cast<uint32_t>(std::ceil(target_width + bucket_size_));
+  target.height =
+      static_cast<uint32_t>(std::ceil(target_height + bucket_size_));
+  target.translate[0] = -(view_offset_x + origin_x);
+  target.translate[1] = -(view_offset_y + origin_y);
+  target.offset[0] = -target.translate[0];
+  target.offset[1] = -target.translate[1];
+
+  // キャッシュの座標に移した内容で比べる。カメラだけが動いたときは同じになる。
+  // 同じソートキーのコマンドは追加順が空間インデックスの検索順で変わるため、
+  // コマンドごとのハッシュを足し合わせて順番に依存しないようにする
+  uint64_t hash = Mix(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    RenderCommand command = commands[i];
+    RenderTransform transform{};
+    const bool has_transform =
+        command.type == RenderCommandType::kTextureTransform;
+    if (has_transform) transform = list.GetTransform(command.payload);
+    Translate(command, has_transform ? &transform : nullptr,
+              target.translate[0], target.translate[1]);
+
+    uint64_t command_hash = 0;
+    HashCombine(command_hash, static_cast<uint64_t>(command.type));
+    HashCombine(command_hash, static_cast<uint64_t>(command.alignment));
+    HashCombine(command_hash, command.color);
+    HashCombine(command_hash, reinterpret_cast<uintptr_t>(command.texture));
+    HashCombine(command_hash, reinterpret_cast<uintptr_t>(command.material));
+    HashFloat(command_hash, command.angle);
+    const int position_count = GetPositionCount(command.type);
+    for (int j = 0; j < 4; ++j) {
+      if (j < position_count) {
+        HashPosition(command_hash, command.values[j]);
+      } else {
+        HashFloat(command_hash, command.values[j]);
+      }
+      HashFloat(command_hash, command.uv[j]);
+    }
+    if (has_transform) {
+      for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+          if (row == 3 && column < 2) {
+            HashPosition(command_hash, transform.matrix[row][column]);
+          } else {
+            HashFloat(command_hash, transform.matrix[row][column]);
+          }
+        }
+      }
+      for (const float pivot : transform.pivot) {
+        HashFloat(command_hash, pivot);
+      }
+    }
+    hash += Mix(command_hash);
+  }
+
+  auto& entry = entries_[layer];
+  target.rebuild = !entry.valid || entry.hash != hash ||
+                   entry.bucket_x != bucket_x || entry.bucket_y != bucket_y ||
+                   entry.width != target.width || entry.height != target.height;
+  entry = {hash, bucket_x, bucket_y, target.width, target.height, true};
+  return target;
+}
+
+void RenderLayerCache::GetCacheRect(const float view_offset_x,
+                                    const float view_offset_y,
+                                    const float target_width,
+                                    const float target_height,
+                                    float (&rect)[4]) const {
+  rect[0] = static_cast<float>(GetBucket(view_offset_x, bucket_size_)) *
+            bucket_size_;
+  rect[1] = static_cast<float>(GetBucket(view_offset_y, bucket_size_)) *
+            bucket_size_;
+  rect[2] = rect[0] + target_width + bucket_size_;
+  rect[3] = rect[1] + target_height + bucket_size_;
+}
+
+void RenderLayerCache::Translate(RenderCommand& command,
+                                 RenderTransform* transform, const float x,
+                                 const float y) {
+  if (command.type == RenderCommandType::kTextureTransform) {
+    if (transform) {
+      transform->matrix[3][0] += x;
+      transform->matrix[3][1] += y;
+    }
+    return;
+  }
+  const int position_count = GetPositionCount(command.type);
+  for (int i = 0; i < position_count; i += 2) {
+    command.values[i] += x;
+    command.values[i + 1] += y;
+  }
+}
+}  // namespace base_engine
@@ -0,0 +1,103 @@
+﻿// @RenderLayerCache.h
+// @brief 静的なレイヤーの描画結果を使い回すための判定
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// キャッシュするレイヤーは、カメラ位置をバケット単位に丸めた原点から
+// 描画先よりバケット1つ分大きい範囲を別の描画先に描いておき、毎フレームそれを合成する。
+// レイヤーのコマンドの内容かバケットが変わったときだけ描き直す。
+// グラフィックスライブラリに依存しないので、ヘッドレス環境で判定を確認できる。
+
+#pragma once
+#include <array>
+#include <bitset>
+
+#include "RenderCommand.h"
+
+namespace base_engine {
+class RenderCommandList;
+
+/**
+ * \brief キャッシュしたレイヤーの描画先と合成位置
+ */
+struct RenderLayerCacheTarget {
+  uint8_t layer = 0;
+  // キャッシュの描画先の大きさ
+  uint32_t width = 0;
+  uint32_t height = 0;
+  // true なら描き直す。バックエンドが描画先を作り直したときも true にする
+  bool rebuild = false;
+  // 描画先の座標からキャッシュの座標へのずれ
+  float translate[2]{};
+  // キャッシュを合成する描画先の座標
+  float offset[2]{};
+};
+
+class RenderLayerCache {
+ public:
+  static constexpr float kDefaultBucketSize = 256.0f;
+
+  /**
+   * \brief レイヤーをキャッシュするか設定します。外したレイヤーの内容は破棄されます。
+   */
+  void SetCached(uint8_t layer, bool cached);
+  [[nodiscard]] bool IsCached(const uint8_t layer) const {
+    return cached_[layer];
+  }
+  [[nodiscard]] bool HasCachedLayer() const { return cached_.any(); }
+
+  /**
+   * \brief カメラ位置を丸める単位を設定します。全てのキャッシュを破棄します。
+   * 大きいほど描き直しは減りますが、キャッシュの描画先が大きくなります。
+   */
+  void SetBucketSize(float size);
+  [[nodiscard]] float GetBucketSize() const { return bucket_size_; }
+
+  void Invalidate(uint8_t layer);
+  void InvalidateAll();
+
+  /**
+   * \brief レイヤーのコマンドからキャッシュを描き直すか判定し、状態を更新します。
+   * \param commands ソート済みのレイヤーのコマンドの先頭
+   * \param count コマンドの数
+   * \param list kTextureTransform の行列を持つコマンド列
+   * \param view_offset_x, view_offset_y ワールド座標から描画先の座標へのずれ
+   * \param target_width, target_height 描画先の大きさ
+   */
+  RenderLayerCacheTarget Prepare(uint8_t layer, const RenderCommand* commands,
+                                 uint32_t count, const RenderCommandList& list,
+                                 float view_offset_x, float view_offset_y,
+                                 float target_width, float target_height);
+
+  /**
+   * \brief キャッシュが覆うワールド座標の範囲を求めます。
+   * キャッシュするレイヤーのカリングはこの範囲で行うと、
+   * バケットが変わるまでコマンドの内容が変わりません。
+   */
+  void GetCacheRect(float view_offset_x, float view_offset_y,
+                    float target_width, float target_height,
+                    float (&rect)[4]) const;
+
+  /**
+   * \brief コマンドの座標を平行移動します。
+   * \param transform kTextureTransform の場合の行列。それ以外は nullptr でよい
+   */
+  static void Translate(RenderCommand& command, RenderTransform* transform,
+                        float x, float y);
+
+ private:
+  struct Entry {
+    uint64_t hash = 0;
+    int64_t bucket_x = 0;
+    int64_t bucket_y = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    bool valid = false;
+  };
+
+  std::array<Entry, 256> entries_{};
+  std::bitset<256> cached_;
+  float bucket_size_ = kDefaultBucketSize;
+};
+}  // namespace base_engine
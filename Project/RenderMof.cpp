@@ -6,6 +6,7 @@
 #include "GameWindow.h"
 #include "Material.h"
 #include "MofShader.h"
+#include "Profiler.h"
 using Mof::CGraphicsUtilities;
 namespace base_engine {
 void RenderMof::Initialize() {
@@ -16,6 +17,21 @@ void RenderMof::Initialize() {
                                BUFFERACCESS_GPUREADWRITE);
   target_texture_2.CreateTarget(sw, sh, PIXELFORMAT_R8G8B8A8_UNORM,
                                BUFFERACCESS_GPUREADWRITE);
+
+  // 色は通常どおり混ぜるとアルファを掛けた値になる。アルファは掛けずに重ねる
+  D3D11_RENDER_TARGET_BLEND_DESC blend{};
+  blend.BlendEnable = TRUE;
+  blend.SrcBlend = D3D11_BLEND_SRC_ALPHA;
+  blend.DestBlend = D3D11_BLEND_INV_SRC_ALPHA;
+  blend.BlendOp = D3D11_BLEND_OP_ADD;
+  blend.SrcBlendAlpha = D3D11_BLEND_ONE;
+  blend.DestBlendAlpha = D3D11_BLEND_INV_SRC_ALPHA;
+  blend.BlendOpAlpha = D3D11_BLEND_OP_ADD;
+  blend.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+  layer_blend_state_ = CreateBlendState(blend);
+  // キャッシュの色は既にアルファを掛けてあるので、そのまま足す
+  blend.SrcBlend = D3D11_BLEND_ONE;
+  layer_composite_blend_state_ = CreateBlendState(blend);
 }
 
 RenderMof::RenderMof() {}
@@ -24,69 +40,90 @@ void RenderMof::AddTexture(const ITexturePtr texture, const Vector& position,
                            const Vector& scale, float angle, const Rect& uv,
                            const Color& color,
                            Mof::TextureAlignment alignment) {
-  CGraphicsUtilities::RenderScaleRotateTexture(
-      roundf(position.x + camera_center_position_.x),
-      roundf(position.y + camera_center_position_.y), scale.x, scale.y, angle,
-      uv, color, alignment, texture);
+  auto& command = command_buffer_.Add(RenderCommandType::kTexture, texture);
+  command.values[0] = roundf(position.x + camera_center_position_.x);
+  command.values[1] = roundf(position.y + camera_center_position_.y);
+  command.values[2] = scale.x;
+  command.values[3] = scale.y;
+  command.angle = angle;
+  command.uv[0] = uv.Left;
+  command.uv[1] = uv.Top;
+  command.uv[2] = uv.Right;
+  command.uv[3] = uv.Bottom;
+  command.color = color;
+  command.alignment = alignment;
 }
 
 void RenderMof::AddTexture(ITexturePtr texture, const Matrix44& wMat,
                            const Rect& uv, const Color& color,
                            const Vector3& pivot) {
-  CMatrix44 camera_mat;
-  camera_mat.SetTranslation(camera_center_position_.x,
-                            camera_center_position_.y, 0);
-  CGraphicsUtilities::RenderTexture(wMat * camera_mat, uv, color, pivot,
-                                    texture);
+  RenderTransform transform;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      transform.matrix[i][j] = wMat.rc[i][j];
+    }
+  }
+  transform.pivot[0] = pivot.x;
+  transform.pivot[1] = pivot.y;
+  transform.pivot[2] = pivot.z;
+  command_buffer_.AddTexture(texture, transform,
+                             {uv.Left, uv.Top, uv.Right, uv.Bottom}, color);
 }
 
 void RenderMof::AddTexture(ITexturePtr texture, const Vector& position,
                            const Vector& scale, float angle, const Rect& uv,
                            const Color& color, Mof::TextureAlignment alignment,
                            const Material& material) {
-  const auto shader =
-      std::dynamic_pointer_cast<MofShader>(material.GetShader());
-  CGraphicsUtilities::RenderTexture(
-      roundf(position.x + camera_center_position_.x),
-      roundf(position.y + camera_center_position_.y), color, alignment, texture,
-      shader->GetShader(), shader->GetShaderBind());
+  auto& command = command_buffer_.Add(RenderCommandType::kTextureMaterial,
+                                      texture, &material);
+  command.values[0] = roundf(position.x + camera_center_position_.x);
+  command.values[1] = roundf(position.y + camera_center_position_.y);
+  command.color = color;
+  command.alignment = alignment;
 }
 
 void RenderMof::AddLine(const Vector& position1, const Vector& position2,
                         const Color& color) {
-  CGraphicsUtilities::RenderLine(position1.x + camera_center_position_.x,
-                                 position1.y + camera_center_position_.y,
-                                 position2.x + camera_center_position_.x,
-                                 position2.y + camera_center_position_.y,
-                                 color);
+  auto& command = command_buffer_.Add(RenderCommandType::kLine);
+  command.values[0] = position1.x + camera_center_position_.x;
+  command.values[1] = position1.y + camera_center_position_.y;
+  command.values[2] = position2.x + camera_center_position_.x;
+  command.values[3] = position2.y + camera_center_position_.y;
+  command.color = color;
 }
 
 void RenderMof::AddRect(const Rect& rect, const Color& color) {
-  CGraphicsUtilities::RenderFillRect(rect.Left + camera_center_position_.x,
-                                     rect.Top + camera_center_position_.y,
-                                     rect.Right + camera_center_position_.x,
-                                     rect.Bottom + camera_center_position_.y,
-                                     color);
+  auto& command = command_buffer_.Add(RenderCommandType::kRect);
+  command.values[0] = rect.Left + camera_center_position_.x;
+  command.values[1] = rect.Top + camera_center_position_.y;
+  command.values[2] = rect.Right + camera_center_position_.x;
+  command.values[3] = rect.Bottom + camera_center_position_.y;
+  command.color = color;
 }
 
 void RenderMof::AddRectFrame(const Rect& rect, const Color& color) {
-  CGraphicsUtilities::RenderRect(rect.Left + camera_center_position_.x,
-                                 rect.Top + camera_center_position_.y,
-                                 rect.Right + camera_center_position_.x,
-                                 rect.Bottom + camera_center_position_.y,
-                                 color);
+  auto& command = command_buffer_.Add(RenderCommandType::kRectFrame);
+  command.values[0] = rect.Left + camera_center_position_.x;
+  command.values[1] = rect.Top + camera_center_position_.y;
+  command.values[2] = rect.Right + camera_center_position_.x;
+  command.values[3] = rect.Bottom + camera_center_position_.y;
+  command.color = color;
 }
 
 void RenderMof::AddCircle(const Circle& circle, const Color& color) {
-  CGraphicsUtilities::RenderFillCircle(
-      circle.Position.x + camera_center_position_.x,
-      circle.Position.y + camera_center_position_.y, circle.r, color);
+  auto& command = command_buffer_.Add(RenderCommandType::kCircle);
+  command.values[0] = circle.Position.x + camera_center_position_.x;
+  command.values[1] = circle.Position.y + camera_center_position_.y;
+  command.values[2] = circle.r;
+  command.color = color;
 }
 
 void RenderMof::AddCircleFrame(const Circle& circle, const Color& color) {
-  CGraphicsUtilities::RenderCircle(
-      circle.Position.x + camera_center_position_.x,
-      circle.Position.y + camera_center_position_.y, circle.r, color);
+  auto& command = command_buffer_.Add(RenderCommandType::kCircleFrame);
+  command.values[0] = circle.Position.x + camera_center_position_.x;
+  command.values[1] = circle.Position.y + camera_center_position_.y;
+  command.values[2] = circle.r;
+  command.color = color;
 }
 
 void RenderMof::SetCameraPosition(const Vector& position) {
@@ -95,25 +132,44 @@ void RenderMof::SetCameraPosition(const Vector& position) {
   camera_center_position_ = {
       graphics->GetTargetWidth() / static_cast<float>(2) - camera_position_.x,
       graphics->GetTargetHeight() / static_cast<float>(2) - camera_position_.y};
+  command_buffer_.SetViewOffset(camera_center_position_.x,
+                                camera_center_position_.y);
 }
 
 void RenderMof::SetMaterial(const std::shared_ptr<Material>& material) {
   camera_material_ = material;
 }
 
+void RenderMof::SetSortOrder(const uint8_t layer, const int32_t draw_order) {
+  command_buffer_.SetSortOrder(layer, draw_order);
+}
+
+void RenderMof::BeginCommandList(RenderCommandList& list) {
+  command_buffer_.BeginCommandList(list);
+}
+
+void RenderMof::Submit(const RenderCommandList& list) {
+  command_buffer_.Append(list);
+}
+
 void RenderMof::Begin() {
   MofU32 sw = window::kWidth * 0.75f;
   MofU32 sh = window::kHeight * 0.75f;
+  command_buffer_.BeginFrame();
   hold_render_target_buffer_ = g_pGraphics->GetRenderTarget();
   g_pGraphics->ClearTarget(0.2f, 0.2f, 0.6f, 0.0f, 0.0f, 0);
 
   g_pGraphics->SetRenderTarget(target_texture_.GetRenderTarget(),
                                g_pGraphics->GetDepthTarget());
+  command_buffer_.SetTargetSize(
+      static_cast<float>(g_pGraphics->GetTargetWidth()),
+      static_cast<float>(g_pGraphics->GetTargetHeight()));
 
   CGraphicsUtilities::RenderFillRect(0, 0, 1920, 1080, MOF_COLOR_HBLACK);
 }
 
 void RenderMof::End() {
+  Flush();
   g_pGraphics->SetRenderTarget(hold_render_target_buffer_,
                                g_pGraphics->GetDepthTarget());
 
@@ -124,15 +180,162 @@ IBaseEngineRender::Vector RenderMof::GetCameraPosition() {
   return camera_position_;
 }
 
+IBaseEngineRender::Rect RenderMof::GetViewRect() {
+  const auto& graphics = CGraphicsUtilities::GetGraphics();
+  const float left = -camera_center_position_.x;
+  const float top = -camera_center_position_.y;
+  return {left, top, left + graphics->GetTargetWidth(),
+          top + graphics->GetTargetHeight()};
+}
+
 IBaseEngineRender::ITexturePtr RenderMof::GetTargetTexture() {
   return &target_texture_;
 }
 
+void RenderMof::SetLayerCached(const uint8_t layer, const bool cached) {
+  command_buffer_.SetLayerCached(layer, cached);
+  if (!cached) layer_targets_[layer].reset();
+}
+
+bool RenderMof::IsLayerCached(const uint8_t layer) const {
+  return command_buffer_.IsLayerCached(layer);
+}
+
+void RenderMof::InvalidateLayerCache(const uint8_t layer) {
+  command_buffer_.InvalidateLayerCache(layer);
+}
+
+void RenderMof::InvalidateLayerCaches() {
+  command_buffer_.GetLayerCache().InvalidateAll();
+}
+
+IBaseEngineRender::Rect RenderMof::GetLayerCacheRect() {
+  float rect[4];
+  command_buffer_.GetLayerCacheRect(rect);
+  return {rect[0], rect[1], rect[2], rect[3]};
+}
+
+const RenderFrameStats& RenderMof::GetFrameStats() const {
+  return command_buffer_.GetFrameStats();
+}
+
+bool RenderMof::StartStatsCapture(const std::filesystem::path& path,
+                                  const RenderStatsCaptureFormat format) {
+  if (!stats_capture_.Open(path, format)) return false;
+  command_buffer_.SetStatsCapture(&stats_capture_);
+  return true;
+}
+
+void RenderMof::StopStatsCapture() {
+  command_buffer_.SetStatsCapture(nullptr);
+  stats_capture_.Close();
+}
+
+const RenderStatsCapture& RenderMof::GetStatsCapture() const {
+  return stats_capture_;
+}
+
 void RenderMof::Next() {
+  Flush();
   g_pGraphics->SetRenderTarget(target_texture_2.GetRenderTarget(),
                                g_pGraphics->GetDepthTarget());
 
   CGraphicsUtilities::RenderTexture(0, 0, &target_texture_);
 
 }
+
+void RenderMof::Execute(const RenderCommand& command) {
+  // Mof のテクスチャは const を受け付けないため外す
+  const auto texture =
+      static_cast<ITexturePtr>(const_cast<void*>(command.texture));
+  const auto& v = command.values;
+  const Rect uv{command.uv[0], command.uv[1], command.uv[2], command.uv[3]};
+  const auto alignment =
+      static_cast<Mof::TextureAlignment>(command.alignment);
+  switch (command.type) {
+    case RenderCommandType::kTexture:
+      CGraphicsUtilities::RenderScaleRotateTexture(v[0], v[1], v[2], v[3],
+                                                   command.angle, uv,
+                                                   command.color, alignment,
+                                                   texture);
+      break;
+    case RenderCommandType::kTextureTransform: {
+      const auto& transform = command_buffer_.GetTransform(command.payload);
+      CMatrix44 matrix;
+      for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+          matrix.rc[i][j] = transform.matrix[i][j];
+        }
+      }
+      const Vector3 pivot{transform.pivot[0], transform.pivot[1],
+                          transform.pivot[2]};
+      CGraphicsUtilities::RenderTexture(matrix, uv, command.color, pivot,
+                                        texture);
+    } break;
+    case RenderCommandType::kTextureMaterial: {
+      const auto shader =
+          std::dynamic_pointer_cast<MofShader>(command.material->GetShader());
+      CGraphicsUtilities::RenderTexture(v[0], v[1], command.color, alignment,
+                                        texture, shader->GetShader(),
+                                        shader->GetShaderBind());
+    } break;
+    case RenderCommandType::kLine:
+      CGraphicsUtilities::RenderLine(v[0], v[1], v[2], v[3], command.color);
+      break;
+    case RenderCommandType::kRect:
+      CGraphicsUtilities::RenderFillRect(v[0], v[1], v[2], v[3],
+                                         command.color);
+      break;
+    case RenderCommandType::kRectFrame:
+      CGraphicsUtilities::RenderRect(v[0], v[1], v[2], v[3], command.color);
+      break;
+    case RenderCommandType::kCircle:
+      CGraphicsUtilities::RenderFillCircle(v[0], v[1], v[2], command.color);
+      break;
+    case RenderCommandType::kCircleFrame:
+      CGraphicsUtilities::RenderCircle(v[0], v[1], v[2], command.color);
+      break;
+  }
+}
+
+bool RenderMof::BeginCachedLayer(RenderLayerCacheTarget& target) {
+  if (!layer_blend_state_ || !layer_composite_blend_state_) return false;
+  auto& cache = layer_targets_[target.layer];
+  if (!cache || cache->GetWidth() != target.width ||
+      cache->GetHeight() != target.height) {
+    cache = std::make_unique<Mof::CTexture>();
+    if (!cache->CreateTarget(target.width, target.height,
+                             PIXELFORMAT_R8G8B8A8_UNORM,
+                             BUFFERACCESS_GPUREADWRITE)) {
+      cache.reset();
+      return false;
+    }
+    target.rebuild = true;
+  }
+  if (!target.rebuild) return true;
+
+  hold_layer_render_target_ = g_pGraphics->GetRenderTarget();
+  g_pGraphics->SetRenderTarget(cache->GetRenderTarget(),
+                               g_pGraphics->GetDepthTarget());
+  g_pGraphics->ClearTarget(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0);
+  layer_blend_scope_.emplace(layer_blend_state_.Get());
+  return true;
+}
+
+void RenderMof::EndCachedLayer(const RenderLayerCacheTarget& target) {
+  if (target.rebuild) {
+    layer_blend_scope_.reset();
+    g_pGraphics->SetRenderTarget(hold_layer_render_target_,
+                                 g_pGraphics->GetDepthTarget());
+  }
+  const ScopedBlendState composite(layer_composite_blend_state_.Get());
+  CGraphicsUtilities::RenderTexture(roundf(target.offset[0]),
+                                    roundf(target.offset[1]),
+                                    layer_targets_[target.layer].get());
+}
+
+void RenderMof::Flush() {
+  BE_PROFILE_FUNC("RenderFlush");
+  command_buffer_.Flush(*this);
+}
 }  // namespace base_engine
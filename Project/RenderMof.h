@@ -2,15 +2,33 @@
 
 #include <Graphics/DirectX11/DX11Texture.h>
 
+#include <array>
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "IBaseEngineRender.h"
+#include "MofBlendState.h"
+#include "RenderCommandBuffer.h"
 namespace base_engine {
-class RenderMof final : public IBaseEngineRender {
+class RenderMof final : public IBaseEngineRender,
+                        public IRenderCommandBackend {
   Vector camera_position_{0,0};
   Vector camera_center_position_{0,0};
   std::shared_ptr<Material> camera_material_;
   Mof::CTexture target_texture_;
   Mof::CTexture target_texture_2;
   Mof::LPRenderTarget hold_render_target_buffer_ = nullptr;
+
+  RenderCommandBuffer command_buffer_;
+  RenderStatsCapture stats_capture_;
+  // キャッシュするレイヤーごとの描画先
+  std::array<std::unique_ptr<Mof::CTexture>, 256> layer_targets_;
+  Mof::LPRenderTarget hold_layer_render_target_ = nullptr;
+  // キャッシュには乗算済みアルファで描き、合成も乗算済みアルファで行う
+  BlendStatePtr layer_blend_state_;
+  BlendStatePtr layer_composite_blend_state_;
+  std::optional<ScopedBlendState> layer_blend_scope_;
  public:
   void Initialize() override;
   RenderMof();
@@ -31,14 +49,36 @@ class RenderMof final : public IBaseEngineRender {
   void AddCircleFrame(const Circle& circle, const Color& color) override;
   void SetCameraPosition(const Vector& position) override;
   void SetMaterial(const std::shared_ptr<Material>& material) override;
+  void SetSortOrder(uint8_t layer, int32_t draw_order) override;
+  void BeginCommandList(RenderCommandList& list) override;
+  void Submit(const RenderCommandList& list) override;
   void Begin() override;
 
   void End() override;
 
   Vector GetCameraPosition() override;
+  Rect GetViewRect() override;
+  void SetLayerCached(uint8_t layer, bool cached) override;
+  bool IsLayerCached(uint8_t layer) const override;
+  void InvalidateLayerCache(uint8_t layer) override;
+  void InvalidateLayerCaches() override;
+  Rect GetLayerCacheRect() override;
   ITexturePtr GetTargetTexture() override;
+  const RenderFrameStats& GetFrameStats() const override;
+  bool StartStatsCapture(const std::filesystem::path& path,
+                         RenderStatsCaptureFormat format) override;
+  void StopStatsCapture() override;
+  const RenderStatsCapture& GetStatsCapture() const override;
   void Next() override;
 
+  void Execute(const RenderCommand& command) override;
+  bool BeginCachedLayer(RenderLayerCacheTarget& target) override;
+  void EndCachedLayer(const RenderLayerCacheTarget& target) override;
+
 private:
+  /**
+   * \brief 溜めた描画コマンドをソートして現在の描画先に描画する
+   */
+  void Flush();
 };
 }  // namespace base_engine
\ No newline at end of file
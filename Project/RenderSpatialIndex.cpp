@@ -0,0 +1,44 @@
+﻿#include "RenderSpatialIndex.h"
+
+namespace base_engine {
+void RenderSpatialIndex::BeginUpdate() { ++frame_; }
+
+void RenderSpatialIndex::Update(const uint32_t key,
+                                const physics::PhysicsAABB& aabb,
+                                const uint32_t slot) {
+  auto& entry = entries_[key];
+  entry.slot = slot;
+  entry.frame = frame_;
+  if (entry.proxy_id == physics::kNullNode) {
+    entry.proxy_id = tree_.CreateProxy(aabb, &entry);
+    return;
+  }
+  tree_.MoveProxy(entry.proxy_id, aabb, {0.0f, 0.0f});
+}
+
+bool RenderSpatialIndex::Keep(const uint32_t key, const uint32_t slot) {
+  const auto it = entries_.find(key);
+  if (it == entries_.end()) return false;
+  it->second.slot = slot;
+  it->second.frame = frame_;
+  return true;
+}
+
+void RenderSpatialIndex::EndUpdate() {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.frame != frame_) {
+      tree_.DestroyProxy(it->second.proxy_id);
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void RenderSpatialIndex::Clear() {
+  for (const auto& [key, entry] : entries_) {
+    tree_.DestroyProxy(entry.proxy_id);
+  }
+  entries_.clear();
+}
+}  // namespace base_engine
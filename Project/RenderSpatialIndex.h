@@ -0,0 +1,84 @@
+﻿// @RenderSpatialIndex.h
+// @brief 描画用の空間インデックス
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// スプライトの境界矩形を b2DynamicTree に登録し、カメラの表示範囲で検索する。
+
+#pragma once
+#include <type_traits>
+#include <unordered_map>
+
+#include "PhysicsDynamicTree.h"
+
+namespace base_engine {
+struct RenderCullingStats {
+  uint32_t visible_count = 0;
+  uint32_t culled_count = 0;
+};
+
+class RenderSpatialIndex {
+ public:
+  /**
+   * \brief 登録の更新を開始します。
+   * 次の EndUpdate までに Update されなかった要素は削除されます。
+   */
+  void BeginUpdate();
+
+  /**
+   * \brief 要素の境界矩形を登録、更新します。
+   * \param key 要素を識別する値
+   * \param aabb ワールド座標の境界矩形
+   * \param slot 検索で返す値。毎回変わってもよい
+   */
+  void Update(uint32_t key, const physics::PhysicsAABB& aabb, uint32_t slot);
+
+  /**
+   * \brief 境界矩形が変わっていない要素を、ツリーを更新せずに残します。
+   * \param key 要素を識別する値
+   * \param slot 検索で返す値
+   * \return 要素が登録されていなければ false
+   */
+  bool Keep(uint32_t key, uint32_t slot);
+
+  void EndUpdate();
+
+  /**
+   * \brief 範囲と重なる要素の slot を callback に渡します。
+   */
+  template <class Callback>
+  void Query(const physics::PhysicsAABB& aabb, Callback&& callback) const {
+    struct Wrapper {
+      bool QueryCallback(const int32_t proxy_id) const {
+        const auto entry = static_cast<const Entry*>(tree->GetUserData(proxy_id));
+        (*callback)(entry->slot);
+        return true;
+      }
+      const physics::b2DynamicTree* tree;
+      std::remove_reference_t<Callback>* callback;
+    };
+    Wrapper wrapper{&tree_, &callback};
+    tree_.Query(&wrapper, aabb);
+  }
+
+  void Clear();
+
+  [[nodiscard]] size_t GetCount() const { return entries_.size(); }
+  [[nodiscard]] bool Contains(const uint32_t key) const {
+    return entries_.contains(key);
+  }
+
+ private:
+  struct Entry {
+    int32_t proxy_id = physics::kNullNode;
+    uint32_t slot = 0;
+    uint64_t frame = 0;
+  };
+
+  physics::b2DynamicTree tree_;
+  // ツリーは Entry のアドレスを保持するため、要素のアドレスが変わらないコンテナを使う
+  std::unordered_map<uint32_t, Entry> entries_;
+  uint64_t frame_ = 0;
+};
+}  // namespace base_engine
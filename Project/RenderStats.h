@@ -0,0 +1,95 @@
+﻿// @RenderStats.h
+// @brief 1フレームの描画の統計
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// RenderCommandBuffer がバッチを実行するたびに集計する。
+// レイヤーごと、マテリアルごとの内訳と、描画面積から求めるオーバードローを持つ。
+
+#pragma once
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace base_engine {
+class Material;
+
+/**
+ * \brief 描画の統計の1区分
+ */
+struct RenderGroupStats {
+  // 記録された描画コマンドの数
+  uint32_t command_count = 0;
+  // まとめた後のバッチの数
+  uint32_t batch_count = 0;
+  // バックエンドが実際に発行した描画の数
+  uint32_t draw_call_count = 0;
+  // 四角形は4、線は2として数えた頂点の数。円は含まない
+  uint32_t vertex_count = 0;
+  // テクスチャが直前のバッチから切り替わった回数
+  uint32_t texture_bind_count = 0;
+  // マテリアルが直前のバッチから切り替わった回数
+  uint32_t material_bind_count = 0;
+  // 塗りつぶした面積(ピクセル)の合計。線と枠は含まない
+  float covered_area = 0.0f;
+
+  RenderGroupStats& operator+=(const RenderGroupStats& other) {
+    command_count += other.command_count;
+    batch_count += other.batch_count;
+    draw_call_count += other.draw_call_count;
+    vertex_count += other.vertex_count;
+    texture_bind_count += other.texture_bind_count;
+    material_bind_count += other.material_bind_count;
+    covered_area += other.covered_area;
+    return *this;
+  }
+};
+
+struct RenderMaterialStats {
+  // nullptr はマテリアルなし
+  const Material* material = nullptr;
+  RenderGroupStats stats;
+};
+
+/**
+ * \brief 1フレームの描画の統計
+ */
+struct RenderFrameStats {
+  RenderGroupStats total;
+  // レイヤー番号ごとの内訳
+  std::map<uint8_t, RenderGroupStats> layers;
+  // 初めて描画された順のマテリアルごとの内訳
+  std::vector<RenderMaterialStats> materials;
+  // 描画先の大きさ。オーバードローの計算に使う
+  float target_width = 0.0f;
+  float target_height = 0.0f;
+  // キャッシュしたレイヤーを使い回した数と描き直した数
+  uint32_t cached_layer_reuse_count = 0;
+  uint32_t cached_layer_rebuild_count = 0;
+
+  /**
+   * \brief バッチ1つ分の統計を合計とレイヤー、マテリアルの内訳に加えます。
+   */
+  void Add(const uint8_t layer, const Material* material,
+           const RenderGroupStats& stats) {
+    total += stats;
+    layers[layer] += stats;
+    for (auto& material_stats : materials) {
+      if (material_stats.material == material) {
+        material_stats.stats += stats;
+        return;
+      }
+    }
+    materials.push_back({material, stats});
+  }
+
+  /**
+   * \brief 描画面積を描画先の面積で割った値。1 なら画面を1回塗りつぶしたことになる
+   */
+  [[nodiscard]] float GetOverdraw(const RenderGroupStats& stats) const {
+    const float area = target_width * target_height;
+    return area > 0.0f ? stats.covered_area / area : 0.0f;
+  }
+};
+}  // namespace base_engine
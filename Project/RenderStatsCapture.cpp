@@ -0,0 +1,107 @@
+﻿#include "RenderStatsCapture.h"
+
+namespace base_engine {
+namespace {
+void WriteJsonGroup(std::ostream& out, const RenderGroupStats& stats,
+                    const float overdraw) {
+  out << "\"commands\":" << stats.command_count
+      << ",\"batches\":" << stats.batch_count
+      << ",\"draw_calls\":" << stats.draw_call_count
+      << ",\"vertices\":" << stats.vertex_count
+      << ",\"texture_binds\":" << stats.texture_bind_count
+      << ",\"material_binds\":" << stats.material_bind_count
+      << ",\"covered_area\":" << stats.covered_area
+      << ",\"overdraw\":" << overdraw;
+}
+
+void WriteCsvRow(std::ostream& out, const uint32_t frame,
+                 const char* scope, const uint32_t id,
+                 const RenderGroupStats& stats, const float overdraw) {
+  out << frame << ',' << scope << ',' << id << ',' << stats.command_count
+      << ',' << stats.batch_count << ',' << stats.draw_call_count << ','
+      << stats.vertex_count << ',' << stats.texture_bind_count << ','
+      << stats.material_bind_count << ',' << stats.covered_area << ','
+      << overdraw << '\n';
+}
+}  // namespace
+
+RenderStatsCapture::~RenderStatsCapture() { Close(); }
+
+bool RenderStatsCapture::Open(const std::filesystem::path& path,
+                              const RenderStatsCaptureFormat format) {
+  Close();
+  stream_.open(path, std::ios::out | std::ios::trunc);
+  if (!stream_) return false;
+  format_ = format;
+  frame_count_ = 0;
+  if (format_ == RenderStatsCaptureFormat::kJson) {
+    stream_ << "{\"frames\":[";
+  } else {
+    stream_ << "frame,scope,id,commands,batches,draw_calls,vertices,"
+               "texture_binds,material_binds,covered_area,overdraw\n";
+  }
+  return true;
+}
+
+void RenderStatsCapture::Record(const RenderFrameStats& stats) {
+  if (!IsOpen()) return;
+  if (format_ == RenderStatsCaptureFormat::kJson) {
+    RecordJson(stats);
+  } else {
+    RecordCsv(stats);
+  }
+  ++frame_count_;
+}
+
+void RenderStatsCapture::Close() {
+  if (!IsOpen()) return;
+  if (format_ == RenderStatsCaptureFormat::kJson) {
+    stream_ << "\n]}\n";
+  }
+  stream_.close();
+}
+
+void RenderStatsCapture::RecordJson(const RenderFrameStats& stats) {
+  stream_ << (frame_count_ == 0 ? "\n" : ",\n") << "{\"frame\":"
+          << frame_count_ << ",\"target\":[" << stats.target_width << ','
+          << stats.target_height << "],\"cached_layer_reuse\":"
+          << stats.cached_layer_reuse_count << ",\"cached_layer_rebuild\":"
+          << stats.cached_layer_rebuild_count << ',';
+  WriteJsonGroup(stream_, stats.total, stats.GetOverdraw(stats.total));
+
+  stream_ << ",\"layers\":[";
+  bool first = true;
+  for (const auto& [layer, layer_stats] : stats.layers) {
+    stream_ << (first ? "" : ",") << "{\"layer\":" << +layer << ',';
+    WriteJsonGroup(stream_, layer_stats, stats.GetOverdraw(layer_stats));
+    stream_ << '}';
+    first = false;
+  }
+
+  stream_ << "],\"materials\":[";
+  for (size_t i = 0; i < stats.materials.size(); ++i) {
+    const auto& material_stats = stats.materials[i].stats;
+    stream_ << (i == 0 ? "" : ",") << "{\"material\":" << i
+            << ",\"has_material\":"
+            << (stats.materials[i].material ? "true" : "false") << ',';
+    WriteJsonGroup(stream_, material_stats,
+                   stats.GetOverdraw(material_stats));
+    stream_ << '}';
+  }
+  stream_ << "]}";
+}
+
+void RenderStatsCapture::RecordCsv(const RenderFrameStats& stats) {
+  WriteCsvRow(stream_, frame_count_, "total", 0, stats.total,
+              stats.GetOverdraw(stats.total));
+  for (const auto& [layer, layer_stats] : stats.layers) {
+    WriteCsvRow(stream_, frame_count_, "layer", layer, layer_stats,
+                stats.GetOverdraw(layer_stats));
+  }
+  for (size_t i = 0; i < stats.materials.size(); ++i) {
+    const auto& material_stats = stats.materials[i].stats;
+    WriteCsvRow(stream_, frame_count_, "material", static_cast<uint32_t>(i),
+                material_stats, stats.GetOverdraw(material_stats));
+  }
+}
+}  // namespace base_engine
@@ -0,0 +1,66 @@
+﻿// @RenderStatsCapture.h
+// @brief 描画の統計をフレームごとにファイルへ書き出す
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// JSON と CSV に対応する。グラフィックスライブラリに依存しないので、
+// RenderCommandBuffer::SetStatsCapture で RecordingRenderBackend と組み合わせれば
+// ヘッドレス環境でも使える。
+
+#pragma once
+#include <filesystem>
+#include <fstream>
+
+#include "RenderStats.h"
+
+namespace base_engine {
+enum class RenderStatsCaptureFormat : uint8_t {
+  kJson,
+  kCsv,
+};
+
+class RenderStatsCapture {
+ public:
+  RenderStatsCapture() = default;
+  ~RenderStatsCapture();
+  RenderStatsCapture(const RenderStatsCapture&) = delete;
+  RenderStatsCapture& operator=(const RenderStatsCapture&) = delete;
+
+  /**
+   * \brief 書き出し先を開きます。開いていたファイルは閉じます。
+   * \return 開けなければ false
+   */
+  bool Open(const std::filesystem::path& path,
+            RenderStatsCaptureFormat format);
+
+  /**
+   * \brief 1フレーム分の統計を書き出します。
+   * CSV は合計、レイヤー、マテリアルをそれぞれ1行にします。
+   * マテリアルはアドレスではなく、そのフレームで現れた順の番号で書き出します。
+   */
+  void Record(const RenderFrameStats& stats);
+
+  void Close();
+
+  /**
+   * \brief 拡張子が .csv なら CSV、それ以外は JSON を返します。
+   */
+  static RenderStatsCaptureFormat GetFormatFromPath(
+      const std::filesystem::path& path) {
+    return path.extension() == ".csv" ? RenderStatsCaptureFormat::kCsv
+                                      : RenderStatsCaptureFormat::kJson;
+  }
+
+  [[nodiscard]] bool IsOpen() const { return stream_.is_open(); }
+  [[nodiscard]] uint32_t GetFrameCount() const { return frame_count_; }
+
+ private:
+  void RecordJson(const RenderFrameStats& stats);
+  void RecordCsv(const RenderFrameStats& stats);
+
+  std::ofstream stream_;
+  RenderStatsCaptureFormat format_ = RenderStatsCaptureFormat::kJson;
+  uint32_t frame_count_ = 0;
+};
+}  // namespace base_engine
@@ -0,0 +1,115 @@
+﻿#include "RenderStatsPanel.h"
+
+#include <cstdio>
+
+#include "BaseEngineCore.h"
+#include "IBaseEngineRender.h"
+#include "Log.h"
+#include "RenderStats.h"
+#include "imgui.h"
+
+namespace base_engine::editor {
+namespace {
+void DrawGroupRow(const char* label, const RenderGroupStats& stats,
+                  const float overdraw) {
+  ImGui::TableNextRow();
+  ImGui::TableNextColumn();
+  ImGui::TextUnformatted(label);
+  ImGui::TableNextColumn();
+  ImGui::Text("%u", stats.draw_call_count);
+  ImGui::TableNextColumn();
+  ImGui::Text("%u", stats.batch_count);
+  ImGui::TableNextColumn();
+  ImGui::Text("%u", stats.command_count);
+  ImGui::TableNextColumn();
+  ImGui::Text("%u", stats.vertex_count);
+  ImGui::TableNextColumn();
+  ImGui::Text("%u / %u", stats.texture_bind_count, stats.material_bind_count);
+  ImGui::TableNextColumn();
+  ImGui::Text("%.2f", overdraw);
+}
+
+bool BeginGroupTable(const char* id) {
+  if (!ImGui::BeginTable(id, 7,
+                         ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+    return false;
+  }
+  ImGui::TableSetupColumn("Name");
+  ImGui::TableSetupColumn("Draw");
+  ImGui::TableSetupColumn("Batch");
+  ImGui::TableSetupColumn("Command");
+  ImGui::TableSetupColumn("Vertex");
+  ImGui::TableSetupColumn("Bind(T/M)");
+  ImGui::TableSetupColumn("Overdraw");
+  ImGui::TableHeadersRow();
+  return true;
+}
+}  // namespace
+
+void RenderStatsPanel::OnImGuiRender() {
+  const RenderFrameStats& stats = BASE_ENGINE(Render)->GetFrameStats();
+  ImGui::Begin("Render Stats");
+
+  ImGui::Text("Target %.0f x %.0f", stats.target_width, stats.target_height);
+  ImGui::Text("Draw calls %u  Batches %u  Commands %u",
+              stats.total.draw_call_count, stats.total.batch_count,
+              stats.total.command_count);
+  ImGui::Text("Overdraw %.2f", stats.GetOverdraw(stats.total));
+  ImGui::Text("Layer cache reuse %u  rebuild %u",
+              stats.cached_layer_reuse_count,
+              stats.cached_layer_rebuild_count);
+
+  if (ImGui::CollapsingHeader("Layers", ImGuiTreeNodeFlags_DefaultOpen) &&
+      BeginGroupTable("##RenderStatsLayers")) {
+    char label[16];
+    for (const auto& [layer, layer_stats] : stats.layers) {
+      snprintf(label, sizeof(label), "Layer %u", layer);
+      DrawGroupRow(label, layer_stats, stats.GetOverdraw(layer_stats));
+    }
+    ImGui::EndTable();
+  }
+
+  if (ImGui::CollapsingHeader("Materials") &&
+      BeginGroupTable("##RenderStatsMaterials")) {
+    char label[32];
+    for (size_t i = 0; i < stats.materials.size(); ++i) {
+      const auto& material_stats = stats.materials[i];
+      if (material_stats.material) {
+        snprintf(label, sizeof(label), "Material %zu", i);
+      } else {
+        snprintf(label, sizeof(label), "(none)");
+      }
+      DrawGroupRow(label, material_stats.stats,
+                   stats.GetOverdraw(material_stats.stats));
+    }
+    ImGui::EndTable();
+  }
+
+  DrawCaptureControls();
+
+  ImGui::End();
+}
+
+void RenderStatsPanel::DrawCaptureControls() {
+  // キャプチャは描画側が毎フレーム行うので、パネルは開始と停止だけを扱う
+  const auto render = BASE_ENGINE(Render);
+  ImGui::Separator();
+  if (const auto& capture = render->GetStatsCapture(); capture.IsOpen()) {
+    ImGui::Text("Capturing (%u frames)", capture.GetFrameCount());
+    if (ImGui::Button("Stop Capture")) render->StopStatsCapture();
+    return;
+  }
+
+  ImGui::InputText("Path", capture_path_, sizeof(capture_path_));
+  ImGui::RadioButton("JSON", &capture_format_, 0);
+  ImGui::SameLine();
+  ImGui::RadioButton("CSV", &capture_format_, 1);
+  if (ImGui::Button("Start Capture")) {
+    const auto format = capture_format_ == 0 ? RenderStatsCaptureFormat::kJson
+                                             : RenderStatsCaptureFormat::kCsv;
+    if (!render->StartStatsCapture(capture_path_, format)) {
+      BE_CORE_WARN("Render stats capture could not open {}", capture_path_);
+    }
+  }
+}
+}  // namespace base_engine::editor
@@ -0,0 +1,24 @@
+﻿// @RenderStatsPanel.h
+// @brief 描画の統計を表示
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 直前のフレームのドローコール数、バッチ数、オーバードローを
+// レイヤーごと、マテリアルごとに表示し、ファイルへのキャプチャを操作する。
+
+#pragma once
+#include "EditorPanel.h"
+
+namespace base_engine::editor {
+class RenderStatsPanel : public EditorPanel {
+ public:
+  void OnImGuiRender() override;
+
+ private:
+  void DrawCaptureControls();
+
+  char capture_path_[256] = "render_stats.json";
+  int capture_format_ = 0;
+};
+}  // namespace base_engine::editor
@@ -1,13 +1,14 @@
 ﻿#include "ResultScoreComponent.h"
 #include <Utilities/Utilities.h>
 #include "EventBus.h"
+#include "GameClock.h"
 
 ResultScoreComponent::ResultScoreComponent(base_engine::Actor* owner,
                                            int update_order)
     : Component(owner, update_order) {}
 
 void ResultScoreComponent::Update() {
-  result_->Update(Mof::CUtilities::GetFrameSecond());
+  result_->Update(base_engine::GameClock::GetInstance()->GetFixedDeltaTime());
 }
 
 void ResultScoreComponent::Start() {
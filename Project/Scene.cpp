@@ -2,6 +2,11 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <execution>
+#include <thread>
+
 #include "ApplyStaticGravitySystem.h"
 #include "AssetManager.h"
 #include "Audio.h"
@@ -10,10 +15,12 @@
 #include "BodyTypeTag.h"
 #include "BroadPhaseSystem.h"
 #include "CSharpScriptEngine.h"
+#include "ComponentRegistry.h"
 #include "ContactSolverSystem.h"
 #include "ContactTesterCircleCircle.h"
 #include "DataComponents.h"
 #include "DynamicContactSolver.h"
+#include "GameClock.h"
 #include "IBaseEngineAudioEngine.h"
 #include "IBaseEngineRender.h"
 #include "IntegratePosesSystem.h"
@@ -23,8 +30,10 @@
 #include "Prefab.h"
 #include "Profiler.h"
 #include "ShapeComponents.h"
+#include "SpriteAnimationAsset.h"
 #include "SpriteRendererComponent.h"
 #include "Texture.h"
+#include "TextureAtlas.h"
 #include "UpdateBV.h"
 #include "UpdateCirclesBV.h"
 using namespace base_engine;
@@ -90,18 +99,7 @@ ObjectEntity Scene::CreatePrefabEntity(ObjectEntity entity, ObjectEntity parent,
     CopyComponentIfExists<Component>(new_entity, registry_, entity,
                                      entity.GetScene()->GetRegistry());
   };
-  auto t = entity.Children();
-  CopyComponentIfExistsFunc.operator()<TagComponent>();
-  CopyComponentIfExistsFunc.operator()<PrefabComponent>();
-  CopyComponentIfExistsFunc.operator()<HierarchyComponent>();
-  CopyComponentIfExistsFunc.operator()<TransformComponent>();
-  CopyComponentIfExistsFunc.operator()<ScriptComponent>();
-  CopyComponentIfExistsFunc.operator()<SpriteRendererComponent>();
-  CopyComponentIfExistsFunc.operator()<physics::RigidBodyComponent>();
-  CopyComponentIfExistsFunc.operator()<physics::VelocityComponent>();
-  CopyComponentIfExistsFunc.operator()<physics::BodyMask>();
-  CopyComponentIfExistsFunc.operator()<physics::Circle>();
-  CopyComponentIfExistsFunc.operator()<physics::BoundingBox>();
+  CopyableComponents::ForEach(CopyComponentIfExistsFunc);
   auto&& transform = new_entity.GetComponent<TransformComponent>();
   transform.SetChildren(std::vector<UUID>{});
   transform.SetScene(this);
@@ -128,6 +126,10 @@ ObjectEntity Scene::CreatePrefabEntity(ObjectEntity entity, ObjectEntity parent,
 
 ObjectEntity Scene::Instantiate(Ref<Prefab>& prefab, const Vector3* translation,
                                 const Vector3* rotation, const Vector3* scale) {
+  // 参照しているアセットが揃っていなければ、ここでまとめて読み込む
+  const AssetHandle prefab_handle = prefab->handle_;
+  AssetManager::PrefetchAssets({&prefab_handle, 1});
+
   ObjectEntity result;
 
   for (const auto entities =
@@ -261,6 +263,7 @@ TransformComponent Scene::GetWorldSpaceTransform(
 
 void Scene::OnInit() {
   const auto physics_engine_data = Ref<physics::PhysicsEngineData>::Create();
+  physics_engine_data_ = physics_engine_data;
   systems_.emplace_back(std::make_unique<physics::ApplyStaticGravitySystem>(
       this, physics_engine_data));
   systems_.emplace_back(std::make_unique<physics::IntegratePosesSystem>(
@@ -314,24 +317,210 @@ void Scene::AudioOnPlaying() {
     if (!AssetManager::IsAssetHandleValid(audio_component.audio_source))
       continue;
 
-    if (const auto sound =
-            AssetManager::GetAsset<Audio>(audio_component.audio_source);
+    // 読み込みが終わるまでは再生せず、次のフレームでもう一度試す
+    const auto request =
+        AssetManager::GetAssetAsync(audio_component.audio_source);
+    if (!request.IsReady()) continue;
+    if (const auto sound = request.Get<Audio>();
         BASE_ENGINE(AudioEngine)->Play(sound->GetBuffer())) {
       audio_component.is_playing = true;
     }
   }
 }
 
-void Scene::PhysicsUpdate() {
+void Scene::PhysicsUpdate(const float time) {
   BE_PROFILE_FUNC("PhysicsUpdate");
-  for (const auto& system : systems_) {
-    system->OnUpdate();
+  const int32_t sub_steps = GameClock::GetInstance()->GetSubSteps();
+  if (physics_engine_data_) {
+    physics_engine_data_->physics_data_.time_step =
+        time / static_cast<float>(sub_steps);
+  }
+  for (int32_t i = 0; i < sub_steps; ++i) {
+    for (const auto& system : systems_) {
+      system->OnUpdate();
+    }
+  }
+}
+
+void Scene::SpriteAnimationUpdate(const float time) {
+  BE_PROFILE_FUNC("SpriteAnimationUpdate");
+  for (const auto view =
+           registry_.view<SpriteAnimatorComponent, SpriteRendererComponent>();
+       const auto entity : view) {
+    auto [animator, sprite] =
+        view.get<SpriteAnimatorComponent, SpriteRendererComponent>(entity);
+    if (!animator.is_playing) continue;
+
+    // 参照先のアセットとテクスチャサイズは変わったときだけ引き直す
+    if (!animator.clip_set || animator.clip_set->handle_ != animator.animation) {
+      if (!AssetManager::IsAssetHandleValid(animator.animation)) continue;
+      const auto request = AssetManager::GetAssetAsync(animator.animation);
+      if (!request.IsReady()) continue;
+      animator.clip_set = request.Get<SpriteAnimationAsset>();
+      animator.current_frame = SpriteAnimationAsset::kInvalidClip;
+      if (!animator.clip_set) continue;
+    }
+    if (animator.clip >= animator.clip_set->GetClipCount()) continue;
+    if (animator.texture != sprite.texture) {
+      if (!AssetManager::IsAssetHandleValid(sprite.texture)) continue;
+      // 代わりのテクスチャの大きさを覚えないよう、読み込みを待つ
+      const auto request = AssetManager::GetAssetAsync(sprite.texture);
+      if (!request.IsReady()) continue;
+      const auto texture = request.Get<MofTexture>();
+      if (!texture) continue;
+      const auto width = texture->texture_->GetWidth();
+      const auto height = texture->texture_->GetHeight();
+      animator.texture = sprite.texture;
+      animator.current_frame = SpriteAnimationAsset::kInvalidClip;
+      if (width == 0 || height == 0) {
+        BE_CORE_WARN("UUID:{0} 大きさが 0 のテクスチャはアニメーションできません。",
+                     sprite.texture);
+        animator.inverse_texture_size = {0.0f, 0.0f};
+      } else {
+        animator.inverse_texture_size = {1.0f / static_cast<float>(width),
+                                         1.0f / static_cast<float>(height)};
+      }
+    }
+    if (animator.inverse_texture_size.x == 0.0f) continue;
+
+    animator.time += time * animator.speed;
+    const auto frame_index =
+        animator.clip_set->SampleFrame(animator.clip, animator.time);
+    if (frame_index == animator.current_frame) continue;
+    animator.current_frame = frame_index;
+
+    const auto& frame = animator.clip_set->GetFrame(frame_index);
+    sprite.uv_start = {frame.left * animator.inverse_texture_size.x,
+                       frame.top * animator.inverse_texture_size.y};
+    sprite.uv_end = {frame.right * animator.inverse_texture_size.x,
+                     frame.bottom * animator.inverse_texture_size.y};
+  }
+}
+
+namespace {
+// xorshift32 で [0, 1) の乱数を作る
+float NextParticleRandom(uint32_t& state) {
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+}
+}  // namespace
+
+void Scene::ParticleUpdate(const float time) {
+  BE_PROFILE_FUNC("ParticleUpdate");
+  for (const auto view =
+           registry_.view<TransformComponent, ParticleEmitterComponent>();
+       const auto entity : view) {
+    auto [transform, emitter] =
+        view.get<TransformComponent, ParticleEmitterComponent>(entity);
+    auto* state = registry_.try_get<ParticlePoolComponent>(entity);
+    if (!state) {
+      state = &registry_.emplace<ParticlePoolComponent>(entity);
+      state->random_state ^= static_cast<uint32_t>(entity) * 0x85EBCA6Bu;
+    }
+    if (!state->pool || state->pool->GetCapacity() != emitter.max_particles) {
+      state->pool = std::make_shared<ParticlePool>(emitter.max_particles);
+    }
+
+    uint32_t spawn_count = emitter.burst_count;
+    emitter.burst_count = 0;
+    if (emitter.is_emitting) {
+      state->emit_accumulator += emitter.emission_rate * time;
+      const float whole = std::floor(state->emit_accumulator);
+      state->emit_accumulator -= whole;
+      spawn_count += static_cast<uint32_t>(whole);
+    }
+
+    const auto matrix = transform.GetGlobalTransform();
+    const uint32_t color = Mof::CVector4Utilities::ToU32Color(emitter.color);
+    for (uint32_t i = 0; i < spawn_count; ++i) {
+      auto& random = state->random_state;
+      const float angle =
+          emitter.direction +
+          (NextParticleRandom(random) * 2.0f - 1.0f) * emitter.spread;
+      const float speed = std::lerp(emitter.speed_min, emitter.speed_max,
+                                    NextParticleRandom(random));
+      const float lifetime = std::lerp(
+          emitter.lifetime_min, emitter.lifetime_max, NextParticleRandom(random));
+      if (!state->pool->Spawn({matrix.rc[3][0], matrix.rc[3][1],
+                               std::cos(angle) * speed,
+                               std::sin(angle) * speed, lifetime, emitter.size,
+                               color})) {
+        break;
+      }
+    }
+
+    state->pool->Update(time, emitter.gravity.x, emitter.gravity.y);
+  }
+}
+
+void Scene::SubmitParticles(const physics::PhysicsAABB& view_aabb) {
+  BE_PROFILE_FUNC("SubmitParticles");
+  const auto render = BASE_ENGINE(Render);
+  render->BeginCommandList(particle_command_list_);
+  for (const auto view =
+           registry_.view<ParticleEmitterComponent, ParticlePoolComponent>();
+       const auto entity : view) {
+    auto [emitter, state] =
+        view.get<ParticleEmitterComponent, ParticlePoolComponent>(entity);
+    if (!state.pool || state.pool->GetCount() == 0) continue;
+    if (!AssetManager::IsAssetHandleValid(emitter.texture)) continue;
+    const auto texture =
+        AssetManager::GetAssetAsync(emitter.texture).Get<MofTexture>();
+    if (!texture) continue;
+    const float width = static_cast<float>(texture->texture_->GetWidth());
+    const float height = static_cast<float>(texture->texture_->GetHeight());
+    const float uv[4] = {0.0f, 0.0f, width, height};
+
+    const auto& pool = *state.pool;
+    const size_t count = pool.GetCount();
+    const float* position_x = pool.GetPositionX();
+    const float* position_y = pool.GetPositionY();
+    const float* alpha = pool.GetAlpha();
+    const float* size = pool.GetSize();
+    const uint32_t* color = pool.GetColor();
+    particle_command_list_.Reserve(particle_command_list_.GetCommandCount() +
+                                   count);
+    for (size_t i = 0; i < count; ++i) {
+      const float half_width = width * size[i] * 0.5f;
+      const float half_height = height * size[i] * 0.5f;
+      if (position_x[i] + half_width < view_aabb.lowerBound.x ||
+          position_x[i] - half_width > view_aabb.upperBound.x ||
+          position_y[i] + half_height < view_aabb.lowerBound.y ||
+          position_y[i] - half_height > view_aabb.upperBound.y) {
+        continue;
+      }
+      // 残り寿命の割合を色のアルファに掛けてフェードさせる
+      const auto a = static_cast<uint32_t>(
+          static_cast<float>(color[i] >> 24) * alpha[i]);
+      particle_command_list_.AddTexture(
+          texture->texture_, position_x[i], position_y[i], size[i], size[i],
+          0.0f, uv, (a << 24) | (color[i] & 0x00FFFFFFu),
+          Mof::TEXALIGN_CENTERCENTER);
+    }
+  }
+  render->Submit(particle_command_list_);
+}
+
+void Scene::StoreInterpolationState() {
+  for (const auto view =
+           registry_.view<TransformComponent, SpriteRendererComponent>();
+       const auto entity : view) {
+    auto& transform = view.get<TransformComponent>(entity);
+    const auto matrix = transform.GetGlobalTransform();
+    registry_.emplace_or_replace<TransformInterpolationComponent>(
+        entity,
+        Vector3{matrix.rc[3][0], matrix.rc[3][1], matrix.rc[3][2]}, true);
   }
 }
 
 void Scene::OnUpdate(const float time) {
-  PhysicsUpdate();
+  StoreInterpolationState();
+  PhysicsUpdate(time);
   ScriptOnUpdate(time);
+  SpriteAnimationUpdate(time);
+  ParticleUpdate(time);
 
   for (auto view : registry_.view<TransformComponent>()) {
     //    InternalGetWorldSpaceTransformMatrix({view, this});
@@ -348,13 +537,62 @@ void Scene::OnRenderEditor(float time) {}
 
 void Scene::OnRuntimeStart() {
   CSharpScriptEngine::GetInstance()->InitializeRuntime();
+  BuildTextureAtlas();
 }
 
 void Scene::OnRuntimeStop() {
   CSharpScriptEngine::GetInstance()->ShutdownRuntime();
+  texture_atlas_.reset();
 }
 
-void Scene::OnRender(float time) {
+void Scene::BuildTextureAtlas() {
+  std::vector<TextureAtlasSource> sources;
+  for (const auto view = registry_.view<SpriteRendererComponent>();
+       const auto entity : view) {
+    const auto& sprite = view.get<SpriteRendererComponent>(entity);
+    if (!AssetManager::IsAssetHandleValid(sprite.texture)) {
+      continue;
+    }
+    const auto texture = AssetManager::GetAsset<MofTexture>(sprite.texture);
+    if (!texture) {
+      continue;
+    }
+    sources.push_back({sprite.texture, texture->texture_});
+  }
+
+  auto atlas = std::make_shared<TextureAtlas>();
+  texture_atlas_ = atlas->Build(sources) ? std::move(atlas) : nullptr;
+  // 描画元のページと UV が変わるので作り直す
+  sprite_caches_.clear();
+}
+
+namespace {
+bool IsSameMatrix(const Matrix44& a, const Matrix44& b) {
+  return std::equal(&a.rc[0][0], &a.rc[0][0] + 16, &b.rc[0][0]);
+}
+
+bool IsSameVector(const Vector2& a, const Vector2& b) {
+  return a.x == b.x && a.y == b.y;
+}
+
+bool IsSameVector(const Vector4& a, const Vector4& b) {
+  return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w;
+}
+}  // namespace
+
+void Scene::UpdateSpriteIndex(const float alpha) {
+  sprite_draw_items_.clear();
+  sprite_index_.BeginUpdate();
+  std::bitset<256> dynamic_layers;
+  static_layers_.reset();
+  size_t cache_count = 0;
+  const auto mark_layer = [&](const SpriteRendererComponent& sprite) {
+    if (sprite.is_static) {
+      static_layers_.set(sprite.layer);
+    } else {
+      dynamic_layers.set(sprite.layer);
+    }
+  };
   for (const auto view =
            registry_.view<TransformComponent, SpriteRendererComponent>();
        const auto entity : view) {
@@ -363,21 +601,210 @@ void Scene::OnRender(float time) {
     if (!spriteRendererComponent.texture) {
       continue;
     }
-    if (AssetManager::IsAssetHandleValid(spriteRendererComponent.texture)) {
-      Ref<MofTexture> texture =
-          AssetManager::GetAsset<MofTexture>(spriteRendererComponent.texture);
-      BASE_ENGINE(Render)->AddTexture(
-          texture->texture_, transform.GetGlobalTransform(),
-          {0, 0, static_cast<MofFloat>(texture->texture_->GetWidth()),
-           static_cast<MofFloat>(texture->texture_->GetHeight())},
-          Mof::CVector4Utilities::ToU32Color(spriteRendererComponent.color),
-          {0.5, 0.5, 0});
+    auto world_matrix = transform.GetGlobalTransform();
+    if (const auto interpolation =
+            registry_.try_get<TransformInterpolationComponent>(entity);
+        interpolation && interpolation->has_previous) {
+      const auto& previous = interpolation->previous_translation;
+      world_matrix.rc[3][0] =
+          previous.x + (world_matrix.rc[3][0] - previous.x) * alpha;
+      world_matrix.rc[3][1] =
+          previous.y + (world_matrix.rc[3][1] - previous.y) * alpha;
+      world_matrix.rc[3][2] =
+          previous.z + (world_matrix.rc[3][2] - previous.z) * alpha;
+    }
 
-    } else {
+    // 行列とスプライトの設定が前のフレームと同じなら、前の結果をそのまま使う
+    const auto key = static_cast<uint32_t>(entity);
+    const auto slot = static_cast<uint32_t>(sprite_draw_items_.size());
+    if (const auto cache = sprite_caches_.find(key);
+        cache != sprite_caches_.end()) {
+      const auto& cached = cache->second;
+      if (cached.handle == spriteRendererComponent.texture &&
+          IsSameVector(cached.uv_start, spriteRendererComponent.uv_start) &&
+          IsSameVector(cached.uv_end, spriteRendererComponent.uv_end) &&
+          IsSameVector(cached.item.color, spriteRendererComponent.color) &&
+          cached.item.layer == spriteRendererComponent.layer &&
+          IsSameMatrix(cached.item.world_matrix, world_matrix) &&
+          sprite_index_.Keep(key, slot)) {
+        mark_layer(spriteRendererComponent);
+        sprite_draw_items_.emplace_back(cached.item);
+        ++cache_count;
+        continue;
+      }
+    }
+
+    if (!AssetManager::IsAssetHandleValid(spriteRendererComponent.texture)) {
       BE_CORE_INFO("UUID:{0} テクスチャデータの参照がありません。",
                    spriteRendererComponent.texture);
+      continue;
+    }
+    // 初めて使うテクスチャは読み込みを要求し、終わるまでは代わりのテクスチャで描く。
+    // 代わりが登録されていなければ読み込みが終わるまで描かない
+    const auto request =
+        AssetManager::GetAssetAsync(spriteRendererComponent.texture);
+    const Ref<MofTexture> texture = request.Get<MofTexture>();
+    if (!texture) {
+      continue;
+    }
+
+    // uv_start/uv_end で指定された範囲を切り出す。アトラスにあればページ内へ移す
+    const float texture_width = static_cast<float>(texture->texture_->GetWidth());
+    const float texture_height =
+        static_cast<float>(texture->texture_->GetHeight());
+    SpriteDrawItem item{world_matrix,
+                        texture->texture_,
+                        {spriteRendererComponent.uv_start.x * texture_width,
+                         spriteRendererComponent.uv_start.y * texture_height,
+                         spriteRendererComponent.uv_end.x * texture_width,
+                         spriteRendererComponent.uv_end.y * texture_height},
+                        spriteRendererComponent.color,
+                        spriteRendererComponent.layer};
+    mark_layer(spriteRendererComponent);
+    if (texture_atlas_) {
+      if (const auto entry =
+              texture_atlas_->Find(spriteRendererComponent.texture)) {
+        item.texture = entry->page;
+        for (int i = 0; i < 4; i += 2) {
+          item.uv[i] += entry->rect.Left;
+          item.uv[i + 1] += entry->rect.Top;
+        }
+      }
     }
+
+    // ピボットが中心なので、回転と拡縮を含めた半分の大きさを求める
+    const float half_width = std::abs(item.uv[2] - item.uv[0]) * 0.5f;
+    const float half_height = std::abs(item.uv[3] - item.uv[1]) * 0.5f;
+    const float extent_x = std::abs(world_matrix.rc[0][0]) * half_width +
+                           std::abs(world_matrix.rc[1][0]) * half_height;
+    const float extent_y = std::abs(world_matrix.rc[0][1]) * half_width +
+                           std::abs(world_matrix.rc[1][1]) * half_height;
+    item.aabb.lowerBound = {world_matrix.rc[3][0] - extent_x,
+                            world_matrix.rc[3][1] - extent_y};
+    item.aabb.upperBound = {world_matrix.rc[3][0] + extent_x,
+                            world_matrix.rc[3][1] + extent_y};
+
+    sprite_index_.Update(key, item.aabb, slot);
+    sprite_draw_items_.emplace_back(item);
+    // 代わりのテクスチャで描いている間は、読み込みが終わったか毎回確かめる
+    if (request.IsReady()) {
+      sprite_caches_[key] = {texture, spriteRendererComponent.texture,
+                             spriteRendererComponent.uv_start,
+                             spriteRendererComponent.uv_end, item};
+      ++cache_count;
+    } else {
+      sprite_caches_.erase(key);
+    }
+  }
+  sprite_index_.EndUpdate();
+  // 消えたスプライトと描かれなかったスプライトのキャッシュを捨てる
+  if (sprite_caches_.size() != cache_count) {
+    std::erase_if(sprite_caches_, [this](const auto& cache) {
+      return !sprite_index_.Contains(cache.first);
+    });
+  }
+
+  // 動くスプライトが1つでもあるレイヤーと、パーティクルと共有するレイヤー 0 はキャッシュしない
+  static_layers_ &= ~dynamic_layers;
+  static_layers_.reset(0);
+}
+
+void Scene::ApplyLayerCache() const {
+  const auto render = BASE_ENGINE(Render);
+  for (size_t layer = 1; layer < static_layers_.size(); ++layer) {
+    const auto render_layer = static_cast<uint8_t>(layer);
+    if (render->IsLayerCached(render_layer) != static_layers_[layer]) {
+      render->SetLayerCached(render_layer, static_layers_[layer]);
+    }
+  }
+}
+
+void Scene::OnRender(const float alpha) {
+  UpdateSpriteIndex(alpha);
+  ApplyLayerCache();
+
+  const auto view_rect = BASE_ENGINE(Render)->GetViewRect();
+  physics::PhysicsAABB view_aabb;
+  view_aabb.lowerBound = {view_rect.Left, view_rect.Top};
+  view_aabb.upperBound = {view_rect.Right, view_rect.Bottom};
+
+  visible_sprites_.clear();
+  if (static_layers_.none()) {
+    sprite_index_.Query(view_aabb, [this](const uint32_t slot) {
+      visible_sprites_.emplace_back(slot);
+    });
+  } else {
+    // キャッシュするレイヤーはキャッシュの範囲全体で選ぶ。
+    // 表示範囲で選ぶと、カメラが動くたびに内容が変わって描き直しになる
+    const auto cache_rect = BASE_ENGINE(Render)->GetLayerCacheRect();
+    physics::PhysicsAABB cache_aabb;
+    cache_aabb.lowerBound = {std::min(cache_rect.Left, view_rect.Left),
+                             std::min(cache_rect.Top, view_rect.Top)};
+    cache_aabb.upperBound = {std::max(cache_rect.Right, view_rect.Right),
+                             std::max(cache_rect.Bottom, view_rect.Bottom)};
+    sprite_index_.Query(cache_aabb, [this, &view_aabb, &cache_aabb](
+                                        const uint32_t slot) {
+      const auto& item = sprite_draw_items_[slot];
+      if (physics::b2TestOverlap(item.aabb, static_layers_[item.layer]
+                                              ? cache_aabb
+                                              : view_aabb)) {
+        visible_sprites_.emplace_back(slot);
+      }
+    });
+  }
+  // BVH を辿る順は木の組み替えで変わるので、スロット(エンティティの列挙順)に
+  // 戻してから並列に分ける。各コマンド列は連続した範囲を受け持ち順番どおりに
+  // Submit するので、重なったスプライトの描画順がフレームごとに入れ替わらない
+  std::ranges::sort(visible_sprites_);
+  culling_stats_.visible_count =
+      static_cast<uint32_t>(visible_sprites_.size());
+  culling_stats_.culled_count =
+      static_cast<uint32_t>(sprite_draw_items_.size()) -
+      culling_stats_.visible_count;
+
+  // 描画コマンドはワーカーごとのコマンド列に並列に作り、描画スレッドでまとめる
+  const size_t visible_count = visible_sprites_.size();
+  const size_t list_count = std::clamp<size_t>(
+      visible_count / internal::kSpritesPerCommandList, 1,
+      std::max(std::thread::hardware_concurrency(), 1u));
+  if (sprite_command_lists_.size() < list_count) {
+    sprite_command_lists_.resize(list_count);
   }
+  const auto render = BASE_ENGINE(Render);
+  for (size_t i = 0; i < list_count; ++i) {
+    render->BeginCommandList(sprite_command_lists_[i]);
+  }
+
+  std::for_each(
+      std::execution::par, sprite_command_lists_.begin(),
+      sprite_command_lists_.begin() + list_count,
+      [this, visible_count, list_count](RenderCommandList& list) {
+        const size_t index = &list - sprite_command_lists_.data();
+        const size_t begin = visible_count * index / list_count;
+        const size_t end = visible_count * (index + 1) / list_count;
+        list.Reserve(end - begin);
+        const int32_t draw_order = list.GetDrawOrder();
+        for (size_t i = begin; i < end; ++i) {
+          const auto& item = sprite_draw_items_[visible_sprites_[i]];
+          list.SetSortOrder(item.layer, draw_order);
+          RenderTransform transform{};
+          for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+              transform.matrix[row][column] = item.world_matrix.rc[row][column];
+            }
+          }
+          transform.pivot[0] = 0.5f;
+          transform.pivot[1] = 0.5f;
+          list.AddTexture(item.texture, transform, item.uv,
+                          Mof::CVector4Utilities::ToU32Color(item.color));
+        }
+      });
+
+  for (size_t i = 0; i < list_count; ++i) {
+    render->Submit(sprite_command_lists_[i]);
+  }
+
+  SubmitParticles(view_aabb);
 }
 
 Scene::Scene() {
@@ -410,22 +837,12 @@ void Scene::CopyTo(Scene* to) {
     const auto new_entity = to->CreateEntityWithUUID(uuid, name);
     entity_map[uuid] = new_entity.entity_handle_;
   }
-  CopyComponent<TransformComponent>(to->registry_, registry_, entity_map);
+  CopyableComponents::ForEach([to, this, &entity_map]<typename Component>() {
+    CopyComponent<Component>(to->registry_, registry_, entity_map);
+  });
   for (const auto view = to->registry_.view<TransformComponent>();
        const auto e : view) {
     auto& transform = to->registry_.get<TransformComponent>(e);
     transform.SetScene(to);
   }
-
-  CopyComponent<TagComponent>(to->registry_, registry_, entity_map);
-  CopyComponent<HierarchyComponent>(to->registry_, registry_, entity_map);
-  CopyComponent<ScriptComponent>(to->registry_, registry_, entity_map);
-  CopyComponent<SpriteRendererComponent>(to->registry_, registry_, entity_map);
-  CopyComponent<physics::RigidBodyComponent>(to->registry_, registry_,
-                                             entity_map);
-  CopyComponent<physics::VelocityComponent>(to->registry_, registry_,
-                                            entity_map);
-  CopyComponent<physics::BodyMask>(to->registry_, registry_, entity_map);
-  CopyComponent<physics::Circle>(to->registry_, registry_, entity_map);
-  CopyComponent<physics::BoundingBox>(to->registry_, registry_, entity_map);
 }
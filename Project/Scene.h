@@ -6,6 +6,8 @@
 // @details
 
 #pragma once
+#include <bitset>
+
 #include "Asset.h"
 #include "Becs/Entity.h"
 #include "Becs/Registry.h"
@@ -13,15 +15,25 @@
 #include "IdComponent.h"
 #include "Matrix44.h"
 #include "Ref.h"
+#include "RenderCommandList.h"
+#include "RenderSpatialIndex.h"
 #include "TransformComponent.h"
 #include "UUID.h"
+#include "Vector2.h"
+#include "Vector4.h"
 namespace base_engine {
+namespace physics {
+class PhysicsEngineData;
+}
 class Prefab;
+class TextureAtlas;
 class ObjectEntity;
 using EntityMap = std::unordered_map<UUID, becs::Entity>;
 using ObjectEntityMap = std::unordered_map<UUID, ObjectEntity>;
 namespace internal {
 constexpr size_t kDefaultCapacity = 1024;
+// 描画コマンド列1つあたりのスプライト数の目安
+constexpr size_t kSpritesPerCommandList = 1024;
 }
 class Scene final : public Asset {
  public:
@@ -72,11 +84,24 @@ class Scene final : public Asset {
       const ObjectEntity entity) const;
 
   void OnInit();
+  /**
+   * \brief 固定ステップ1回分シーンを更新する
+   * \param time 固定ステップの時間(秒)
+   */
   void OnUpdate(float time);
   void OnUpdateRuntime(float time);
   void OnUpdateEditor(float time);
 
-  void OnRender(float time);
+  /**
+   * \brief シーンを描画する
+   * \param alpha 前回の固定ステップから現在の固定ステップまでの補間係数
+   */
+  void OnRender(float alpha);
+
+  /// 直前の OnRender で表示範囲外として省いたスプライトの数など
+  [[nodiscard]] const RenderCullingStats& GetCullingStats() const {
+    return culling_stats_;
+  }
   void OnRenderRuntime(float time);
   void OnRenderEditor(float time);
 
@@ -91,6 +116,15 @@ class Scene final : public Asset {
   void OnRuntimeStart();
   void OnRuntimeStop();
 
+  /**
+   * \brief シーン内のスプライトが参照するテクスチャをアトラスにまとめる
+   * 以降の描画では、アトラスに入ったテクスチャはアトラスのページから描画される
+   */
+  void BuildTextureAtlas();
+  [[nodiscard]] const std::shared_ptr<TextureAtlas>& GetTextureAtlas() const {
+    return texture_atlas_;
+  }
+
  private:
   UUID scene_id_;
   std::string scene_name_;
@@ -102,6 +136,47 @@ class Scene final : public Asset {
   friend ObjectEntity;
 
   std::vector<std::unique_ptr<ISystem>> systems_;
+  Ref<physics::PhysicsEngineData> physics_engine_data_;
+
+  struct SpriteDrawItem {
+    Matrix44 world_matrix;
+    Mof::LPTexture texture;
+    float uv[4];
+    Vector4 color;
+    uint8_t layer;
+    physics::PhysicsAABB aabb;
+  };
+  // 前のフレームから変わっていないスプライトは、アセットの検索と空間インデックスの更新を省く
+  struct SpriteCache {
+    // 読み込み済みのテクスチャ。持っている間は解放されない
+    Ref<Asset> texture;
+    AssetHandle handle;
+    Vector2 uv_start;
+    Vector2 uv_end;
+    SpriteDrawItem item;
+  };
+  std::shared_ptr<TextureAtlas> texture_atlas_;
+  RenderSpatialIndex sprite_index_;
+  std::vector<SpriteDrawItem> sprite_draw_items_;
+  std::unordered_map<uint32_t, SpriteCache> sprite_caches_;
+  std::vector<uint32_t> visible_sprites_;
+  // ワーカーごとの描画コマンド列
+  std::vector<RenderCommandList> sprite_command_lists_;
+  RenderCommandList particle_command_list_;
+  RenderCullingStats culling_stats_;
+  // 全てのスプライトが静的なため、描画結果をキャッシュするレイヤー
+  std::bitset<256> static_layers_;
+
+  /**
+   * \brief スプライトの境界矩形を空間インデックスに登録する
+   * \param alpha 描画補間の係数
+   */
+  void UpdateSpriteIndex(float alpha);
+
+  /**
+   * \brief static_layers_ を描画のレイヤーキャッシュに反映する
+   */
+  void ApplyLayerCache() const;
 
   /**
    * \brief 各Entityが持つScriptComponentのOnUpdateを呼び出す
@@ -110,7 +185,30 @@ class Scene final : public Asset {
   void ScriptOnUpdate(float time);
 
   void AudioOnPlaying();
-  void PhysicsUpdate();
+  void PhysicsUpdate(float time);
+
+  /**
+   * \brief 全ての SpriteAnimatorComponent の再生時間を進め、UV を更新する
+   * \param time 前回のUpdateからの経過時間
+   */
+  void SpriteAnimationUpdate(float time);
+
+  /**
+   * \brief ParticleEmitterComponent から粒を放出し、全てのプールを更新する
+   * \param time 前回のUpdateからの経過時間
+   */
+  void ParticleUpdate(float time);
+
+  /**
+   * \brief 表示範囲内のパーティクルを1つのコマンド列にまとめて送る
+   * \param view_aabb 表示範囲
+   */
+  void SubmitParticles(const physics::PhysicsAABB& view_aabb);
+
+  /**
+   * \brief 描画補間のため、固定ステップ開始前の位置を記録する
+   */
+  void StoreInterpolationState();
 
   Matrix44 InternalGetWorldSpaceTransformMatrix(
       const ObjectEntity entity) const;
@@ -1,5 +1,10 @@
 ﻿#include "SceneAssetSerializer.h"
 
+#include <yaml-cpp/yaml.h>
+
+#include <fstream>
+#include <sstream>
+
 #include "ObjectEntity.h"
 #include "Scene.h"
 #include "SceneSerializer.h"
@@ -18,6 +23,27 @@ bool SceneAssetSerializer::TryLoadData(const AssetMetadata& metadata,
   return true;
 }
 
+bool SceneAssetSerializer::TryGetDependencies(
+    const AssetMetadata& metadata,
+    std::vector<AssetHandle>& dependencies) const {
+  const std::ifstream stream(metadata.file_path);
+  if (!stream.is_open()) return false;
+
+  std::stringstream str_stream;
+  str_stream << stream.rdbuf();
+
+  const YAML::Node data = YAML::Load(str_stream.str());
+  if (!data["Scene"]) return false;
+  if (const auto entities = data["Entities"])
+    SceneSerializer::CollectDependencies(entities, dependencies);
+  return true;
+}
+
+void SceneAssetSerializer::GetDependencies(
+    const Ref<Asset>& asset, std::vector<AssetHandle>& dependencies) const {
+  SceneSerializer::CollectDependencies(asset.As<Scene>(), dependencies);
+}
+
 void SceneAssetSerializer::GetRecognizedExtensions(
     std::list<std::string>* extensions) const {
   extensions->push_back(".bscn");
@@ -8,10 +8,15 @@
 #pragma once
 #include "AssetSerializer.h"
 namespace base_engine {
-class SceneAssetSerializer : public base_engine::AssetSerializer {
+class SceneAssetSerializer : public base_engine::AssetSerializer,
+                             public DependencyAssetSerializer {
  public:
   void Serialize(const AssetMetadata& metadata, const Ref<Asset>& asset) const override;
   bool TryLoadData(const AssetMetadata& metadata, Ref<Asset>& asset) const;
+  bool TryGetDependencies(const AssetMetadata& metadata,
+                          std::vector<AssetHandle>& dependencies) const override;
+  void GetDependencies(const Ref<Asset>& asset,
+                       std::vector<AssetHandle>& dependencies) const override;
   void GetRecognizedExtensions(std::list<std::string>* extensions) const;
   std::string GetAssetType(const std::filesystem::path& path) const;
 };
@@ -0,0 +1,861 @@
+﻿#include "SceneBinarySerializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <numeric>
+#include <span>
+#include <sstream>
+#include <unordered_map>
+
+#include "AssetManager.h"
+#include "BinaryArchive.h"
+#include "BodyMask.h"
+#include "CSharpScriptEngine.h"
+#include "ComponentRegistry.h"
+#include "MemoryStreamBuffer.h"
+#include "ObjectEntity.h"
+#include "PhysicsObjectFactory.h"
+#include "RigidBodyComponent.h"
+#include "ShapeComponents.h"
+
+namespace base_engine {
+
+namespace {
+using namespace component;
+
+constexpr uint32_t MakeChunkId(const char (&id)[5]) {
+  return static_cast<uint32_t>(id[0]) | static_cast<uint32_t>(id[1]) << 8 |
+         static_cast<uint32_t>(id[2]) << 16 |
+         static_cast<uint32_t>(id[3]) << 24;
+}
+
+constexpr uint32_t kSceneMagic = MakeChunkId("BSCB");
+
+/// 同じ文字列は一度だけ保存し、列には添え字を入れる
+class StringTable {
+ public:
+  uint32_t Add(const std::string& str) {
+    const auto [it, inserted] =
+        indices_.try_emplace(str, static_cast<uint32_t>(strings_.size()));
+    if (inserted) strings_.push_back(str);
+    return it->second;
+  }
+  const std::vector<std::string>& GetStrings() const { return strings_; }
+
+ private:
+  std::unordered_map<std::string, uint32_t> indices_;
+  std::vector<std::string> strings_;
+};
+
+/// 列は要素をそのまま並べて一度に書き込む
+template <class T>
+void WriteColumn(frozen::BinaryOutputArchive& archive,
+                 const std::vector<T>& column) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  archive(frozen::binary_data(column.data(), column.size() * sizeof(T)));
+}
+
+/// 読み込み元の残りサイズを超える列は読まずに失敗させる
+class ColumnReader {
+ public:
+  ColumnReader(frozen::BinaryInputArchive& archive, const size_t size)
+      : archive_(archive), remaining_(size) {}
+
+  template <class T>
+  bool Read(std::vector<T>& column, const size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (failed_ || count > remaining_ / sizeof(T)) {
+      failed_ = true;
+      return false;
+    }
+    column.resize(count);
+    archive_(frozen::binary_data(column.data(), count * sizeof(T)));
+    remaining_ -= count * sizeof(T);
+    return true;
+  }
+
+  template <class T>
+  bool Read(T& value) {
+    static_assert(std::is_arithmetic_v<T>);
+    if (failed_ || remaining_ < sizeof(T)) {
+      failed_ = true;
+      return false;
+    }
+    archive_(value);
+    remaining_ -= sizeof(T);
+    return true;
+  }
+
+  bool ReadBytes(std::string& bytes, const size_t size) {
+    if (failed_ || size > remaining_) {
+      failed_ = true;
+      return false;
+    }
+    bytes.resize(size);
+    archive_(frozen::binary_data(bytes.data(), size));
+    remaining_ -= size;
+    return true;
+  }
+
+  [[nodiscard]] bool Failed() const { return failed_; }
+
+ private:
+  frozen::BinaryInputArchive& archive_;
+  size_t remaining_;
+  bool failed_ = false;
+};
+
+/*
+ * コンポーネントごとの列。
+ * Visit はエンティティ 1 つあたりの要素数と一緒に固定長の列を渡し、
+ * VisitTail は要素数がエンティティごとに変わる列を渡す。
+ */
+struct HierarchyColumns {
+  static constexpr uint32_t kId = MakeChunkId("HIER");
+  using Component = HierarchyComponent;
+  std::vector<uint32_t> entity;
+  std::vector<uint64_t> parent;
+  std::vector<uint32_t> child_count;
+  std::vector<uint64_t> children;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(parent, 1);
+    f(child_count, 1);
+  }
+  void VisitTail(auto&& f) { f(children); }
+  [[nodiscard]] size_t TailCount() const {
+    return std::accumulate(child_count.begin(), child_count.end(), size_t{0});
+  }
+};
+
+struct TransformColumns {
+  static constexpr uint32_t kId = MakeChunkId("XFRM");
+  using Component = TransformComponent;
+  std::vector<uint32_t> entity;
+  std::vector<float> rotation;  // x, y, z, w
+  std::vector<float> position;
+  std::vector<float> scale;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(rotation, 4);
+    f(position, 3);
+    f(scale, 3);
+  }
+};
+
+struct SpriteRendererColumns {
+  static constexpr uint32_t kId = MakeChunkId("SPRT");
+  using Component = SpriteRendererComponent;
+  std::vector<uint32_t> entity;
+  std::vector<uint64_t> texture;
+  std::vector<float> color;
+  std::vector<float> pivot;
+  std::vector<uint8_t> layer;
+  std::vector<uint8_t> is_static;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(texture, 1);
+    f(color, 4);
+    f(pivot, 2);
+    f(layer, 1);
+    f(is_static, 1);
+  }
+};
+
+struct SpriteAnimatorColumns {
+  static constexpr uint32_t kId = MakeChunkId("SANM");
+  using Component = SpriteAnimatorComponent;
+  std::vector<uint32_t> entity;
+  std::vector<uint64_t> animation;
+  std::vector<uint32_t> clip;
+  std::vector<float> speed;
+  std::vector<uint8_t> is_playing;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(animation, 1);
+    f(clip, 1);
+    f(speed, 1);
+    f(is_playing, 1);
+  }
+};
+
+struct ParticleEmitterColumns {
+  static constexpr uint32_t kId = MakeChunkId("PEMT");
+  using Component = ParticleEmitterComponent;
+  std::vector<uint32_t> entity;
+  std::vector<uint64_t> texture;
+  std::vector<uint32_t> max_particles;
+  // emission_rate, lifetime_min, lifetime_max, speed_min, speed_max,
+  // direction, spread, gravity.x, gravity.y, color.xyzw, size
+  std::vector<float> values;
+  std::vector<uint8_t> is_emitting;
+
+  static constexpr size_t kValueCount = 14;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(texture, 1);
+    f(max_particles, 1);
+    f(values, kValueCount);
+    f(is_emitting, 1);
+  }
+};
+
+struct AudioColumns {
+  static constexpr uint32_t kId = MakeChunkId("AUDI");
+  using Component = AudioComponent;
+  std::vector<uint32_t> entity;
+  std::vector<uint64_t> source;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(source, 1);
+  }
+};
+
+struct RigidBodyColumns {
+  static constexpr uint32_t kId = MakeChunkId("RBDY");
+  using Component = physics::RigidBodyComponent;
+  std::vector<uint32_t> entity;
+  std::vector<float> restitution;
+  std::vector<float> mass;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(restitution, 1);
+    f(mass, 1);
+  }
+};
+
+struct BodyMaskColumns {
+  static constexpr uint32_t kId = MakeChunkId("BMSK");
+  using Component = physics::BodyMask;
+  std::vector<uint32_t> entity;
+  std::vector<int32_t> shape_type;
+  std::vector<int32_t> body_type;
+  std::vector<uint32_t> body_mask;
+  std::vector<uint32_t> target_mask;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(shape_type, 1);
+    f(body_type, 1);
+    f(body_mask, 1);
+    f(target_mask, 1);
+  }
+};
+
+struct CircleColumns {
+  static constexpr uint32_t kId = MakeChunkId("CIRC");
+  using Component = physics::Circle;
+  std::vector<uint32_t> entity;
+  std::vector<float> radius;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(radius, 1);
+  }
+};
+
+struct ScriptColumns {
+  static constexpr uint32_t kId = MakeChunkId("SCRP");
+  using Component = ScriptComponent;
+  std::vector<uint32_t> entity;
+  std::vector<uint64_t> class_handle;
+  std::vector<uint32_t> name;
+  std::vector<uint32_t> field_count;
+  std::vector<uint32_t> field_name;
+  std::vector<uint8_t> field_type;
+  // Variant が持つ値 (8 バイト以下) をそのまま詰めたもの
+  std::vector<uint64_t> field_value;
+
+  void Visit(auto&& f) {
+    f(entity, 1);
+    f(class_handle, 1);
+    f(name, 1);
+    f(field_count, 1);
+  }
+  void VisitTail(auto&& f) {
+    f(field_name);
+    f(field_type);
+    f(field_value);
+  }
+  [[nodiscard]] size_t TailCount() const {
+    return std::accumulate(field_count.begin(), field_count.end(), size_t{0});
+  }
+};
+
+struct SceneColumns {
+  HierarchyColumns hierarchy;
+  TransformColumns transform;
+  SpriteRendererColumns sprite;
+  SpriteAnimatorColumns animator;
+  ParticleEmitterColumns emitter;
+  AudioColumns audio;
+  RigidBodyColumns rigid_body;
+  BodyMaskColumns body_mask;
+  CircleColumns circle;
+  ScriptColumns script;
+
+  //! 列を持つコンポーネント。メンバーを増やしたらここにも加える
+  using Components =
+      ComponentList<HierarchyColumns::Component, TransformColumns::Component,
+                    SpriteRendererColumns::Component,
+                    SpriteAnimatorColumns::Component,
+                    ParticleEmitterColumns::Component,
+                    AudioColumns::Component, RigidBodyColumns::Component,
+                    BodyMaskColumns::Component, CircleColumns::Component,
+                    ScriptColumns::Component>;
+
+  void Visit(auto&& f) {
+    f(hierarchy);
+    f(transform);
+    f(sprite);
+    f(animator);
+    f(emitter);
+    f(audio);
+    f(rigid_body);
+    f(body_mask);
+    f(circle);
+    f(script);
+  }
+};
+
+// YAML で保存するコンポーネントはバイナリ形式でも列を持たなければならない
+static_assert([]<class... Components>(ComponentList<Components...>) {
+  return (SceneColumns::Components::kContains<Components> && ...);
+}(ReflectedComponents{}),
+              "reflected component missing from SceneColumns");
+
+template <class Columns>
+void WriteChunk(frozen::BinaryOutputArchive& archive, Columns& columns) {
+  const auto count = static_cast<uint32_t>(columns.entity.size());
+  if (count == 0) return;
+
+  std::ostringstream payload_stream(std::ios::binary);
+  {
+    frozen::BinaryOutputArchive payload(payload_stream);
+    columns.Visit(
+        [&payload](auto& column, size_t) { WriteColumn(payload, column); });
+    if constexpr (requires { columns.TailCount(); })
+      columns.VisitTail(
+          [&payload](auto& column) { WriteColumn(payload, column); });
+  }
+  const auto bytes = std::move(payload_stream).str();
+  archive(Columns::kId, count, static_cast<uint64_t>(bytes.size()));
+  archive(frozen::binary_data(bytes.data(), bytes.size()));
+}
+
+template <class Columns>
+bool ReadChunk(const std::string& bytes, const uint32_t count,
+               const uint32_t entity_count, Columns& columns) {
+  MemoryStreamBuffer buffer(std::as_bytes(std::span(bytes)));
+  std::istream stream(&buffer);
+  frozen::BinaryInputArchive archive(stream);
+  ColumnReader reader(archive, bytes.size());
+
+  columns.Visit([&reader, count](auto& column, const size_t width) {
+    reader.Read(column, count * width);
+  });
+  if constexpr (requires { columns.TailCount(); }) {
+    const auto tail_count = reader.Failed() ? 0 : columns.TailCount();
+    columns.VisitTail(
+        [&reader, tail_count](auto& column) {
+          reader.Read(column, tail_count);
+        });
+  }
+  if (reader.Failed()) return false;
+  // 同じエンティティの行が2つあると、後の行で前の行を黙って上書きしてしまう
+  std::vector<bool> seen(entity_count);
+  return std::ranges::all_of(columns.entity, [&seen](const uint32_t i) {
+    if (i >= seen.size() || seen[i]) return false;
+    seen[i] = true;
+    return true;
+  });
+}
+
+template <class T>
+void PushValues(std::vector<float>& column, const T& v, const size_t count) {
+  const float values[] = {v.x, v.y, v.z, v.w};
+  column.insert(column.end(), values, values + count);
+}
+
+void WriteEntities(frozen::BinaryOutputArchive& archive,
+                   const Ref<Scene>& scene) {
+  std::map<UUID, becs::Entity> sorted_entity_map;
+  for (const auto id_component_view =
+           scene->GetRegistry().view<IdComponent>();
+       const auto entity : id_component_view)
+    sorted_entity_map[id_component_view.get<IdComponent>(entity).uuid] = entity;
+
+  StringTable strings;
+  const auto scene_name = strings.Add(std::string(scene->GetName()));
+  std::vector<uint64_t> uuids;
+  std::vector<uint32_t> tags;
+  uuids.reserve(sorted_entity_map.size());
+  tags.reserve(sorted_entity_map.size());
+
+  SceneColumns columns;
+  uint32_t index = 0;
+  for (const auto& [uuid, handle] : sorted_entity_map) {
+    ObjectEntity entity{handle, scene.Raw()};
+    uuids.push_back(static_cast<UUID::ValueType>(uuid));
+    tags.push_back(strings.Add(entity.HasComponent<TagComponent>()
+                                   ? entity.GetComponent<TagComponent>().tag
+                                   : std::string()));
+
+    if (entity.HasComponent<HierarchyComponent>()) {
+      const auto& hierarchy = entity.GetComponent<HierarchyComponent>();
+      auto& c = columns.hierarchy;
+      c.entity.push_back(index);
+      c.parent.push_back(static_cast<UUID::ValueType>(hierarchy.parent_handle));
+      c.child_count.push_back(static_cast<uint32_t>(hierarchy.children.size()));
+      for (const auto& child : hierarchy.children)
+        c.children.push_back(static_cast<UUID::ValueType>(child));
+    }
+    if (entity.HasComponent<TransformComponent>()) {
+      auto& transform = entity.GetComponent<TransformComponent>();
+      auto& c = columns.transform;
+      c.entity.push_back(index);
+      PushValues(c.rotation, transform.GetLocalRotation(), 4);
+      const Vector3 position = transform.GetLocalTranslation();
+      const Vector3 scale = transform.GetLocalScale();
+      c.position.insert(c.position.end(), {position.x, position.y, position.z});
+      c.scale.insert(c.scale.end(), {scale.x, scale.y, scale.z});
+    }
+    if (entity.HasComponent<SpriteRendererComponent>()) {
+      const auto& sprite = entity.GetComponent<SpriteRendererComponent>();
+      auto& c = columns.sprite;
+      c.entity.push_back(index);
+      c.texture.push_back(static_cast<UUID::ValueType>(sprite.texture));
+      PushValues(c.color, sprite.color, 4);
+      c.pivot.insert(c.pivot.end(), {sprite.pivot.x, sprite.pivot.y});
+      c.layer.push_back(sprite.layer);
+      c.is_static.push_back(sprite.is_static);
+    }
+    if (entity.HasComponent<SpriteAnimatorComponent>()) {
+      const auto& animator = entity.GetComponent<SpriteAnimatorComponent>();
+      auto& c = columns.animator;
+      c.entity.push_back(index);
+      c.animation.push_back(static_cast<UUID::ValueType>(animator.animation));
+      c.clip.push_back(animator.clip);
+      c.speed.push_back(animator.speed);
+      c.is_playing.push_back(animator.is_playing);
+    }
+    if (entity.HasComponent<ParticleEmitterComponent>()) {
+      const auto& emitter = entity.GetComponent<ParticleEmitterComponent>();
+      auto& c = columns.emitter;
+      c.entity.push_back(index);
+      c.texture.push_back(static_cast<UUID::ValueType>(emitter.texture));
+      c.max_particles.push_back(emitter.max_particles);
+      c.values.insert(
+          c.values.end(),
+          {emitter.emission_rate, emitter.lifetime_min, emitter.lifetime_max,
+           emitter.speed_min, emitter.speed_max, emitter.direction,
+           emitter.spread, emitter.gravity.x, emitter.gravity.y,
+           emitter.color.x, emitter.color.y, emitter.color.z, emitter.color.w,
+           emitter.size});
+      c.is_emitting.push_back(emitter.is_emitting);
+    }
+    if (entity.HasComponent<AudioComponent>()) {
+      auto& c = columns.audio;
+      c.entity.push_back(index);
+      c.source.push_back(static_cast<UUID::ValueType>(
+          entity.GetComponent<AudioComponent>().audio_source));
+    }
+    if (entity.HasComponent<physics::RigidBodyComponent>()) {
+      const auto& rigid = entity.GetComponent<physics::RigidBodyComponent>();
+      auto& c = columns.rigid_body;
+      c.entity.push_back(index);
+      c.restitution.push_back(rigid.restitution);
+      c.mass.push_back(rigid.mass);
+    }
+    if (entity.HasComponent<physics::BodyMask>()) {
+      const auto& mask = entity.GetComponent<physics::BodyMask>();
+      auto& c = columns.body_mask;
+      c.entity.push_back(index);
+      c.shape_type.push_back(mask.shape_type_id);
+      c.body_type.push_back(mask.tag_type_id);
+      c.body_mask.push_back(mask.body_mask);
+      c.target_mask.push_back(mask.target_mask);
+    }
+    if (entity.HasComponent<physics::Circle>()) {
+      auto& c = columns.circle;
+      c.entity.push_back(index);
+      c.radius.push_back(entity.GetComponent<physics::Circle>().radius);
+    }
+    if (entity.HasComponent<ScriptComponent>()) {
+      const auto& sc = entity.GetComponent<ScriptComponent>();
+      const auto engine = CSharpScriptEngine::GetInstance();
+      const auto script_class = engine->GetManagedClassById(
+          engine->GetScriptClassIdFromComponent(sc));
+      auto& c = columns.script;
+      c.entity.push_back(index);
+      c.class_handle.push_back(
+          static_cast<UUID::ValueType>(sc.script_class_handle));
+      c.name.push_back(
+          strings.Add(script_class ? script_class->full_name : "Null"));
+
+      uint32_t field_count = 0;
+      if (script_class) {
+        for (const auto field_id : script_class->fields) {
+          const auto field = engine->GetFieldById(field_id);
+          const Ref<IFieldStorage> storage =
+              engine->GetFieldStorage(entity, field_id);
+          if (!storage) continue;
+          const auto value = storage->GetValueVariant();
+          uint64_t raw = 0;
+          bool has_value = false;
+          value.Visit([&raw, &has_value](const auto& v) {
+            static_assert(sizeof(v) <= sizeof(raw));
+            std::memcpy(&raw, &v, sizeof(v));
+            has_value = true;
+          });
+          if (!has_value) continue;
+          c.field_name.push_back(strings.Add(field->field_info.name));
+          c.field_type.push_back(static_cast<uint8_t>(value.GetType()));
+          c.field_value.push_back(raw);
+          ++field_count;
+        }
+      }
+      c.field_count.push_back(field_count);
+    }
+    ++index;
+  }
+
+  uint32_t chunk_count = 0;
+  columns.Visit([&chunk_count](const auto& c) {
+    if (!c.entity.empty()) ++chunk_count;
+  });
+
+  archive(kSceneMagic, SceneBinarySerializer::kVersion,
+          static_cast<uint32_t>(uuids.size()), chunk_count);
+
+  archive(static_cast<uint32_t>(strings.GetStrings().size()));
+  for (const auto& str : strings.GetStrings()) {
+    archive(static_cast<uint32_t>(str.size()));
+    archive(frozen::binary_data(str.data(), str.size()));
+  }
+
+  archive(scene_name);
+  WriteColumn(archive, uuids);
+  WriteColumn(archive, tags);
+
+  columns.Visit([&archive](auto& c) { WriteChunk(archive, c); });
+}
+
+void CollectDependencies(const SceneColumns& columns,
+                         std::vector<AssetHandle>& dependencies) {
+  for (const auto handles :
+       {&columns.sprite.texture, &columns.animator.animation,
+        &columns.emitter.texture, &columns.audio.source,
+        &columns.script.class_handle})
+    dependencies.insert(dependencies.end(), handles->begin(), handles->end());
+}
+
+void ApplyScript(const SceneColumns& columns,
+                 const std::vector<std::string>& strings,
+                 std::vector<ObjectEntity>& entities) {
+  const auto& c = columns.script;
+  const auto engine = CSharpScriptEngine::GetInstance();
+  size_t field_offset = 0;
+  for (size_t i = 0; i < c.entity.size(); ++i) {
+    const auto fields_begin = field_offset;
+    field_offset += c.field_count[i];
+    if (c.class_handle[i] == 0) continue;
+
+    auto& entity = entities[c.entity[i]];
+    auto& sc =
+        entity.AddComponent<ScriptComponent>(AssetHandle{c.class_handle[i]});
+    engine->InitializeScriptEntity(entity);
+
+    const auto script_class = engine->GetManagedClassById(
+        engine->GetScriptClassIdFromComponent(sc));
+    if (!script_class) continue;
+
+    for (const auto field_id : script_class->fields) {
+      const auto field = engine->GetFieldById(field_id);
+      Variant object(field->field_info.type);
+      for (auto f = fields_begin; f < field_offset; ++f) {
+        if (c.field_name[f] >= strings.size() ||
+            strings[c.field_name[f]] != field->field_info.name ||
+            c.field_type[f] != static_cast<uint8_t>(object.GetType()))
+          continue;
+        object.Visit([raw = c.field_value[f]](auto& value) {
+          std::memcpy(&value, &raw, sizeof(value));
+        });
+        break;
+      }
+      const Ref<IFieldStorage> storage =
+          engine->GetFieldStorage(entity, field_id);
+      if (!storage) break;
+      storage->SetValueVariant(object);
+    }
+  }
+}
+
+void ApplyColumns(const SceneColumns& columns,
+                  const std::vector<std::string>& strings,
+                  std::vector<ObjectEntity>& entities) {
+  {
+    const auto& c = columns.hierarchy;
+    size_t child_offset = 0;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      auto& hierarchy =
+          entities[c.entity[i]].GetComponent<HierarchyComponent>();
+      hierarchy.parent_handle = c.parent[i];
+      for (uint32_t n = 0; n < c.child_count[i]; ++n)
+        hierarchy.children.emplace_back(c.children[child_offset++]);
+    }
+  }
+  {
+    const auto& c = columns.transform;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      auto& transform =
+          entities[c.entity[i]].GetComponent<TransformComponent>();
+      Quaternion rotation;
+      rotation.x = c.rotation[i * 4 + 0];
+      rotation.y = c.rotation[i * 4 + 1];
+      rotation.z = c.rotation[i * 4 + 2];
+      rotation.w = c.rotation[i * 4 + 3];
+      Vector3 position, scale;
+      position.x = c.position[i * 3 + 0];
+      position.y = c.position[i * 3 + 1];
+      position.z = c.position[i * 3 + 2];
+      scale.x = c.scale[i * 3 + 0];
+      scale.y = c.scale[i * 3 + 1];
+      scale.z = c.scale[i * 3 + 2];
+      transform.SetLocalRotation(rotation);
+      transform.SetLocalTranslation(position);
+      transform.SetLocalScale(scale);
+    }
+  }
+  {
+    const auto& c = columns.sprite;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      auto& sprite =
+          entities[c.entity[i]].AddComponent<SpriteRendererComponent>();
+      sprite.texture = AssetHandle{c.texture[i]};
+      sprite.color.x = c.color[i * 4 + 0];
+      sprite.color.y = c.color[i * 4 + 1];
+      sprite.color.z = c.color[i * 4 + 2];
+      sprite.color.w = c.color[i * 4 + 3];
+      sprite.pivot.x = c.pivot[i * 2 + 0];
+      sprite.pivot.y = c.pivot[i * 2 + 1];
+      sprite.layer = c.layer[i];
+      sprite.is_static = c.is_static[i] != 0;
+      if (!AssetManager::IsAssetHandleValid(sprite.texture)) {
+        BE_CORE_ERROR_TAG("Deserialize", "テクスチャアセットのUUIDが無効");
+      }
+    }
+  }
+  {
+    const auto& c = columns.animator;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      auto& animator =
+          entities[c.entity[i]].AddComponent<SpriteAnimatorComponent>();
+      animator.animation = AssetHandle{c.animation[i]};
+      animator.clip = c.clip[i];
+      animator.speed = c.speed[i];
+      animator.is_playing = c.is_playing[i] != 0;
+      if (!AssetManager::IsAssetHandleValid(animator.animation)) {
+        BE_CORE_ERROR_TAG("Deserialize", "アニメーションアセットのUUIDが無効");
+      }
+    }
+  }
+  {
+    const auto& c = columns.emitter;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      auto& emitter =
+          entities[c.entity[i]].AddComponent<ParticleEmitterComponent>();
+      const auto* v = &c.values[i * ParticleEmitterColumns::kValueCount];
+      emitter.texture = AssetHandle{c.texture[i]};
+      emitter.max_particles = c.max_particles[i];
+      emitter.emission_rate = v[0];
+      emitter.lifetime_min = v[1];
+      emitter.lifetime_max = v[2];
+      emitter.speed_min = v[3];
+      emitter.speed_max = v[4];
+      emitter.direction = v[5];
+      emitter.spread = v[6];
+      emitter.gravity.x = v[7];
+      emitter.gravity.y = v[8];
+      emitter.color.x = v[9];
+      emitter.color.y = v[10];
+      emitter.color.z = v[11];
+      emitter.color.w = v[12];
+      emitter.size = v[13];
+      emitter.is_emitting = c.is_emitting[i] != 0;
+      if (!AssetManager::IsAssetHandleValid(emitter.texture)) {
+        BE_CORE_ERROR_TAG("Deserialize", "テクスチャアセットのUUIDが無効");
+      }
+    }
+  }
+  {
+    const auto& c = columns.audio;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      auto& audio = entities[c.entity[i]].AddComponent<AudioComponent>();
+      audio.audio_source = AssetHandle{c.source[i]};
+      if (!AssetManager::IsAssetHandleValid(audio.audio_source)) {
+        BE_CORE_ERROR_TAG("Deserialize", "オーディオアセットのUUIDが無効");
+      }
+    }
+  }
+
+  ApplyScript(columns, strings, entities);
+
+  // 物理は YAML と同じく、質量・反発係数・マスクが揃ってから作る
+  {
+    const auto entity_count = entities.size();
+    std::vector<float> mass(entity_count, 0), restitution(entity_count, 0),
+        radius(entity_count, 0);
+    for (size_t i = 0; i < columns.rigid_body.entity.size(); ++i) {
+      mass[columns.rigid_body.entity[i]] = columns.rigid_body.mass[i];
+      restitution[columns.rigid_body.entity[i]] =
+          columns.rigid_body.restitution[i];
+    }
+    for (size_t i = 0; i < columns.circle.entity.size(); ++i)
+      radius[columns.circle.entity[i]] = columns.circle.radius[i];
+
+    const auto& c = columns.body_mask;
+    for (size_t i = 0; i < c.entity.size(); ++i) {
+      if (static_cast<size_t>(c.shape_type[i]) != physics::Circle::Type())
+        continue;
+      const auto e = c.entity[i];
+      physics::PhysicsObjectFactory::CreateCircle(entities[e], radius[e],
+                                                  mass[e], restitution[e]);
+      auto& mask = entities[e].GetComponent<physics::BodyMask>();
+      mask.body_mask = c.body_mask[i];
+      mask.target_mask = c.target_mask[i];
+    }
+  }
+
+  for (auto& entity : entities) {
+    auto& transform = entity.GetComponent<TransformComponent>();
+    auto& hierarchy = entity.GetComponent<HierarchyComponent>();
+
+    transform.SetChildren(hierarchy.children);
+    transform.SetParent(hierarchy.parent_handle);
+  }
+}
+
+bool ReadScene(const std::span<const std::byte> data, const Ref<Scene>& scene) {
+  MemoryStreamBuffer buffer(data);
+  std::istream stream(&buffer);
+  frozen::BinaryInputArchive archive(stream);
+  ColumnReader reader(archive, data.size());
+
+  uint32_t magic = 0, version = 0, entity_count = 0, chunk_count = 0;
+  reader.Read(magic);
+  reader.Read(version);
+  if (reader.Failed() || magic != kSceneMagic) {
+    BE_CORE_ERROR("シーンファイルのフォーマットが正しくありません。");
+    return false;
+  }
+  if (version != SceneBinarySerializer::kVersion) {
+    BE_CORE_ERROR("バージョンとの互換性がないため読み込み失敗。");
+    return false;
+  }
+  reader.Read(entity_count);
+  reader.Read(chunk_count);
+
+  uint32_t string_count = 0;
+  reader.Read(string_count);
+  std::vector<std::string> strings;
+  for (uint32_t i = 0; i < string_count && !reader.Failed(); ++i) {
+    uint32_t size = 0;
+    reader.Read(size);
+    reader.ReadBytes(strings.emplace_back(), size);
+  }
+
+  uint32_t scene_name = 0;
+  std::vector<uint64_t> uuids;
+  std::vector<uint32_t> tags;
+  reader.Read(scene_name);
+  reader.Read(uuids, entity_count);
+  reader.Read(tags, entity_count);
+
+  SceneColumns columns;
+  std::vector<uint32_t> chunk_ids;
+  for (uint32_t i = 0; i < chunk_count && !reader.Failed(); ++i) {
+    uint32_t id = 0, count = 0;
+    uint64_t size = 0;
+    std::string bytes;
+    reader.Read(id);
+    reader.Read(count);
+    reader.Read(size);
+    if (!reader.ReadBytes(bytes, size)) break;
+
+    // 同じチャンクが2つあると、後の方で列を読み直して前の内容が消える
+    bool valid = std::ranges::find(chunk_ids, id) == chunk_ids.end();
+    chunk_ids.push_back(id);
+    columns.Visit([&](auto& c) {
+      if (valid && id == std::remove_reference_t<decltype(c)>::kId)
+        valid = ReadChunk(bytes, count, entity_count, c);
+    });
+    if (!valid) {
+      BE_CORE_ERROR("シーンファイルのチャンクが壊れています。");
+      return false;
+    }
+  }
+  if (reader.Failed() || scene_name >= strings.size() ||
+      !std::ranges::all_of(tags, [&strings](const uint32_t tag) {
+        return tag < strings.size();
+      })) {
+    BE_CORE_ERROR("シーンファイルのフォーマットが正しくありません。");
+    return false;
+  }
+
+  BE_CORE_INFO("デシリアライズシーン {0}", strings[scene_name].c_str());
+  scene->SetName(strings[scene_name]);
+
+  std::vector<ObjectEntity> entities;
+  entities.reserve(entity_count);
+  for (uint32_t i = 0; i < entity_count; ++i)
+    entities.push_back(scene->CreateEntityWithUUID(uuids[i], strings[tags[i]]));
+
+  // コンポーネントを作る前に、参照しているアセットをまとめて読み込んでおく
+  std::vector<AssetHandle> dependencies;
+  CollectDependencies(columns, dependencies);
+  AssetManager::PrefetchAssets(dependencies);
+
+  ApplyColumns(columns, strings, entities);
+  return true;
+}
+}  // namespace
+
+SceneBinarySerializer::SceneBinarySerializer(const Ref<Scene>& scene)
+    : scene_(scene) {}
+
+bool SceneBinarySerializer::Serialize(const std::filesystem::path& filepath) {
+  std::ofstream stream(filepath, std::ios::binary);
+  if (!stream) return false;
+  Serialize(stream);
+  return static_cast<bool>(stream);
+}
+
+bool SceneBinarySerializer::Deserialize(const std::filesystem::path& filepath) {
+  if (filepath.extension() != kExtension) return false;
+
+  std::ifstream stream(filepath, std::ios::binary);
+  if (!stream) return false;
+  return Deserialize(stream);
+}
+
+void SceneBinarySerializer::Serialize(std::ostream& stream) {
+  frozen::BinaryOutputArchive archive(stream);
+  WriteEntities(archive, scene_);
+}
+
+bool SceneBinarySerializer::Deserialize(std::istream& stream) {
+  const std::string data{std::istreambuf_iterator(stream),
+                         std::istreambuf_iterator<char>()};
+  return ReadScene(std::as_bytes(std::span(data)), scene_);
+}
+}  // namespace base_engine
@@ -0,0 +1,43 @@
+﻿// @SceneBinarySerializer.h
+// @brief シーンのバイナリ形式での保存と読み込み
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// SceneSerializer の YAML と同じ内容を、コンポーネントの種類ごとのチャンクに
+// まとめて保存する。チャンクの中はフィールドごとの列で、文字列は先頭の
+// 文字列テーブルへの添え字で持つ。frozen の BinaryArchive で読み書きする。
+//
+// [ヘッダー] magic, version, entity_count, chunk_count
+// [文字列テーブル]
+// [エンティティ] scene_name, uuid[n], tag[n]
+// [チャンク] id, count, byte_size, entity[count], 各フィールドの列...
+
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+
+#include "Scene.h"
+
+namespace base_engine {
+class SceneBinarySerializer {
+ public:
+  static constexpr uint32_t kVersion = 1;
+  static constexpr auto kExtension = ".bsceneb";
+
+  explicit SceneBinarySerializer(const Ref<Scene>& scene);
+
+  bool Serialize(const std::filesystem::path& filepath);
+  /**
+   * \brief 指定パス先のファイルを読み取り、Sceneオブジェクトをロードする。
+   * \return 形式かバージョンが合わない場合は false
+   */
+  bool Deserialize(const std::filesystem::path& filepath);
+
+  void Serialize(std::ostream& stream);
+  bool Deserialize(std::istream& stream);
+
+ private:
+  Ref<Scene> scene_;
+};
+}  // namespace base_engine
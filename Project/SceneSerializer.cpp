@@ -8,9 +8,11 @@
 #include "AssetManager.h"
 #include "BodyMask.h"
 #include "CSharpScriptEngine.h"
+#include "ComponentRegistry.h"
 #include "MonoScriptUtilities.h"
 #include "PhysicsObjectFactory.h"
 #include "RigidBodyComponent.h"
+#include "SceneBinarySerializer.h"
 #include "ShapeComponents.h"
 #include "YAMLSerializeHelper.h"
 
@@ -121,106 +123,80 @@ inline void DeserializeHierarchyComponent(YAML::Node& node,
     }
   }
 }
-inline void SerializeSpriteRendererComponent(YAML::Emitter& out,
-                                             ObjectEntity& entity) {
-  if (!entity.HasComponent<SpriteRendererComponent>()) return;
-  out << YAML::Key << "SpriteRendererComponent";
+template <class T>
+using ReflectedValueType = typename std::remove_cvref_t<T>::ValueType;
+
+/// ComponentReflection のフィールドをそのままキーにして書き出す
+template <ReflectedComponent Component>
+void SerializeReflectedComponent(YAML::Emitter& out, ObjectEntity& entity) {
+  if (!entity.HasComponent<Component>()) return;
+  out << YAML::Key << ComponentReflection<Component>::kName;
   out << YAML::BeginMap;
 
-  auto& sprite = entity.GetComponent<SpriteRendererComponent>();
-  out << YAML::Key << "Sprite" << YAML::Value << sprite.texture;
-  out << YAML::Key << "Color" << YAML::Value << sprite.color;
-  out << YAML::Key << "Pivot" << YAML::Value << sprite.pivot;
+  const auto& component = entity.GetComponent<Component>();
+  ForEachComponentField<Component>([&out, &component](const auto& field) {
+    out << YAML::Key << field.name << YAML::Value;
+    // uint8_t は文字として出力されるため数値にする
+    if constexpr (std::is_same_v<ReflectedValueType<decltype(field)>, uint8_t>)
+      out << static_cast<uint32_t>(field.Get(component));
+    else
+      out << field.Get(component);
+  });
 
   out << YAML::EndMap;
 }
-inline void DeserializeSpriteRendererComponent(YAML::Node& node,
-                                               ObjectEntity& entity) {
-  auto sprite_component_node = node["SpriteRendererComponent"];
-  if (!sprite_component_node) return;
-
-  auto& sprite = entity.AddComponent<SpriteRendererComponent>();
-  sprite.texture = sprite_component_node["Sprite"].as<AssetHandle>();
-  sprite.color = sprite_component_node["Color"].as<Vector4>();
-  sprite.pivot = sprite_component_node["Pivot"].as<Vector2>();
-  if (!AssetManager::IsAssetHandleValid(sprite.texture)) {
-    BE_CORE_ERROR_TAG("Deserialize", "テクスチャアセットのUUIDが無効");
-  };
-}
 
-inline void SerializeAudioComponent(YAML::Emitter& out, ObjectEntity& entity) {
-  if (!entity.HasComponent<AudioComponent>()) return;
-  out << YAML::Key << "AudioComponent";
-  out << YAML::BeginMap;
-
-  const auto& audio = entity.GetComponent<AudioComponent>();
-  out << YAML::Key << "Source" << YAML::Value << audio.audio_source;
-  out << YAML::EndMap;
-}
-inline void DeserializeAudioComponent(YAML::Node& node, ObjectEntity& entity) {
-  auto audio_component_node = node["AudioComponent"];
-  if (!audio_component_node) return;
-
-  auto& audio = entity.AddComponent<AudioComponent>();
-  audio.audio_source = audio_component_node["Source"].as<AssetHandle>();
-  if (!AssetManager::IsAssetHandleValid(audio.audio_source)) {
-    BE_CORE_ERROR_TAG("Deserialize", "オーディオアセットのUUIDが無効");
-  };
+/// ノードにあるキーだけ読み込み、無いフィールドは元の値のままにする
+template <ReflectedComponent Component>
+void DeserializeReflectedFields(const YAML::Node& node, Component& component) {
+  ForEachComponentField<Component>([&node, &component](const auto& field) {
+    const auto value = node[field.name];
+    if (!value) return;
+    using ValueType = ReflectedValueType<decltype(field)>;
+    if constexpr (std::is_same_v<ValueType, uint8_t>)
+      field.Get(component) =
+          static_cast<uint8_t>(value.template as<uint32_t>());
+    else
+      field.Get(component) = value.template as<ValueType>();
+  });
 }
 
-inline void SerializeRigidBodyComponent(YAML::Emitter& out,
-                                        ObjectEntity& entity) {
-  if (!entity.HasComponent<physics::RigidBodyComponent>()) return;
-  const auto& rigid = entity.GetComponent<physics::RigidBodyComponent>();
-  out << YAML::Key << "RigidBodyComponent";
-  out << YAML::BeginMap;
-  out << YAML::Key << "Restitution" << YAML::Value << rigid.restitution;
-  out << YAML::Key << "Mass" << YAML::Value << rigid.mass;
-  out << YAML::EndMap;
+template <ReflectedComponent Component>
+void DeserializeReflectedComponent(YAML::Node& node, ObjectEntity& entity) {
+  auto component_node = node[ComponentReflection<Component>::kName];
+  if (!component_node) return;
+
+  auto& component = entity.AddComponent<Component>();
+  DeserializeReflectedFields(component_node, component);
+  ForEachComponentField<Component>([&component](const auto& field) {
+    if constexpr (std::is_same_v<ReflectedValueType<decltype(field)>,
+                                 AssetHandle>) {
+      if (!AssetManager::IsAssetHandleValid(field.Get(component)))
+        BE_CORE_ERROR_TAG("Deserialize", "{0}.{1} のアセットのUUIDが無効",
+                          ComponentReflection<Component>::kName, field.name);
+    }
+  });
 }
 
-inline physics::RigidBodyComponent DeserializeRigidBodyComponent(
-    YAML::Node& node, ObjectEntity& entity) {
-  auto rigid_component_node = node["RigidBodyComponent"];
-  if (!rigid_component_node) return {0, 0, 0};
-  return {rigid_component_node["Restitution"].as<float>(),
-          rigid_component_node["Mass"].as<float>(), 0};
-}
-inline void SerializeBodyMask(YAML::Emitter& out, ObjectEntity& entity) {
-  if (!entity.HasComponent<physics::BodyMask>()) return;
-  out << YAML::Key << "BodyMaskComponent";
-  out << YAML::BeginMap;
-  const auto& mask = entity.GetComponent<physics::BodyMask>();
-  out << YAML::Key << "ShapeType" << YAML::Value << mask.shape_type_id;
-  out << YAML::Key << "BodyType" << YAML::Value << mask.tag_type_id;
-  out << YAML::Key << "BodyMask" << YAML::Value << mask.body_mask;
-  out << YAML::Key << "TargetMask" << YAML::Value << mask.target_mask;
-  out << YAML::EndMap;
-}
-inline physics::BodyMask DeserializeBodyMask(YAML::Node& node,
-                                             ObjectEntity& entity) {
-  auto body_mask_node = node["BodyMaskComponent"];
-  if (!body_mask_node) return {0, 0};
-  return {body_mask_node["ShapeType"].as<int>(),
-          body_mask_node["BodyType"].as<int>(),
-          body_mask_node["BodyMask"].as<uint32_t>(),
-          body_mask_node["TargetMask"].as<uint32_t>()};
+/// ノードが無ければ component をそのまま返す
+template <ReflectedComponent Component>
+Component DeserializeReflectedValue(YAML::Node& node, Component component) {
+  if (const auto component_node = node[ComponentReflection<Component>::kName])
+    DeserializeReflectedFields(component_node, component);
+  return component;
 }
 
-inline void SerializeCircle(YAML::Emitter& out, ObjectEntity& entity) {
-  if (!entity.HasComponent<physics::Circle>()) return;
-  out << YAML::Key << "CircleComponent";
-  out << YAML::BeginMap;
-  const auto& [radius] = entity.GetComponent<physics::Circle>();
-  out << YAML::Key << "Radius" << YAML::Value << radius;
-  out << YAML::EndMap;
-}
-inline physics::Circle DeserializeCircle(YAML::Node& node,
-                                         ObjectEntity& entity) {
-  auto circle_node = node["CircleComponent"];
-  if (!circle_node) return {0};
-  return {circle_node["Radius"].as<float>()};
+/// AssetHandle のフィールドを集める
+template <ReflectedComponent Component>
+void CollectComponentDependencies(const Component& component,
+                                  std::vector<AssetHandle>& dependencies) {
+  ForEachComponentField<Component>([&](const auto& field) {
+    if constexpr (std::is_same_v<ReflectedValueType<decltype(field)>,
+                                 AssetHandle>)
+      dependencies.push_back(field.Get(component));
+  });
 }
+
 inline void SerializeE(YAML::Emitter& out, ObjectEntity& entity) {}
 
 inline void DeserializeE(YAML::Node& node, ObjectEntity& entity) {}
@@ -295,10 +271,11 @@ inline void DeserializeScriptComponent(YAML::Node& node, ObjectEntity& entity) {
 }
 
 void DeserializePhysics(YAML::Node& entity, ObjectEntity& deserialized_entity) {
-  const auto rigid = DeserializeRigidBodyComponent(entity, deserialized_entity);
-  const auto mask = DeserializeBodyMask(entity, deserialized_entity);
+  const auto rigid =
+      DeserializeReflectedValue(entity, physics::RigidBodyComponent{0, 0, 0});
+  const auto mask = DeserializeReflectedValue(entity, physics::BodyMask{0, 0});
   if (mask.shape_type_id == physics::Circle::Type()) {
-    const auto [radius] = DeserializeCircle(entity, deserialized_entity);
+    const auto [radius] = DeserializeReflectedValue(entity, physics::Circle{0});
     physics::PhysicsObjectFactory::CreateCircle(deserialized_entity, radius,
                                                 rigid.mass, rigid.restitution);
     deserialized_entity.GetComponent<physics::BodyMask>().body_mask =
@@ -308,6 +285,24 @@ void DeserializePhysics(YAML::Node& entity, ObjectEntity& deserialized_entity) {
   }
 }
 
+/// Deserialize～Component が読むハンドルと同じキーを読む
+void CollectEntityDependencies(const YAML::Node& entity,
+                               std::vector<AssetHandle>& dependencies) {
+  const auto collect = [&entity, &dependencies](const char* component,
+                                                const char* key) {
+    if (const auto node = entity[component]; node && node[key])
+      dependencies.push_back(node[key].as<AssetHandle>());
+  };
+  ReflectedDataComponents::ForEach([&collect]<class Component>() {
+    ForEachComponentField<Component>([&collect](const auto& field) {
+      if constexpr (std::is_same_v<ReflectedValueType<decltype(field)>,
+                                   AssetHandle>)
+        collect(ComponentReflection<Component>::kName, field.name);
+    });
+  });
+  collect("ScriptComponent", "ClassHandle");
+}
+
 void DeserializeEntities(YAML::Node& entities_node, Ref<Scene> scene) {
   for (auto entity : entities_node) {
     const auto uuid = entity["Entity"].as<uint64_t>();
@@ -319,8 +314,9 @@ void DeserializeEntities(YAML::Node& entities_node, Ref<Scene> scene) {
     ObjectEntity deserialized_entity = scene->CreateEntityWithUUID(uuid, name);
     DeserializeHierarchyComponent(entity, deserialized_entity);
     DeserializeTransformComponent(entity, deserialized_entity);
-    DeserializeSpriteRendererComponent(entity, deserialized_entity);
-    DeserializeAudioComponent(entity, deserialized_entity);
+    ReflectedDataComponents::ForEach([&]<class Component>() {
+      DeserializeReflectedComponent<Component>(entity, deserialized_entity);
+    });
 
     DeserializeScriptComponent(entity, deserialized_entity);
 
@@ -338,6 +334,11 @@ void DeserializeEntities(YAML::Node& entities_node, Ref<Scene> scene) {
 SceneSerializer::SceneSerializer(const Ref<Scene>& scene) : scene_(scene) {}
 
 void SceneSerializer::Serialize(const std::filesystem::path& scene_file_path) {
+  if (scene_file_path.extension() == SceneBinarySerializer::kExtension) {
+    SceneBinarySerializer(scene_).Serialize(scene_file_path);
+    return;
+  }
+
   YAML::Emitter out;
   SerializeToYAML(out);
 
@@ -358,13 +359,10 @@ void SceneSerializer::SerializeEntity(YAML::Emitter& out,
   SerializeHierarchyComponent(out, entity);
   SerializeTransformComponent(out, entity);
 
-  SerializeSpriteRendererComponent(out, entity);
-  SerializeAudioComponent(out, entity);
-
-  // Physics
-  SerializeRigidBodyComponent(out, entity);
-  SerializeBodyMask(out, entity);
-  SerializeCircle(out, entity);
+  // データと物理のコンポーネント
+  ReflectedComponents::ForEach([&out, &entity]<class Component>() {
+    SerializeReflectedComponent<Component>(out, entity);
+  });
 
   SerializeScriptComponent(out, entity);
 
@@ -398,13 +396,15 @@ void SceneSerializer::SerializeToYAML(YAML::Emitter& out) {
 }
 
 bool SceneSerializer::Deserialize(const std::filesystem::path& filepath) {
+  if (filepath.extension() == SceneBinarySerializer::kExtension)
+    return SceneBinarySerializer(scene_).Deserialize(filepath);
   if (filepath.extension() != ".bscene") return false;
 
   const std::ifstream stream(filepath);
   std::stringstream str_stream;
   str_stream << stream.rdbuf();
 
-  if (!DeserializeFromYAML(str_stream.str())) return false;
+  return DeserializeFromYAML(str_stream.str());
 }
 
 void SceneSerializer::DeserializeEntities(YAML::Node& entities_node,
@@ -412,6 +412,27 @@ void SceneSerializer::DeserializeEntities(YAML::Node& entities_node,
   internal::DeserializeEntities(entities_node, scene);
 }
 
+void SceneSerializer::CollectDependencies(
+    const Ref<Scene>& scene, std::vector<AssetHandle>& dependencies) {
+  using namespace component;
+  ReflectedDataComponents::ForEach([&scene, &dependencies]<class Component>() {
+    for (const auto view = scene->GetAllEntitiesWith<Component>();
+         const auto entity : view)
+      internal::CollectComponentDependencies(
+          view.template get<Component>(entity), dependencies);
+  });
+  for (const auto view = scene->GetAllEntitiesWith<ScriptComponent>();
+       const auto entity : view)
+    dependencies.push_back(
+        view.get<ScriptComponent>(entity).script_class_handle);
+}
+
+void SceneSerializer::CollectDependencies(
+    const YAML::Node& entities_node, std::vector<AssetHandle>& dependencies) {
+  for (const auto& entity : entities_node)
+    internal::CollectEntityDependencies(entity, dependencies);
+}
+
 bool SceneSerializer::DeserializeFromYAML(const std::string& yaml_str) {
   YAML::Node data = YAML::Load(yaml_str);
 
@@ -428,7 +449,14 @@ bool SceneSerializer::DeserializeFromYAML(const std::string& yaml_str) {
   BE_CORE_INFO("デシリアライズシーン {0}", scene_name.c_str());
   scene_->SetName(scene_name);
 
-  if (auto entities = data["Entities"])
+  if (auto entities = data["Entities"]) {
+    // コンポーネントを作る前に、参照しているアセットをまとめて読み込んでおく
+    std::vector<AssetHandle> dependencies;
+    CollectDependencies(entities, dependencies);
+    AssetManager::PrefetchAssets(dependencies);
+
     internal::DeserializeEntities(entities, scene_);
+  }
+  return true;
 }
 }  // namespace base_engine
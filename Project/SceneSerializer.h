@@ -7,6 +7,7 @@
 
 #pragma once
 #include <filesystem>
+#include <vector>
 
 #include "ObjectEntity.h"
 #include "Scene.h"
@@ -24,6 +25,7 @@ class SceneSerializer {
   /**
    * \brief Scene内のオブジェクトをシリアライズ化し、指定パスに
    * .bsceneファイルの保存を行う。\n
+   * 拡張子が .bsceneb の場合はバイナリ形式 (SceneBinarySerializer) で保存する。\n
    * スクリプトのフィールドは、publicなどEditor側からアクセス可能な可視性レベルのものにたいしてシリアライズ化が行われる。
    * \param scene_file_path 保存先のファイルパス
    */
@@ -34,12 +36,25 @@ class SceneSerializer {
 
   /**
    * \brief 指定パス先のファイルを読み取り、Sceneオブジェクトをロードする。
+   * 拡張子が .bsceneb の場合はバイナリ形式として読み込む。
    * \param filepath 読み込み先のファイルパス
    * \return true :読み込み成功 \n false :読み込み失敗時
    */
   bool Deserialize(const std::filesystem::path& filepath);
 
   static void DeserializeEntities(YAML::Node& entities_node, const Ref<Scene>& scene);
+
+  /**
+   * \brief シーン内のコンポーネントが参照しているアセットのハンドルを集める
+   */
+  static void CollectDependencies(const Ref<Scene>& scene,
+                                  std::vector<AssetHandle>& dependencies);
+  /**
+   * \brief シリアライズ済みのエンティティ列から、コンポーネントを作らずに
+   * 参照しているアセットのハンドルを集める
+   */
+  static void CollectDependencies(const YAML::Node& entities_node,
+                                  std::vector<AssetHandle>& dependencies);
  private:
   void SerializeToYAML(YAML::Emitter& out);
   bool DeserializeFromYAML(const std::string& yaml_str);
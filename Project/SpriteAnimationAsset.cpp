@@ -0,0 +1,97 @@
+﻿#include "SpriteAnimationAsset.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpriteAnimationClipLoader.h"
+
+namespace base_engine {
+SpriteAnimationAsset::SpriteAnimationAsset(
+    const std::span<const SpriteAnimationClip> clips) {
+  clips_.reserve(clips.size());
+  for (const auto& clip : clips) {
+    SpriteAnimationClipRange range{clip.name,
+                                   static_cast<uint32_t>(frames_.size()), 0,
+                                   0.0f, clip.is_loop};
+    // wait が 0 以下のパターンで打ち切るのは旧実装と同じ
+    for (const auto& pattern : clip.pattern) {
+      if (pattern.wait <= 0) break;
+      const float x = clip.offset_x + clip.width * pattern.no;
+      const float y = clip.offset_y + clip.height * pattern.step;
+      range.duration += pattern.wait / kPatternFrameRate;
+      frames_.push_back(
+          {x, y, x + clip.width, y + clip.height, range.duration});
+    }
+    if (frames_.size() == range.first_frame) {
+      frames_.push_back({clip.offset_x, clip.offset_y,
+                         clip.offset_x + clip.width,
+                         clip.offset_y + clip.height, 0.0f});
+    }
+    range.frame_count =
+        static_cast<uint32_t>(frames_.size()) - range.first_frame;
+    clips_.emplace_back(std::move(range));
+  }
+}
+
+uint32_t SpriteAnimationAsset::FindClip(const std::string_view name) const {
+  for (uint32_t i = 0; i < clips_.size(); ++i) {
+    if (clips_[i].name == name) return i;
+  }
+  return kInvalidClip;
+}
+
+uint32_t SpriteAnimationAsset::SampleFrame(const uint32_t clip,
+                                           float time) const {
+  const auto& range = clips_[clip];
+  if (range.duration <= 0.0f) return range.first_frame;
+  time = range.is_loop ? std::fmod(time, range.duration)
+                       : std::min(time, range.duration);
+
+  const auto first = frames_.begin() + range.first_frame;
+  const auto last = first + range.frame_count;
+  const auto it = std::upper_bound(
+      first, last, time, [](const float t, const SpriteAnimationFrame& frame) {
+        return t < frame.end_time;
+      });
+  // 非ループで終端に達したら最後のフレームで止める
+  const auto index = (it == last) ? range.frame_count - 1
+                                  : static_cast<uint32_t>(it - first);
+  return range.first_frame + index;
+}
+
+Ref<SpriteAnimationAsset> SpriteAnimationUtilities::Create(
+    const std::filesystem::path& path) {
+  const auto clips =
+      SpriteAnimationClipLoader::Load(path.generic_string().c_str());
+  return Ref<SpriteAnimationAsset>::Create(clips);
+}
+
+Ref<SpriteAnimationAsset> SpriteAnimationUtilities::Create(
+    const std::span<const std::byte> data) {
+  const auto clips = SpriteAnimationClipLoader::Load(data);
+  return Ref<SpriteAnimationAsset>::Create(clips);
+}
+
+bool SpriteAnimationSerializer::TryLoadData(const AssetMetadata& metadata,
+                                            Ref<Asset>& asset) const {
+  asset = SpriteAnimationUtilities::Create(metadata.file_path);
+  asset->handle_ = metadata.handle;
+  return true;
+}
+
+bool SpriteAnimationSerializer::TryLoadDataFromMemory(
+    const AssetMetadata& metadata, const std::span<const std::byte> data,
+    Ref<Asset>& asset) const {
+  asset = SpriteAnimationUtilities::Create(data);
+  asset->handle_ = metadata.handle;
+  return true;
+}
+
+std::string SpriteAnimationSerializer::GetAssetType(
+    const std::filesystem::path& path) const {
+  if (path.extension() == ".banim") {
+    return "SpriteAnimation";
+  }
+  return "";
+}
+}  // namespace base_engine
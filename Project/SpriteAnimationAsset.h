@@ -0,0 +1,125 @@
+﻿// @SpriteAnimationAsset.h
+// @brief
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Asset.h"
+#include "AssetSerializer.h"
+#include "ISpriteAnimationComponent.h"
+
+namespace base_engine {
+/**
+ * \brief 1フレーム分の切り出し範囲(ピクセル)とクリップ先頭からの終了時刻(秒)
+ */
+struct SpriteAnimationFrame {
+  float left;
+  float top;
+  float right;
+  float bottom;
+  float end_time;
+};
+
+/**
+ * \brief frames_ のうち1クリップが使う範囲
+ */
+struct SpriteAnimationClipRange {
+  std::string name;
+  uint32_t first_frame;
+  uint32_t frame_count;
+  float duration;
+  bool is_loop;
+};
+
+/**
+ * \brief 複数インスタンスで共有する不変のアニメーションクリップ
+ * 全クリップのフレームを1つの配列に詰めて持つ
+ */
+class SpriteAnimationAsset : public Asset {
+ public:
+  static constexpr uint32_t kInvalidClip = UINT32_MAX;
+  //! AnimationPattern::wait の単位。旧実装の固定FPSに合わせる
+  static constexpr float kPatternFrameRate = 60.0f;
+
+  explicit SpriteAnimationAsset(std::span<const SpriteAnimationClip> clips);
+
+  static AssetType GetStaticType() { return AssetType::kSpriteAnimation; }
+  AssetType GetAssetType() const override {
+    return AssetType::kSpriteAnimation;
+  }
+
+  /**
+   * \brief 名前からクリップ番号を探す
+   * \return 見つからなければ kInvalidClip
+   */
+  [[nodiscard]] uint32_t FindClip(std::string_view name) const;
+
+  /**
+   * \brief クリップ内の経過時間から表示するフレーム番号を求める
+   * \param clip クリップ番号
+   * \param time クリップ先頭からの経過時間(秒)
+   * \return frames_ 全体での添え字
+   */
+  [[nodiscard]] uint32_t SampleFrame(uint32_t clip, float time) const;
+
+  [[nodiscard]] const SpriteAnimationFrame& GetFrame(const uint32_t frame) const {
+    return frames_[frame];
+  }
+  [[nodiscard]] const SpriteAnimationClipRange& GetClip(
+      const uint32_t clip) const {
+    return clips_[clip];
+  }
+  [[nodiscard]] uint32_t GetClipCount() const {
+    return static_cast<uint32_t>(clips_.size());
+  }
+  size_t GetMemorySize() const override {
+    return frames_.capacity() * sizeof(SpriteAnimationFrame) +
+           clips_.capacity() * sizeof(SpriteAnimationClipRange);
+  }
+
+ private:
+  std::vector<SpriteAnimationFrame> frames_;
+  std::vector<SpriteAnimationClipRange> clips_;
+};
+
+class SpriteAnimationUtilities {
+ public:
+  static Ref<SpriteAnimationAsset> Create(const std::filesystem::path& path);
+  static Ref<SpriteAnimationAsset> Create(std::span<const std::byte> data);
+};
+
+class SpriteAnimationSerializer : public AssetSerializer,
+                                  public AsyncAssetSerializer,
+                                  public MemoryAssetSerializer {
+ public:
+  void Serialize(const AssetMetadata& metadata,
+                 const Ref<Asset>& asset) const override {}
+  bool TryLoadData(const AssetMetadata& metadata,
+                   Ref<Asset>& asset) const override;
+  /// ファイルの読み込みだけなので全てワーカーで行う
+  bool TryLoadDataAsync(const AssetMetadata& metadata,
+                        Ref<Asset>& asset) const override {
+    return TryLoadData(metadata, asset);
+  }
+  bool FinalizeData(const AssetMetadata& metadata,
+                    Ref<Asset>& asset) const override {
+    return true;
+  }
+  bool TryLoadDataFromMemory(const AssetMetadata& metadata,
+                             std::span<const std::byte> data,
+                             Ref<Asset>& asset) const override;
+
+  void GetRecognizedExtensions(
+      std::list<std::string>* extensions) const override {
+    extensions->push_back(".banim");
+  }
+
+  std::string GetAssetType(const std::filesystem::path& path) const override;
+};
+}  // namespace base_engine
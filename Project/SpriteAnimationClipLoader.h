@@ -7,9 +7,12 @@
 
 #pragma once
 #include <fstream>
+#include <istream>
+#include <span>
 
 #include "BinaryArchive.h"
 #include "ISpriteAnimationComponent.h"
+#include "MemoryStreamBuffer.h"
 #include "VectorFrozen.h"
 #include "SpriteAnimationClipFrozen.h"
 
@@ -26,4 +29,16 @@ class SpriteAnimationClipLoader {
     }
     return sprite_animation_clips;
   }
+  static std::vector<base_engine::SpriteAnimationClip> Load(
+      const std::span<const std::byte> data) {
+    std::vector<base_engine::SpriteAnimationClip> sprite_animation_clips;
+
+    {
+      base_engine::MemoryStreamBuffer buffer(data);
+      std::istream stream(&buffer);
+      frozen::BinaryInputArchive archive(stream);
+      archive(sprite_animation_clips);
+    }
+    return sprite_animation_clips;
+  }
 };
@@ -0,0 +1,46 @@
+﻿// @SpriteAnimatorComponent.h
+// @brief
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include "Asset.h"
+#include "Ref.h"
+#include "SpriteAnimationAsset.h"
+#include "Vector2.h"
+
+namespace base_engine::component {
+/**
+ * \brief 共有の SpriteAnimationAsset を参照して再生位置だけを持つ
+ * 同じ Entity の SpriteRendererComponent の UV を書き換える
+ */
+struct SpriteAnimatorComponent {
+  AssetHandle animation = kNullUuid;
+  uint32_t clip = 0;
+  float time = 0.0f;
+  float speed = 1.0f;
+  bool is_playing = true;
+
+  //! 以下は実行時キャッシュ。animation が変わると作り直す
+  Ref<SpriteAnimationAsset> clip_set;
+  //! 最後に UV へ書き込んだフレーム。変化したときだけ書き換える
+  uint32_t current_frame = SpriteAnimationAsset::kInvalidClip;
+  //! テクスチャサイズの逆数。ピクセル座標を UV に変換する
+  Vector2 inverse_texture_size{0.0f, 0.0f};
+  //! inverse_texture_size を求めたテクスチャ。SpriteRendererComponent の
+  //! テクスチャと違えば求め直す
+  AssetHandle texture = kNullUuid;
+
+  SpriteAnimatorComponent() = default;
+  SpriteAnimatorComponent(const SpriteAnimatorComponent& other) = default;
+
+  void Play(const uint32_t clip_index) {
+    clip = clip_index;
+    time = 0.0f;
+    is_playing = true;
+    current_frame = SpriteAnimationAsset::kInvalidClip;
+  }
+};
+}  // namespace base_engine::component
@@ -20,6 +20,11 @@ struct SpriteRendererComponent {
 
   float tiling_factor = 1.0f;
 
+  // 描画のレイヤー。大きいほど手前に描画される。0 はパーティクルと共有する
+  uint8_t layer = 0;
+  // 動かないスプライト。レイヤーのスプライトが全て静的なら、レイヤーの描画結果を使い回す
+  bool is_static = false;
+
   SpriteRendererComponent() = default;
   SpriteRendererComponent(const SpriteRendererComponent& other) = default;
 };
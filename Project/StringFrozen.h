@@ -6,6 +6,7 @@
 // @details
 
 #pragma once
+#include <algorithm>
 #include <string>
 
 #include "FrozenConcept.h"
@@ -25,10 +26,24 @@ template <class Archive, class CharT, class Traits, class Alloc>
 requires NotDuplicationSerializeLoad<BinaryData<CharT>, Archive>
 void FROZEN_LOAD_FUNCTION_NAME(Archive &ar,
                                std::basic_string<CharT, Traits, Alloc> &str) {
-  SizeType size;
+  SizeType size = 0;
   ar(make_size_tag(size));
-  str.resize(static_cast<std::size_t>(size));
-  ar(binary_data(const_cast<CharT *>(str.data()),
-                 static_cast<std::size_t>(size) * sizeof(CharT)));
+  if constexpr (requires { ar.IsFailed(); }) {
+    // 壊れたサイズで巨大な確保をしないよう、読めた分だけ伸ばす
+    constexpr SizeType chunk = 1024 * 1024 / sizeof(CharT);
+    str.clear();
+    for (SizeType loaded = 0; loaded < size && !ar.IsFailed();) {
+      const auto count = std::min(size - loaded, chunk);
+      str.resize(static_cast<std::size_t>(loaded + count));
+      ar(binary_data(str.data() + loaded,
+                     static_cast<std::size_t>(count) * sizeof(CharT)));
+      loaded += count;
+    }
+    if (ar.IsFailed()) str.clear();
+  } else {
+    str.resize(static_cast<std::size_t>(size));
+    ar(binary_data(const_cast<CharT *>(str.data()),
+                   static_cast<std::size_t>(size) * sizeof(CharT)));
+  }
 }
 }  // namespace frozen
\ No newline at end of file
@@ -1,4 +1,9 @@
-#pragma once
+﻿#pragma once
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
 #include "FrozenHelper.h"
 #include "frozen.h"
 
@@ -16,48 +21,135 @@ class TextOutputArchive : public frozen::OutputArchive<TextOutputArchive> {
  private:
   std::ostream& its_writer_;
 };
+/**
+ * \brief トークンが足りないか、要求された型として読めなかったときに投げる。
+ * line と column は問題のトークンの位置で、1 から数える
+ */
+class TextArchiveError : public std::runtime_error {
+ public:
+  TextArchiveError(const std::string& message, const size_t line,
+                   const size_t column)
+      : std::runtime_error(message + " at line " + std::to_string(line) +
+                           ", column " + std::to_string(column)),
+        line(line),
+        column(column) {}
+
+  size_t line;
+  size_t column;
+};
+
+/**
+ * \brief ストリームを一度だけ全て読み込み、空白で区切ったトークンを
+ * バッファへの参照として取り出す。数値は std::from_chars で読む。
+ */
 class TextInputArchive : public frozen::InputArchive<TextInputArchive> {
  public:
   explicit TextInputArchive(std::istream& stream)
-      : InputArchive<TextInputArchive>(this), its_writer_(stream) {}
+      : InputArchive<TextInputArchive>(this) {
+    constexpr std::streamsize kReadChunk = 64 * 1024;
+    for (size_t size = 0;;) {
+      buffer_.resize(size + kReadChunk);
+      const auto read =
+          stream.rdbuf()->sgetn(buffer_.data() + size, kReadChunk);
+      size += static_cast<size_t>(read);
+      if (read < kReadChunk) {
+        buffer_.resize(size);
+        break;
+      }
+    }
+  }
   template <class T>
   inline void LoadText(T& data, std::streamsize size) {
-    std::string s;
-    its_writer_ >> s;
-    LoadType(data, s);
+    LoadType(data, NextToken());
   }
-  void LoadType(std::string& data, const std::string& str) const { data = str; }
-  void LoadType(int& data, const std::string& str) const {
-    data = std::stoi(str);
+  void LoadType(std::string& data, const std::string_view str) const {
+    data = str;
   }
-  void LoadType(double& data, const std::string& str) const {
-    data = std::stod(str);
+  void LoadType(int& data, const std::string_view str) const {
+    Parse(data, str, "int");
   }
-  void LoadType(float& data, const std::string& str) const {
-    data = std::stof(str);
+  void LoadType(double& data, const std::string_view str) const {
+    Parse(data, str, "double");
   }
-  void LoadType(long& data, const std::string& str) const {
-    data = std::stol(str);
+  void LoadType(float& data, const std::string_view str) const {
+    Parse(data, str, "float");
   }
-  void LoadType(long double& data, const std::string& str) const {
-    data = std::stold(str);
+  void LoadType(long& data, const std::string_view str) const {
+    Parse(data, str, "long");
   }
-  void LoadType(long long& data, const std::string& str) const {
-    data = std::stoll(str);
+  void LoadType(long double& data, const std::string_view str) const {
+    Parse(data, str, "long double");
   }
-  void LoadType(unsigned long& data, const std::string& str) const {
-    data = std::stoul(str);
+  void LoadType(long long& data, const std::string_view str) const {
+    Parse(data, str, "long long");
   }
-  void LoadType(unsigned long long& data, const std::string& str) const {
-    data = std::stoull(str);
+  void LoadType(unsigned long& data, const std::string_view str) const {
+    Parse(data, str, "unsigned long");
+  }
+  void LoadType(unsigned long long& data, const std::string_view str) const {
+    Parse(data, str, "unsigned long long");
   }
 
-  void LoadType(char& data, const std::string& str) const {
-    data = std::stoi(str);
+  // char は数値として書かれているので、std::stoi と同じように切り詰める
+  void LoadType(char& data, const std::string_view str) const {
+    int value;
+    Parse(value, str, "char");
+    data = static_cast<char>(value);
   }
 
  private:
-  std::istream& its_writer_;
+  static bool IsSpace(const char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' ||
+           c == '\f';
+  }
+
+  std::string_view NextToken() {
+    while (position_ < buffer_.size() && IsSpace(buffer_[position_]))
+      ++position_;
+    const auto begin = position_;
+    while (position_ < buffer_.size() && !IsSpace(buffer_[position_]))
+      ++position_;
+    token_begin_ = begin;
+    if (begin == position_) Fail("unexpected end of text");
+    return std::string_view(buffer_).substr(begin, position_ - begin);
+  }
+
+  // std::sto* と同じく先頭の '+' を受け付け、数値の後ろは無視する。
+  // 符号なしの型に負の値を読むと strtoul と同じように折り返す
+  template <class T>
+  void Parse(T& data, std::string_view str, const char* type) const {
+    if (!str.empty() && str.front() == '+') str.remove_prefix(1);
+    const auto first = str.data();
+    const auto last = str.data() + str.size();
+    std::from_chars_result result;
+    if constexpr (std::is_unsigned_v<T>) {
+      const bool negative = !str.empty() && str.front() == '-';
+      result = std::from_chars(first + negative, last, data);
+      if (negative && result.ec == std::errc{}) data = static_cast<T>(0 - data);
+    } else {
+      result = std::from_chars(first, last, data);
+    }
+    if (result.ec == std::errc::invalid_argument)
+      Fail("expected " + std::string(type) + " but got \"" +
+           std::string(str) + "\"");
+    if (result.ec == std::errc::result_out_of_range)
+      Fail("\"" + std::string(str) + "\" is out of range for " + type);
+  }
+
+  [[noreturn]] void Fail(const std::string& message) const {
+    size_t line = 1;
+    size_t line_begin = 0;
+    for (size_t i = 0; i < token_begin_; ++i) {
+      if (buffer_[i] != '\n') continue;
+      ++line;
+      line_begin = i + 1;
+    }
+    throw TextArchiveError(message, line, token_begin_ - line_begin + 1);
+  }
+
+  std::string buffer_;
+  size_t position_ = 0;
+  size_t token_begin_ = 0;
 };
 template <class T>
 requires std::is_fundamental_v<T>
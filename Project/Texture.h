@@ -21,6 +21,12 @@ class TextureUtility {
   static Ref<Texture> Create(const std::filesystem::path& path);
 };
 
+/**
+ * \brief テクスチャのシリアライザ
+ * Mof のテクスチャ作成はスレッドセーフが保証されておらず、MofTexture は
+ * ファイルパスから作るので AsyncAssetSerializer は継承しない。GetAssetAsync で要求した
+ * テクスチャは UpdateStreaming の時間予算の中でメインスレッドで読み込まれる
+ */
 class TextureSerializer : public AssetSerializer {
  public:
   void Serialize(const AssetMetadata& metadata,
@@ -0,0 +1,88 @@
+﻿#include "TextureAtlas.h"
+
+#include <Mof.h>
+#include <Utilities/GraphicsUtilities.h>
+
+#include "Log.h"
+#include "MofBlendState.h"
+#include "TextureAtlasPacker.h"
+
+namespace base_engine {
+TextureAtlas::TextureAtlas(const uint32_t page_size) : page_size_(page_size) {}
+
+TextureAtlas::~TextureAtlas() { Release(); }
+
+bool TextureAtlas::Build(const std::vector<TextureAtlasSource>& sources) {
+  Release();
+
+  std::vector<AtlasPackInput> inputs;
+  std::unordered_map<uint64_t, Mof::LPTexture> textures;
+  inputs.reserve(sources.size());
+  for (const auto& source : sources) {
+    if (!source.texture || textures.contains(source.handle)) continue;
+    textures.emplace(source.handle, source.texture);
+    inputs.push_back({source.handle, source.texture->GetWidth(),
+                      source.texture->GetHeight()});
+  }
+
+  TextureAtlasPacker packer(page_size_, page_size_);
+  std::vector<uint64_t> rejected;
+  const auto regions = packer.Pack(std::move(inputs), &rejected);
+  if (regions.empty()) {
+    return false;
+  }
+  for (const auto handle : rejected) {
+    BE_CORE_INFO("UUID:{0} テクスチャがアトラスのページより大きいため登録しません。",
+                 handle);
+  }
+
+  for (uint32_t i = 0; i < packer.GetPageCount(); ++i) {
+    auto page = std::make_unique<Mof::CTexture>();
+    page->CreateTarget(page_size_, page_size_, PIXELFORMAT_R8G8B8A8_UNORM,
+                       BUFFERACCESS_GPUREADWRITE);
+    pages_.emplace_back(std::move(page));
+  }
+
+  // ページごとに描画ターゲットを切り替えて描き込む。
+  // 半透明の画素を透明な下地と混ぜると色とアルファが変わるので、そのまま写す
+  D3D11_RENDER_TARGET_BLEND_DESC copy{};
+  copy.BlendEnable = FALSE;
+  copy.RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
+  const auto copy_state = CreateBlendState(copy);
+  const ScopedBlendState blend_scope(copy_state.Get());
+  const auto hold_render_target = g_pGraphics->GetRenderTarget();
+  for (uint32_t page_index = 0; page_index < pages_.size(); ++page_index) {
+    const auto page = pages_[page_index].get();
+    g_pGraphics->SetRenderTarget(page->GetRenderTarget(),
+                                 g_pGraphics->GetDepthTarget());
+    g_pGraphics->ClearTarget(0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0);
+    for (const auto& region : regions) {
+      if (region.page != page_index) continue;
+      Mof::CGraphicsUtilities::RenderTexture(
+          static_cast<float>(region.x), static_cast<float>(region.y),
+          textures[region.id]);
+      entries_[region.id] = {
+          page,
+          {static_cast<float>(region.x), static_cast<float>(region.y),
+           static_cast<float>(region.x + region.width),
+           static_cast<float>(region.y + region.height)}};
+    }
+  }
+  g_pGraphics->SetRenderTarget(hold_render_target,
+                               g_pGraphics->GetDepthTarget());
+  return true;
+}
+
+const TextureAtlasEntry* TextureAtlas::Find(const AssetHandle handle) const {
+  const auto it = entries_.find(handle);
+  return it == entries_.end() ? nullptr : &it->second;
+}
+
+void TextureAtlas::Release() {
+  entries_.clear();
+  for (const auto& page : pages_) {
+    page->Release();
+  }
+  pages_.clear();
+}
+}  // namespace base_engine
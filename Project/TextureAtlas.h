@@ -0,0 +1,68 @@
+﻿// @TextureAtlas.h
+// @brief 実行時に作るテクスチャアトラス
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// TextureAtlasPacker で求めた配置に従って、複数のテクスチャを
+// 描画ターゲットのページに描き込む。
+
+#pragma once
+#include <Graphics/DirectX11/DX11Texture.h>
+#include <Graphics/Texture.h>
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "Asset.h"
+
+namespace base_engine {
+struct TextureAtlasSource {
+  AssetHandle handle = kNullUuid;
+  Mof::LPTexture texture = nullptr;
+};
+
+struct TextureAtlasEntry {
+  Mof::LPTexture page = nullptr;
+  // ページ内の元テクスチャの位置(ピクセル)
+  Mof::Rectangle rect;
+};
+
+class TextureAtlas {
+ public:
+  static constexpr uint32_t kDefaultPageSize = 2048;
+
+  explicit TextureAtlas(uint32_t page_size = kDefaultPageSize);
+  ~TextureAtlas();
+
+  TextureAtlas(const TextureAtlas&) = delete;
+  TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+  /**
+   * \brief テクスチャをページに詰めて描き込みます。
+   * 描画ターゲットを切り替えるため、描画が可能な状態で呼び出してください。
+   * ページに入らない大きさのテクスチャは登録されません。
+   * \return 1つでも登録できたら true
+   */
+  bool Build(const std::vector<TextureAtlasSource>& sources);
+
+  /**
+   * \brief アトラスに登録されたテクスチャの位置を返します。
+   * \return 登録されていなければ nullptr
+   */
+  [[nodiscard]] const TextureAtlasEntry* Find(AssetHandle handle) const;
+
+  void Release();
+
+  [[nodiscard]] uint32_t GetPageCount() const {
+    return static_cast<uint32_t>(pages_.size());
+  }
+  [[nodiscard]] size_t GetEntryCount() const { return entries_.size(); }
+
+ private:
+  uint32_t page_size_;
+  std::vector<std::unique_ptr<Mof::CTexture>> pages_;
+  std::unordered_map<AssetHandle, TextureAtlasEntry> entries_;
+};
+}  // namespace base_engine
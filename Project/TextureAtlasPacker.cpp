@@ -0,0 +1,145 @@
+﻿#include "TextureAtlasPacker.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace base_engine {
+TextureAtlasPacker::TextureAtlasPacker(const uint32_t page_width,
+                                       const uint32_t page_height,
+                                       const uint32_t padding)
+    : page_width_(page_width), page_height_(page_height), padding_(padding) {}
+
+bool TextureAtlasPacker::Insert(const AtlasPackInput& input,
+                                AtlasRegion& region) {
+  // ページ端は詰めてもよいので、右と下の余白だけ確保する
+  const uint32_t width = std::min(input.width + padding_, page_width_);
+  const uint32_t height = std::min(input.height + padding_, page_height_);
+  if (input.width == 0 || input.height == 0 || input.width > page_width_ ||
+      input.height > page_height_) {
+    return false;
+  }
+
+  FreeRect position{};
+  uint32_t page_index = 0;
+  for (; page_index < pages_.size(); ++page_index) {
+    if (FindPosition(pages_[page_index], width, height, position)) break;
+  }
+  if (page_index == pages_.size()) {
+    pages_.emplace_back(CreatePage());
+    if (!FindPosition(pages_.back(), width, height, position)) {
+      pages_.pop_back();
+      return false;
+    }
+  }
+
+  Page& page = pages_[page_index];
+  PlaceRect(page, position);
+  page.used_area += static_cast<uint64_t>(input.width) * input.height;
+  region = {input.id,   page_index,  position.x,
+            position.y, input.width, input.height};
+  return true;
+}
+
+std::vector<AtlasRegion> TextureAtlasPacker::Pack(
+    std::vector<AtlasPackInput> inputs, std::vector<uint64_t>* rejected) {
+  std::ranges::stable_sort(inputs, [](const AtlasPackInput& a,
+                                      const AtlasPackInput& b) {
+    const uint64_t area_a = static_cast<uint64_t>(a.width) * a.height;
+    const uint64_t area_b = static_cast<uint64_t>(b.width) * b.height;
+    if (area_a != area_b) return area_a > area_b;
+    return std::max(a.width, a.height) > std::max(b.width, b.height);
+  });
+
+  std::vector<AtlasRegion> regions;
+  regions.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    if (AtlasRegion region; Insert(input, region)) {
+      regions.emplace_back(region);
+    } else if (rejected) {
+      rejected->emplace_back(input.id);
+    }
+  }
+  return regions;
+}
+
+void TextureAtlasPacker::Clear() { pages_.clear(); }
+
+float TextureAtlasPacker::GetOccupancy(const uint32_t page) const {
+  if (page >= pages_.size()) return 0.0f;
+  return static_cast<float>(pages_[page].used_area) /
+         (static_cast<float>(page_width_) * static_cast<float>(page_height_));
+}
+
+bool TextureAtlasPacker::FindPosition(const Page& page, const uint32_t width,
+                                      const uint32_t height,
+                                      FreeRect& result) const {
+  uint32_t best_short = std::numeric_limits<uint32_t>::max();
+  uint32_t best_long = std::numeric_limits<uint32_t>::max();
+  for (const auto& free : page.free_rects) {
+    if (free.width < width || free.height < height) continue;
+    const uint32_t leftover_x = free.width - width;
+    const uint32_t leftover_y = free.height - height;
+    const uint32_t short_side = std::min(leftover_x, leftover_y);
+    const uint32_t long_side = std::max(leftover_x, leftover_y);
+    if (short_side < best_short ||
+        (short_side == best_short && long_side < best_long)) {
+      best_short = short_side;
+      best_long = long_side;
+      result = {free.x, free.y, width, height};
+    }
+  }
+  return best_short != std::numeric_limits<uint32_t>::max();
+}
+
+void TextureAtlasPacker::PlaceRect(Page& page, const FreeRect& used) {
+  std::vector<FreeRect> next;
+  next.reserve(page.free_rects.size() + 4);
+  for (const auto& free : page.free_rects) {
+    // 重ならない空き領域はそのまま残す
+    if (used.x >= free.x + free.width || used.x + used.width <= free.x ||
+        used.y >= free.y + free.height || used.y + used.height <= free.y) {
+      next.emplace_back(free);
+      continue;
+    }
+    // 重なった空き領域を、使った矩形の上下左右の最大の矩形に分割する
+    if (used.x > free.x) {
+      next.push_back({free.x, free.y, used.x - free.x, free.height});
+    }
+    if (used.x + used.width < free.x + free.width) {
+      next.push_back({used.x + used.width, free.y,
+                      free.x + free.width - (used.x + used.width),
+                      free.height});
+    }
+    if (used.y > free.y) {
+      next.push_back({free.x, free.y, free.width, used.y - free.y});
+    }
+    if (used.y + used.height < free.y + free.height) {
+      next.push_back({free.x, used.y + used.height, free.width,
+                      free.y + free.height - (used.y + used.height)});
+    }
+  }
+
+  // 他の空き領域に含まれるものを取り除く
+  const auto contains = [](const FreeRect& outer, const FreeRect& inner) {
+    return inner.x >= outer.x && inner.y >= outer.y &&
+           inner.x + inner.width <= outer.x + outer.width &&
+           inner.y + inner.height <= outer.y + outer.height;
+  };
+  page.free_rects.clear();
+  for (size_t i = 0; i < next.size(); ++i) {
+    bool redundant = false;
+    for (size_t j = 0; j < next.size() && !redundant; ++j) {
+      if (i == j || !contains(next[j], next[i])) continue;
+      // 同じ矩形が重複している場合は先にあるものを残す
+      redundant = !contains(next[i], next[j]) || j < i;
+    }
+    if (!redundant) page.free_rects.emplace_back(next[i]);
+  }
+}
+
+TextureAtlasPacker::Page TextureAtlasPacker::CreatePage() const {
+  Page page;
+  page.free_rects.push_back({0, 0, page_width_, page_height_});
+  return page;
+}
+}  // namespace base_engine
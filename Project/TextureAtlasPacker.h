@@ -0,0 +1,89 @@
+﻿// @TextureAtlasPacker.h
+// @brief テクスチャアトラスの配置を求める
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// MaxRects 法(Best Short Side Fit)で矩形をページに詰める。
+// グラフィックスライブラリに依存しないので、ヘッドレス環境でも使える。
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+namespace base_engine {
+struct AtlasPackInput {
+  uint64_t id = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+};
+
+struct AtlasRegion {
+  uint64_t id = 0;
+  uint32_t page = 0;
+  uint32_t x = 0;
+  uint32_t y = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+};
+
+class TextureAtlasPacker {
+ public:
+  /**
+   * \param page_width ページの幅
+   * \param page_height ページの高さ
+   * \param padding 矩形どうしの間に空ける幅(滲み防止)
+   */
+  TextureAtlasPacker(uint32_t page_width, uint32_t page_height,
+                     uint32_t padding = 2);
+
+  /**
+   * \brief 矩形を1つ配置します。入るページがなければ新しいページを作ります。
+   * \return ページより大きい場合は false
+   */
+  bool Insert(const AtlasPackInput& input, AtlasRegion& region);
+
+  /**
+   * \brief 面積の大きい順にまとめて配置します。
+   * \param inputs 配置する矩形
+   * \param rejected ページに入らなかった矩形の id (nullptr 可)
+   * \return 配置した矩形
+   */
+  std::vector<AtlasRegion> Pack(std::vector<AtlasPackInput> inputs,
+                                std::vector<uint64_t>* rejected = nullptr);
+
+  void Clear();
+
+  [[nodiscard]] uint32_t GetPageCount() const {
+    return static_cast<uint32_t>(pages_.size());
+  }
+  [[nodiscard]] uint32_t GetPageWidth() const { return page_width_; }
+  [[nodiscard]] uint32_t GetPageHeight() const { return page_height_; }
+
+  /// ページの使用率 (0〜1)
+  [[nodiscard]] float GetOccupancy(uint32_t page) const;
+
+ private:
+  struct FreeRect {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+  };
+
+  struct Page {
+    std::vector<FreeRect> free_rects;
+    uint64_t used_area = 0;
+  };
+
+  [[nodiscard]] bool FindPosition(const Page& page, uint32_t width,
+                                  uint32_t height, FreeRect& result) const;
+  static void PlaceRect(Page& page, const FreeRect& used);
+  [[nodiscard]] Page CreatePage() const;
+
+  uint32_t page_width_;
+  uint32_t page_height_;
+  uint32_t padding_;
+  std::vector<Page> pages_;
+};
+}  // namespace base_engine
@@ -1,22 +1,24 @@
 ﻿#include "TextureMof.h"
 
-#include <filesystem>
-#include <fstream>
-#include <ranges>
 #include <Utilities/Utilities.h>
 
+#include <memory>
+
+#include "Log.h"
+
 namespace base_engine {
 namespace {
+//! ホットリロードでファイルの更新時刻を確認する間隔(秒)
+constexpr float kHotReloadInterval = 1.0f;
+
 std::string PathToLocalStringPath(const std::filesystem::path& path) {
   return path.lexically_normal().generic_string();
 }
-size_t StringToHash(const std::string_view str)
-{
-  return std::hash<std::string_view>{}(str);
-}
 }  // namespace
 TextureMof::TextureMof() {
-    textures_.reserve(128);
+  slots_.reserve(128);
+  handles_.reserve(128);
+  aliases_.reserve(128);
 }
 
 TextureMof::~TextureMof()
@@ -32,44 +34,113 @@ bool TextureMof::Load(std::string_view name) {
   }
   const std::filesystem::path local_path = name;
   if (!exists(local_path)) return false;
-  const std::string texture_normal_path = PathToLocalStringPath(local_path);
-  const auto hash = StringToHash(texture_normal_path);
+  std::string texture_normal_path = PathToLocalStringPath(local_path);
 
-  if (textures_.contains(hash)) return false;
+  const auto it = handles_.find(texture_normal_path);
+  if (it != handles_.end() && slots_[it->second].texture) return false;
 
   auto texture = new Mof::CTexture;
   if (!texture->Load(texture_normal_path.data())) {
     delete texture;
     return false;
   }
-  
-  textures_.insert({hash, texture});
+
+  std::error_code error;
+  const auto write_time = last_write_time(local_path, error);
+  if (it != handles_.end()) {
+    // Release 済みの枠を再利用してハンドルを変えない
+    slots_[it->second].texture = texture;
+    slots_[it->second].write_time = write_time;
+    return true;
+  }
+  handles_.emplace(texture_normal_path, slots_.size());
+  slots_.push_back({texture, std::move(texture_normal_path), write_time});
   return true;
 }
 
+TextureHandle TextureMof::Resolve(std::string_view name) {
+  if (const auto it = aliases_.find(name); it != aliases_.end()) {
+    return {it->second};
+  }
+  const auto it = handles_.find(PathToLocalStringPath(name));
+  if (it == handles_.end()) return {};
+  aliases_.emplace(name, it->second);
+  return {it->second};
+}
+
+TexturePtr TextureMof::Get(const TextureHandle handle) {
+  if (handle.handle >= slots_.size() || !slots_[handle.handle].texture) {
+    return &none_texture_;
+  }
+  return slots_[handle.handle].texture;
+}
+
 TexturePtr TextureMof::Get(std::string_view name) {
-  const std::filesystem::path local_path = name;
-  if (!exists(local_path)) return &none_texture_;
-  const std::string texture_normal_path = PathToLocalStringPath(local_path);
-  const auto hash = StringToHash(texture_normal_path);
-  if (!textures_.contains(hash)) return &none_texture_;
-  return textures_[hash];
+  return Get(Resolve(name));
 }
 
 void TextureMof::Clear() {
-  for (const auto& val : textures_ | std::views::values) {
-    val->Release();
-    delete val;
+  for (const auto& slot : slots_) {
+    if (!slot.texture) continue;
+    slot.texture->Release();
+    delete slot.texture;
+  }
+  slots_.clear();
+  handles_.clear();
+  aliases_.clear();
+  for (const auto texture : retired_textures_) {
+    texture->Release();
+    delete texture;
   }
+  retired_textures_.clear();
 }
 
 bool TextureMof::Release(std::string_view name) {
-  const std::filesystem::path local_path = name;
-  if (!exists(local_path)) return false;
-  const std::string texture_normal_path = PathToLocalStringPath(local_path);
-  const auto hash = StringToHash(texture_normal_path);
-  if (!textures_.contains(hash)) return false;
-  return textures_[std::hash<std::string_view>{}(name)]->Release();
-};
+  const auto handle = Resolve(name);
+  if (!handle.IsValid()) return false;
+  auto& slot = slots_[handle.handle];
+  if (!slot.texture) return false;
+  const bool result = slot.texture->Release();
+  delete slot.texture;
+  slot.texture = nullptr;
+  return result;
+}
+
+void TextureMof::SetHotReloadEnabled(const bool enabled) {
+  hot_reload_enabled_ = enabled;
+  hot_reload_timer_ = 0.0f;
+}
 
+bool TextureMof::PollHotReload(const float delta_time) {
+  if (!hot_reload_enabled_) return false;
+  hot_reload_timer_ += delta_time;
+  if (hot_reload_timer_ < kHotReloadInterval) return false;
+  hot_reload_timer_ = 0.0f;
+
+  bool reloaded = false;
+  for (auto& slot : slots_) {
+    if (!slot.texture) continue;
+    std::error_code error;
+    const auto write_time = std::filesystem::last_write_time(slot.path, error);
+    if (error || write_time == slot.write_time) continue;
+    slot.write_time = write_time;
+    // 書き込み途中などで読めなければ、今のテクスチャを残す
+    auto texture = std::make_unique<Mof::CTexture>();
+    if (!texture->Load(slot.path.data())) {
+      BE_CORE_ERROR("テクスチャの再読み込みに失敗しました。{0}", slot.path);
+      continue;
+    }
+    // 同じオブジェクトへ読み直すので、保持されている TexturePtr も更新される
+    slot.texture->Release();
+    if (!slot.texture->Load(slot.path.data())) {
+      // 確認した後にファイルが変わった。確認で読めた方に差し替える
+      BE_CORE_ERROR("テクスチャの再読み込みに失敗しました。{0}", slot.path);
+      retired_textures_.push_back(slot.texture);
+      slot.texture = texture.release();
+    }
+    reloaded = true;
+    BE_CORE_INFO("テクスチャを再読み込みしました。{0}", slot.path);
+  }
+  return reloaded;
+}
 }  // namespace base_engine
@@ -2,24 +2,60 @@
 #include <Graphics/DirectX11/DX11Texture.h>
 #include <Graphics/Texture.h>
 
+#include <filesystem>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "IBaseEngineTexture.h"
 namespace base_engine {
 class TextureMof final : public IBaseEngineTexture {
-  size_t count;
-  std::unordered_map<size_t, Mof::LPTexture> textures_;
+  struct StringHash {
+    using is_transparent = void;
+    size_t operator()(const std::string_view str) const {
+      return std::hash<std::string_view>{}(str);
+    }
+  };
+  using HandleMap =
+      std::unordered_map<std::string, size_t, StringHash, std::equal_to<>>;
+
+  struct Slot {
+    Mof::LPTexture texture = nullptr;
+    std::string path;
+    std::filesystem::file_time_type write_time;
+  };
+
+  //! ハンドルの添え字で引くテクスチャ。Release されても枠は再利用する
+  std::vector<Slot> slots_;
+  //! 正規化済みパスからハンドルへの索引
+  HandleMap handles_;
+  //! 呼び出し側が渡した未正規化の名前からハンドルへのキャッシュ
+  HandleMap aliases_;
   Mof::CTexture none_texture_;
+  //! 再読み込みで差し替えたテクスチャ。TexturePtr が残っていても使えるよう Clear まで残す
+  std::vector<Mof::LPTexture> retired_textures_;
+
+  bool hot_reload_enabled_ = false;
+  float hot_reload_timer_ = 0.0f;
+
  public:
   TextureMof();
   ~TextureMof() override;
 
   bool Load(std::string_view name) override;
 
+  TextureHandle Resolve(std::string_view name) override;
+
+  TexturePtr Get(TextureHandle handle) override;
+
   TexturePtr Get(std::string_view name) override;
 
   void Clear() override;
 
   bool Release(std::string_view name) override;
+
+  void SetHotReloadEnabled(bool enabled) override;
+
+  bool PollHotReload(float delta_time) override;
 };
-}  // namespace base_engine
\ No newline at end of file
+}  // namespace base_engine
@@ -6,6 +6,8 @@
 // @details
 
 #pragma once
+#include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 namespace tile_map {
@@ -20,6 +22,16 @@ enum Type {
 	kNotPutCell
 };
 
+// 1チャンクの縦横のセル数(2の累乗)
+constexpr size_t kLayerChunkShift = 5;
+constexpr size_t kLayerChunkSize = 1 << kLayerChunkShift;
+constexpr size_t kLayerChunkMask = kLayerChunkSize - 1;
+
+/**
+ * \brief タイルのレイヤー
+ * セルは 32x32 のチャンクに分割し、1つの連続したバッファに行優先で格納する。
+ * チャンクごとに変更フラグと空でないセルの数を持つ。
+ */
 class Layer {
   using Row = std::vector<Cell>;
   using Collection = std::vector<Row>;
@@ -30,27 +42,113 @@ class Layer {
   Layer() = default;
 
   Layer(const size_t x, const size_t y)
-      : x_(x), y_(y), layer_(Collection(y, Row(x, kEmptyCell))) {}
+      : x_(x),
+        y_(y),
+        chunk_x_count_((x + kLayerChunkMask) >> kLayerChunkShift),
+        chunk_y_count_((y + kLayerChunkMask) >> kLayerChunkShift),
+        cells_(chunk_x_count_ * chunk_y_count_ * kLayerChunkSize *
+                   kLayerChunkSize,
+               kEmptyCell),
+        chunks_(chunk_x_count_ * chunk_y_count_) {}
 
-  Layer(size_t x, size_t y, const Collection& layer)
-      : x_(x), y_(y), layer_(layer) {}
+  Layer(const size_t x, const size_t y, const Collection& layer)
+      : Layer(x, y) {
+    for (size_t j = 0; j < y_ && j < layer.size(); ++j) {
+      for (size_t i = 0; i < x_ && i < layer[j].size(); ++i) {
+        SetCell(i, j, layer[j][i]);
+      }
+    }
+  }
 
   void SetCell(const size_t x, const size_t y, const Cell type) {
-    layer_[y][x] = type;
+    Cell& cell = cells_[CellIndex(x, y)];
+    if (cell == type) return;
+    ChunkState& chunk = chunks_[ChunkIndex(x, y)];
+    if (cell == kEmptyCell) ++chunk.filled_count;
+    if (type == kEmptyCell) --chunk.filled_count;
+    chunk.dirty = true;
+    cell = type;
   }
   [[nodiscard]] Cell GetCell(const size_t x, const size_t y) const {
     if (x_ <= x) return 0;
     if (y_ <= y) return 0;
-    return layer_[y][x];
+    return cells_[CellIndex(x, y)];
+  }
+
+  /**
+   * \brief y 行目の [x_begin, x_end) から最初の空でないセルを探します。
+   * \return 見つからなければ x_end
+   */
+  [[nodiscard]] size_t FindFilledCell(const size_t y, size_t x_begin,
+                                      size_t x_end) const {
+    if (y_ <= y) return x_end;
+    x_end = std::min(x_end, x_);
+    while (x_begin < x_end) {
+      // チャンク内の1行は連続しているのでまとめて走査する
+      const size_t span_end =
+          std::min((x_begin | kLayerChunkMask) + 1, x_end);
+      if (chunks_[ChunkIndex(x_begin, y)].filled_count != 0) {
+        const Cell* row = &cells_[CellIndex(x_begin, y)];
+        const Cell* found = std::find_if(
+            row, row + (span_end - x_begin),
+            [](const Cell cell) { return cell != kEmptyCell; });
+        if (found != row + (span_end - x_begin)) {
+          return x_begin + (found - row);
+        }
+      }
+      x_begin = span_end;
+    }
+    return x_end;
   }
 
   size_t GetXCount() const { return x_; }
   size_t GetYCount() const { return y_; }
 
+  size_t GetChunkXCount() const { return chunk_x_count_; }
+  size_t GetChunkYCount() const { return chunk_y_count_; }
+
+  /// チャンク内に空でないセルがあるか
+  [[nodiscard]] bool IsChunkFilled(const size_t chunk_x,
+                                   const size_t chunk_y) const {
+    return chunks_[chunk_y * chunk_x_count_ + chunk_x].filled_count != 0;
+  }
+
+  /// 前回 ClearDirty してからチャンク内のセルが変更されたか
+  [[nodiscard]] bool IsChunkDirty(const size_t chunk_x,
+                                  const size_t chunk_y) const {
+    return chunks_[chunk_y * chunk_x_count_ + chunk_x].dirty;
+  }
+
+  void ClearDirty(const size_t chunk_x, const size_t chunk_y) {
+    chunks_[chunk_y * chunk_x_count_ + chunk_x].dirty = false;
+  }
+
+  void ClearDirty() {
+    for (auto& chunk : chunks_) {
+      chunk.dirty = false;
+    }
+  }
+
  private:
+  struct ChunkState {
+    uint32_t filled_count = 0;
+    bool dirty = false;
+  };
+
+  [[nodiscard]] size_t ChunkIndex(const size_t x, const size_t y) const {
+    return (y >> kLayerChunkShift) * chunk_x_count_ + (x >> kLayerChunkShift);
+  }
+  [[nodiscard]] size_t CellIndex(const size_t x, const size_t y) const {
+    return (ChunkIndex(x, y) << (kLayerChunkShift * 2)) +
+           ((y & kLayerChunkMask) << kLayerChunkShift) + (x & kLayerChunkMask);
+  }
+
   size_t x_{};
   size_t y_{};
-  Collection layer_{};
+  size_t chunk_x_count_{};
+  size_t chunk_y_count_{};
+  std::vector<Cell> cells_{};
+  std::vector<ChunkState> chunks_{};
 };
 
 }  // namespace tile_map
@@ -0,0 +1,114 @@
+﻿#include "TileMapColliderBaker.h"
+
+#include <algorithm>
+
+namespace tile_map {
+namespace {
+bool IsSameShape(const Mof::CRectangle& a, const Mof::CRectangle& b) {
+  return a.Left == b.Left && a.Top == b.Top && a.Right == b.Right &&
+         a.Bottom == b.Bottom;
+}
+}  // namespace
+
+TileMapColliderBaker::TileMapColliderBaker(
+    const Layer& map,
+    const std::vector<std::shared_ptr<base_engine::Rect>>& tile_shapes,
+    const int cell_size, const size_t chunk_size)
+    : map_(map),
+      tile_shapes_(tile_shapes),
+      cell_size_(static_cast<float>(cell_size)),
+      chunk_size_(std::max<size_t>(chunk_size, 1)) {}
+
+std::vector<TileColliderChunk> TileMapColliderBaker::Bake() const {
+  std::vector<TileColliderChunk> chunks;
+  for (size_t chunk_y = 0; chunk_y < map_.GetYCount(); chunk_y += chunk_size_) {
+    for (size_t chunk_x = 0; chunk_x < map_.GetXCount();
+         chunk_x += chunk_size_) {
+      BakeChunk(chunk_x, chunk_y, chunks);
+    }
+  }
+  return chunks;
+}
+
+bool TileMapColliderBaker::IsSolid(const size_t x, const size_t y) const {
+  if (x == 0 || y == 0) return false;
+  const auto shape = GetShape(x, y);
+  return shape != nullptr && shape->GetHeight() != 0;
+}
+
+const Mof::CRectangle* TileMapColliderBaker::GetShape(const size_t x,
+                                                      const size_t y) const {
+  const auto cell = static_cast<unsigned char>(map_.GetCell(x, y));
+  if (cell == kEmptyCell || tile_shapes_.size() < cell) return nullptr;
+  return tile_shapes_[cell - 1].get();
+}
+
+bool TileMapColliderBaker::CanMerge(const size_t x, const size_t y,
+                                    const Mof::CRectangle& shape) const {
+  return IsSolid(x, y) && IsSameShape(*GetShape(x, y), shape);
+}
+
+void TileMapColliderBaker::BakeChunk(
+    const size_t chunk_x, const size_t chunk_y,
+    std::vector<TileColliderChunk>& chunks) const {
+  const size_t end_x = std::min(chunk_x + chunk_size_, map_.GetXCount());
+  const size_t end_y = std::min(chunk_y + chunk_size_, map_.GetYCount());
+  const size_t width = end_x - chunk_x;
+
+  TileColliderChunk chunk;
+  chunk.position = {chunk_x * cell_size_, chunk_y * cell_size_};
+
+  std::vector<bool> used(width * (end_y - chunk_y), false);
+  const auto is_used = [&](const size_t x, const size_t y) {
+    return used[(y - chunk_y) * width + (x - chunk_x)];
+  };
+
+  for (size_t y = chunk_y; y < end_y; ++y) {
+    for (size_t x = map_.FindFilledCell(y, chunk_x, end_x); x < end_x;
+         x = map_.FindFilledCell(y, x + 1, end_x)) {
+      if (is_used(x, y) || !IsSolid(x, y)) continue;
+
+      const Mof::CRectangle& shape = *GetShape(x, y);
+      const bool full_width = shape.Left == 0 && shape.Right == cell_size_;
+      const bool full_height = shape.Top == 0 && shape.Bottom == cell_size_;
+
+      // 形状がセルの端まで届いている方向にだけ伸ばす
+      size_t right = x + 1;
+      if (full_width) {
+        while (right < end_x && !is_used(right, y) &&
+               CanMerge(right, y, shape)) {
+          ++right;
+        }
+      }
+      size_t bottom = y + 1;
+      if (full_height) {
+        while (bottom < end_y) {
+          bool can_merge = true;
+          for (size_t i = x; i < right && can_merge; ++i) {
+            can_merge = !is_used(i, bottom) && CanMerge(i, bottom, shape);
+          }
+          if (!can_merge) break;
+          ++bottom;
+        }
+      }
+
+      for (size_t j = y; j < bottom; ++j) {
+        for (size_t i = x; i < right; ++i) {
+          used[(j - chunk_y) * width + (i - chunk_x)] = true;
+        }
+      }
+
+      const float left = (x - chunk_x) * cell_size_;
+      const float top = (y - chunk_y) * cell_size_;
+      chunk.rects.emplace_back(
+          left + shape.Left, top + shape.Top,
+          left + (right - x - 1) * cell_size_ + shape.Right,
+          top + (bottom - y - 1) * cell_size_ + shape.Bottom);
+    }
+  }
+
+  if (!chunk.rects.empty()) {
+    chunks.emplace_back(std::move(chunk));
+  }
+}
+}  // namespace tile_map
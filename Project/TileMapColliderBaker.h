@@ -0,0 +1,66 @@
+﻿// @file TileMapColliderBaker.h
+// @brief タイルマップの当たり判定を矩形にまとめる
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+// 同じ形状のタイルが隣り合っている場合、貪欲法で最大の矩形に結合する。
+// マップはチャンク単位で処理し、チャンクごとに1つの静的アクターを生成できるよう
+// 結合済みの矩形をチャンク原点からの相対座標で返す。
+
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "Rect.h"
+#include "TileMap.h"
+
+namespace tile_map {
+constexpr size_t kDefaultColliderChunkSize = kLayerChunkSize;
+
+struct TileColliderChunk {
+  // チャンク左上のワールド座標
+  base_engine::Vector2 position{};
+  // チャンク原点からの相対座標で表した結合済みの矩形
+  std::vector<Mof::CRectangle> rects{};
+};
+
+class TileMapColliderBaker {
+ public:
+  /**
+   * \param map 対象のレイヤー
+   * \param tile_shapes セル番号 - 1 に対応するセル内の当たり判定形状
+   * \param cell_size 1セルの大きさ(px)
+   * \param chunk_size 1チャンクのセル数(縦横)
+   */
+  TileMapColliderBaker(const Layer& map,
+                       const std::vector<std::shared_ptr<base_engine::Rect>>&
+                           tile_shapes,
+                       int cell_size,
+                       size_t chunk_size = kDefaultColliderChunkSize);
+
+  /**
+   * \brief 当たり判定を持つセルを結合し、空でないチャンクの一覧を返します。
+   * 結合は形状がセルの幅いっぱいなら横方向に、高さいっぱいなら縦方向に行います。
+   */
+  [[nodiscard]] std::vector<TileColliderChunk> Bake() const;
+
+  /**
+   * \brief セルが当たり判定を持つかを返します。
+   * マップ外周のセル、形状の高さが0のセルは当たり判定を持ちません。
+   */
+  [[nodiscard]] bool IsSolid(size_t x, size_t y) const;
+
+ private:
+  [[nodiscard]] const Mof::CRectangle* GetShape(size_t x, size_t y) const;
+  [[nodiscard]] bool CanMerge(size_t x, size_t y,
+                              const Mof::CRectangle& shape) const;
+  void BakeChunk(size_t chunk_x, size_t chunk_y,
+                 std::vector<TileColliderChunk>& chunks) const;
+
+  const Layer& map_;
+  const std::vector<std::shared_ptr<base_engine::Rect>>& tile_shapes_;
+  float cell_size_;
+  size_t chunk_size_;
+};
+}  // namespace tile_map
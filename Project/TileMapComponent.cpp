@@ -1,5 +1,7 @@
 ﻿#include "TileMapComponent.h"
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 
 #include "CollisionComponent.h"
@@ -9,6 +11,7 @@
 #include "Rect.h"
 #include "StringFrozen.h"
 #include "TextArchive.h"
+#include "TileMapColliderBaker.h"
 #include "VectorFrozen.h"
 namespace tile_map {
 struct FrozenMapData {
@@ -31,19 +34,27 @@ TileMapComponent::TileMapRenderComponent::TileMapRenderComponent(
 
 void TileMapComponent::TileMapRenderComponent::Draw() {
   Mof::CRectangle rect;
-  const auto pos = BASE_ENGINE(Render)->GetCameraPosition();
-  const auto camera_pos = GridPosition::VectorTo({pos.x, pos.y});
-
-  const size_t top = std::max(camera_pos.y - 7, 0);
-  const size_t bottom = std::min(top + 18, tile_map_->map_.GetYCount());
-
-  const size_t left = std::max(camera_pos.x - 10, 0);
-  const size_t right = std::min(left + 20, tile_map_->map_.GetXCount());
-
-  for (int y = top; y < bottom; ++y) {
-    for (int x = left; x < right; ++x) {
-      const auto cell = tile_map_->map_.GetCell(x, y);
-      if (cell == kEmptyCell) continue;
+  // 表示範囲に掛かるセルだけを描画する
+  const auto view = BASE_ENGINE(Render)->GetViewRect();
+  const float cell_size = static_cast<float>(tile_map_->cell_size_);
+  const auto to_cell = [cell_size](const float v, const size_t count) {
+    return static_cast<size_t>(std::clamp(std::floor(v / cell_size), 0.0f,
+                                          static_cast<float>(count)));
+  };
+  const size_t x_count = tile_map_->map_.GetXCount();
+  const size_t y_count = tile_map_->map_.GetYCount();
+
+  const size_t top = to_cell(view.Top, y_count);
+  const size_t bottom = to_cell(view.Bottom + cell_size, y_count);
+
+  const size_t left = to_cell(view.Left, x_count);
+  const size_t right = to_cell(view.Right + cell_size, x_count);
+
+  const auto& map = tile_map_->map_;
+  for (size_t y = top; y < bottom; ++y) {
+    for (size_t x = map.FindFilledCell(y, left, right); x < right;
+         x = map.FindFilledCell(y, x + 1, right)) {
+      const auto cell = map.GetCell(x, y);
       if (cell > 5) {
         
       }
@@ -109,30 +120,17 @@ void TileMapComponent::Load(std::string_view path) {
       tile_shape_.emplace_back(std::make_shared<base_engine::Rect>(rect));
     }
   }
-  int n = 0;
-  for (int x = 0; x < map_.GetXCount(); ++x) {
-    for (int y = 0; y < map_.GetYCount(); ++y) {
-      if (map_.GetCell(x, y) == 0) continue;
-      if (x == 0) continue;
-      if (y == 0) continue;
-      if (x == map_.GetXCount()) continue;
-      if (y == map_.GetYCount()) continue;
-      if (((map_.GetCell(x + 1, y) != 0) && (map_.GetCell(x - 1, y) != 0) &&
-           (map_.GetCell(x, y + 1) != 0) && (map_.GetCell(x, y - 1) != 0)) &&
-          ((map_.GetCell(x + 1, y) < 29) && (map_.GetCell(x - 1, y) < 29) &&
-           (map_.GetCell(x, y + 1) < 29) && (map_.GetCell(x, y - 1) < 29)))
-        continue;
-      const auto shape = tile_shape_[map_.GetCell(x, y) - 1];
-      if (shape->GetHeight() == 0) continue;
-      n++;
-      const auto cell = new base_engine::Actor(owner_->GetGame());
-      cell->SetTag("Field");
-      cell->SetPosition({static_cast<MofFloat>(x * 128), y * 128.0f});
-      const auto collision = new base_engine::CollisionComponent(cell);
+  // 隣接するセルを矩形にまとめ、チャンクごとに1つのアクターへ登録する
+  const TileMapColliderBaker baker(map_, tile_shape_, cell_size_);
+  for (const auto& chunk : baker.Bake()) {
+    const auto actor = new base_engine::Actor(owner_->GetGame());
+    actor->SetTag("Field");
+    actor->SetPosition(chunk.position);
+    for (const auto& rect : chunk.rects) {
+      const auto collision = new base_engine::CollisionComponent(actor);
       collision->SetObjectFilter(kFieldObjectFilter);
       collision->SetTargetFilter(kFieldTargetFilter);
-
-      collision->SetShape(shape);
+      collision->SetShape(std::make_shared<base_engine::Rect>(rect));
     }
   }
 }
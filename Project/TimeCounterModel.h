@@ -1,5 +1,6 @@
 #pragma once
 
+#include "GameClock.h"
 #include "ReactiveProperty.h"
 #include "TimeCounter.h"
 #include <Utilities/Utilities.h>
@@ -12,7 +13,8 @@ public:
 		return elapsed_time_.ToReadOnly();
 	}
 	void SetElapsedTime() {
-		time_counter_->Update(Mof::CUtilities::GetFrameSecond());
+		time_counter_->Update(
+			base_engine::GameClock::GetInstance()->GetFixedDeltaTime());
 		elapsed_time_  = time_counter_->GetElapsedSeconds();
 	}
 	[[nodiscard]] auto GetElapsedMinutes() {
@@ -0,0 +1,20 @@
+﻿// @TransformInterpolationComponent.h
+// @brief
+// @author ICE
+// @date 2026/10/19
+//
+// @details
+
+#pragma once
+#include "Vector3.h"
+
+namespace base_engine::component {
+/**
+ * \brief 描画補間用に前回の固定ステップ終了時の位置を保持する
+ * 回転と拡縮は補間せず、現在の値をそのまま使う
+ */
+struct TransformInterpolationComponent {
+  Vector3 previous_translation{0.0f, 0.0f, 0.0f};
+  bool has_previous = false;
+};
+}  // namespace base_engine::component
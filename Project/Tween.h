@@ -11,6 +11,7 @@
 #include "Component.h"
 #include "EaseType.h"
 #include "Easer.h"
+#include "GameClock.h"
 #include "ITween.h"
 
 namespace ma_tween {
@@ -113,7 +114,8 @@ class TweenDriver : public base_engine::Component, public core::ITween {
     if (this->is_paused_ == true) return;
     // When the delay is active, the tween will wait for the delay to pass by.
     if (this->delay_) {
-      this->delay_.value() -= 0.017f;
+      this->delay_.value() -=
+          base_engine::GameClock::GetInstance()->GetFixedDeltaTime();
       if (this->delay_ <= 0) {
         this->delay_.reset();
         // When the delay is over, the valueFrom is requested from the
@@ -148,7 +150,9 @@ class TweenDriver : public base_engine::Component, public core::ITween {
         did_trigger_on_start_ = true;
       }
       // Increase or decrease the time of the tween based on the direction.
-      auto time_delta = (0.017f) / this->duration_.value();
+      auto time_delta =
+          base_engine::GameClock::GetInstance()->GetFixedDeltaTime() /
+          this->duration_.value();
       this->time_ += time_delta;
       // The time will be capped to 1, when pingpong is enabled the tween will
       // play backwards, otherwise when the tween is not infinite, didReachEnd
@@ -6,28 +6,56 @@
 // @details
 
 #pragma once
+#include <algorithm>
 #include <vector>
 
 #include "FrozenHelper.h"
 #include "FrozenMacro.h"
 
 namespace frozen {
+/// 壊れたサイズを読んでも巨大な確保をしないよう、読み込み時はこの単位で伸ばす
+constexpr std::size_t kVectorLoadChunkBytes = 1024 * 1024;
+
 template <class Archive, class T, class A>
 void FROZEN_SAVE_FUNCTION_NAME(Archive& ar, std::vector<T, A> const& vector) {
   ar(make_size_tag(
       static_cast<SizeType>(vector.size())));  // number of elements
-  for (auto&& v : vector) ar(v);
+  if constexpr (ContiguousBinary<T> && BinaryArchiveConcept<Archive, T>) {
+    ar(binary_data(vector.data(), vector.size() * sizeof(T)));
+  } else {
+    for (auto&& v : vector) ar(v);
+  }
 }
 
 template <class Archive, class T, class A>
 void FROZEN_LOAD_FUNCTION_NAME(Archive& ar, std::vector<T, A>& vector) {
-  SizeType size;
+  SizeType size = 0;
   ar(make_size_tag(size));
 
-  vector.resize(static_cast<std::size_t>(size));
-  for (auto&& v : vector)
-  {
-      ar(v);
+  if constexpr (requires { ar.IsFailed(); }) {
+    vector.clear();
+    if constexpr (ContiguousBinary<T> && BinaryArchiveConcept<Archive, T>) {
+      constexpr auto chunk = kVectorLoadChunkBytes / sizeof(T);
+      for (SizeType loaded = 0; loaded < size && !ar.IsFailed();) {
+        const auto count = static_cast<std::size_t>(
+            std::min<SizeType>(size - loaded, chunk));
+        vector.resize(static_cast<std::size_t>(loaded) + count);
+        ar(binary_data(vector.data() + loaded, count * sizeof(T)));
+        loaded += count;
+      }
+    } else {
+      vector.reserve(static_cast<std::size_t>(std::min<SizeType>(
+          size, std::max<std::size_t>(kVectorLoadChunkBytes / sizeof(T), 1))));
+      for (SizeType i = 0; i < size && !ar.IsFailed(); ++i)
+        ar(vector.emplace_back());
+    }
+    if (ar.IsFailed()) vector.clear();
+  } else {
+    vector.resize(static_cast<std::size_t>(size));
+    for (auto&& v : vector)
+    {
+        ar(v);
+    }
   }
 }
 }  // namespace frozen
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include "AssetPacker.h"
 #include "GameApp.h"
 #include "GameWindow.h"
 #include "Log.h"
@@ -12,6 +13,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance,
 #endif
 {
   base_engine::Log::Init();
+  if (const auto exit_code = base_engine::AssetPacker::RunFromCommandLine())
+    return *exit_code;
 
   //_CrtSetDbgFlag(_CRTDBG_ALLOC_MEM_DF | _CRTDBG_LEAK_CHECK_DF);
   Mof::LPFramework pFrame = new Mof::CDX11GameFramework();